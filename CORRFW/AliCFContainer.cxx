@@ -24,10 +24,13 @@
 //--------------------------------------------------------------------//
 //
 //
+#include <algorithm>
 #include <AliLog.h>
 #include "AliCFGridSparse.h"
 #include "AliCFContainer.h"
 #include "TAxis.h"
+#include "TBuffer.h"
+#include "THnSparse.h"
 //____________________________________________________________________
 ClassImp(AliCFContainer)
 
@@ -35,7 +38,11 @@ ClassImp(AliCFContainer)
 AliCFContainer::AliCFContainer() : 
   AliCFFrame(),
   fNStep(0),
-  fGrid(0x0)
+  fGrid(0x0),
+  fFillBufferSize(0),
+  fBufferStep(),
+  fBufferBin(),
+  fBufferWeight()
 {
   //
   // default constructor
@@ -46,7 +53,11 @@ AliCFContainer::AliCFContainer() :
 AliCFContainer::AliCFContainer(const Char_t* name, const Char_t* title, const Int_t nSelSteps, const Int_t nVarIn, const Int_t* nBinIn) :  
   AliCFFrame(name,title),
   fNStep(nSelSteps),
-  fGrid(0x0)
+  fGrid(0x0),
+  fFillBufferSize(0),
+  fBufferStep(),
+  fBufferBin(),
+  fBufferWeight()
 {
   //
   // main constructor
@@ -65,7 +76,11 @@ AliCFContainer::AliCFContainer(const Char_t* name, const Char_t* title, const In
 AliCFContainer::AliCFContainer(const AliCFContainer& c) :
   AliCFFrame(c.fName,c.fTitle),
   fNStep(0),
-  fGrid(0x0)
+  fGrid(0x0),
+  fFillBufferSize(0),
+  fBufferStep(),
+  fBufferBin(),
+  fBufferWeight()
 {
   //
   // copy constructor
@@ -100,9 +115,15 @@ void AliCFContainer::Copy(TObject& c) const
   //
   // copy function
   //
+  FlushFillBuffer();
   AliCFFrame::Copy(c);
   AliCFContainer& target = (AliCFContainer &) c;
   target.fNStep = fNStep;
+  target.fFillBufferSize = fFillBufferSize;
+  // entries pending in the target refer to its old grids
+  target.fBufferStep  .clear();
+  target.fBufferBin   .clear();
+  target.fBufferWeight.clear();
   target.fGrid  = new AliCFGridSparse*[fNStep];
   for (Int_t iStep=0; iStep<fNStep; iStep++) {
     if (fGrid[iStep])  target.fGrid[iStep] = new AliCFGridSparse(*(fGrid[iStep]));
@@ -120,9 +141,125 @@ void AliCFContainer::Fill(const Double_t *var, Int_t istep, Double_t weight)
     AliError("Non-existent selection step, grid was not filled");
     return;
   }
+  if (fFillBufferSize>0) {
+    // global bin index of the entry, as the THnSparse would find it
+    THnSparse* data = fGrid[istep]->GetGrid();
+    Long64_t bin = 0, stride = 1;
+    for (Int_t iVar=0; iVar<data->GetNdimensions(); iVar++) {
+      TAxis* axis = data->GetAxis(iVar);
+      bin    += stride * axis->FindBin(var[iVar]);
+      stride *= axis->GetNbins()+2;
+    }
+    fBufferStep  .push_back(istep);
+    fBufferBin   .push_back(bin);
+    fBufferWeight.push_back(weight);
+    if ((Int_t)fBufferBin.size() >= fFillBufferSize) FlushFillBuffer();
+    return;
+  }
   fGrid[istep]->Fill(var,weight);
 }
 
+//____________________________________________________________________
+void AliCFContainer::SetFillBufferSize(Int_t size)
+{
+  //
+  // Enables buffered filling with a buffer of 'size' entries (0 = fill the grids directly)
+  //
+  FlushFillBuffer();
+  if (size>0) {
+    // the global bin index must fit in a Long64_t
+    Double_t nBins = 1.;
+    for (Int_t iVar=0; iVar<GetNVar(); iVar++) nBins *= GetNBins(iVar)+2;
+    if (nBins > 1.e18) {
+      AliWarning(Form("Grid too large (%e bins) for buffered filling, entries will be filled directly",nBins));
+      size = 0;
+    }
+  }
+  fFillBufferSize = size;
+  fBufferStep  .reserve(size);
+  fBufferBin   .reserve(size);
+  fBufferWeight.reserve(size);
+}
+
+//____________________________________________________________________
+namespace {
+  // orders the buffered entries by step and bin, keeping the fill order within a bin
+  struct BufferOrder {
+    const std::vector<Int_t>&    fStep;
+    const std::vector<Long64_t>& fBin;
+    BufferOrder(const std::vector<Int_t>& step, const std::vector<Long64_t>& bin) : fStep(step), fBin(bin) {}
+    bool operator()(Int_t i, Int_t j) const {
+      if (fStep[i] != fStep[j]) return fStep[i] < fStep[j];
+      if (fBin [i] != fBin [j]) return fBin [i] < fBin [j];
+      return i < j;
+    }
+  };
+}
+
+void AliCFContainer::FlushFillBuffer() const
+{
+  //
+  // Adds the buffered entries to the grids.
+  // The entries are sorted by step and bin, so that each bin is looked up (and allocated) once.
+  // The weights are added one by one in fill order, so that the bin contents and errors
+  // are the same as with direct filling.
+  //
+  const Int_t nEntries = fBufferBin.size();
+  if (!nEntries) return;
+
+  std::vector<Int_t> order(nEntries);
+  for (Int_t i=0; i<nEntries; i++) order[i] = i;
+  std::sort(order.begin(),order.end(),BufferOrder(fBufferStep,fBufferBin));
+
+  const Int_t nVar = GetNVar();
+  Int_t* coord = new Int_t[nVar];
+  Int_t first = 0;
+  while (first < nEntries) {
+    const Int_t step = fBufferStep[order[first]];
+    THnSparse* data = fGrid[step]->GetGrid();
+    const Bool_t calculateErrors = data->GetCalculateErrors();
+    Int_t last = first;
+    while (last < nEntries && fBufferStep[order[last]] == step) {
+      // coordinates of the bin
+      const Long64_t globalBin = fBufferBin[order[last]];
+      Long64_t rest = globalBin;
+      for (Int_t iVar=0; iVar<nVar; iVar++) {
+        const Int_t n = data->GetAxis(iVar)->GetNbins()+2;
+        coord[iVar] = rest % n;
+        rest       /= n;
+      }
+      const Long64_t bin = data->GetBin(coord,kTRUE);
+      for (; last < nEntries && fBufferStep[order[last]] == step && fBufferBin[order[last]] == globalBin; last++) {
+        const Double_t w = fBufferWeight[order[last]];
+        data->AddBinContent(bin,w);
+        if (calculateErrors) data->AddBinError2(bin,w*w);
+      }
+    }
+    data->SetEntries(data->GetEntries() + (last-first));
+    first = last;
+  }
+  delete [] coord;
+
+  fBufferStep  .clear();
+  fBufferBin   .clear();
+  fBufferWeight.clear();
+}
+
+//____________________________________________________________________
+void AliCFContainer::Streamer(TBuffer &R__b)
+{
+  //
+  // Stream an object of class AliCFContainer.
+  // The fill buffer is flushed before writing.
+  //
+  if (R__b.IsReading()) {
+    R__b.ReadClassBuffer(AliCFContainer::Class(),this);
+  } else {
+    FlushFillBuffer();
+    R__b.WriteClassBuffer(AliCFContainer::Class(),this);
+  }
+}
+
 //____________________________________________________________________
 TH1* AliCFContainer::Project(Int_t istep, Int_t ivar1, Int_t ivar2, Int_t ivar3) const
 {
@@ -134,7 +271,7 @@ TH1* AliCFContainer::Project(Int_t istep, Int_t ivar1, Int_t ivar2, Int_t ivar3)
     AliError("Non-existent selection step, return NULL");
     return 0x0;
   }
-  return fGrid[istep]->Project(ivar1,ivar2,ivar3);
+  return GetGrid(istep)->Project(ivar1,ivar2,ivar3);
 }
 
 //____________________________________________________________________
@@ -172,7 +309,7 @@ AliCFContainer* AliCFContainer::MakeSlice(Int_t nSteps, const Int_t* steps,
 
   // create the output grids
   AliCFGridSparse** grids = new AliCFGridSparse*[nSteps] ;
-  for (Int_t iStep=0; iStep<nSteps; iStep++) grids[iStep] = fGrid[steps[iStep]]->MakeSlice(nVars,vars,varMin,varMax,useBins);
+  for (Int_t iStep=0; iStep<nSteps; iStep++) grids[iStep] = GetGrid(steps[iStep])->MakeSlice(nVars,vars,varMin,varMax,useBins);
 
   TAxis ** axis = new TAxis*[nVars];
   for (Int_t iVar=0; iVar<nVars; iVar++) axis[iVar] = ((AliCFGridSparse*)grids[0])->GetGrid()->GetAxis(iVar); //same axis for every grid
@@ -245,7 +382,7 @@ void AliCFContainer::Add(const AliCFContainer* aContainerToAdd, Double_t c)
       return;
     }
   for (Int_t istep=0; istep<fNStep; istep++) {
-    fGrid[istep]->Add(aContainerToAdd->GetGrid(istep),c);
+    GetGrid(istep)->Add(aContainerToAdd->GetGrid(istep),c);
   }
 }
 //____________________________________________________________________
@@ -258,7 +395,7 @@ Float_t AliCFContainer::GetOverFlows( Int_t ivar, Int_t istep, Bool_t exclusive)
     AliError("Non-existent selection step, return -1");
     return -1.;
   }
-  return fGrid[istep]->GetOverFlows(ivar,exclusive);
+  return GetGrid(istep)->GetOverFlows(ivar,exclusive);
 } 
 //____________________________________________________________________
 Float_t AliCFContainer::GetUnderFlows( Int_t ivar, Int_t istep, Bool_t exclusive) const {
@@ -270,7 +407,7 @@ Float_t AliCFContainer::GetUnderFlows( Int_t ivar, Int_t istep, Bool_t exclusive
     AliError("Non-existent selection step, return -1");
     return -1.;
   }
-  return fGrid[istep]->GetUnderFlows(ivar,exclusive);
+  return GetGrid(istep)->GetUnderFlows(ivar,exclusive);
 } 
 //____________________________________________________________________
 Float_t AliCFContainer::GetEntries(Int_t istep) const {
@@ -281,7 +418,7 @@ Float_t AliCFContainer::GetEntries(Int_t istep) const {
     AliError("Non-existent selection step, return -1");
     return -1.;
   }
-  return fGrid[istep]->GetEntries();
+  return GetGrid(istep)->GetEntries();
 } 
 //_____________________________________________________________________
 Double_t AliCFContainer::GetIntegral( Int_t istep) const 
@@ -293,7 +430,7 @@ Double_t AliCFContainer::GetIntegral( Int_t istep) const
     AliError("Non-existent selection step, return -1");
     return -1.;
   }
-  return fGrid[istep]->GetIntegral();
+  return GetGrid(istep)->GetIntegral();
 }
 
 //_____________________________________________________________________
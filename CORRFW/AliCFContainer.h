@@ -10,6 +10,7 @@
 //                                                                    //
 //--------------------------------------------------------------------//
 
+#include <vector>
 #include "AliCFFrame.h"
 #include "AliCFGridSparse.h"
 
@@ -45,8 +46,8 @@ class AliCFContainer : public AliCFFrame
   virtual Int_t    * GetNBins()                                      const {return fGrid[0]->GetNBins();}
   virtual Float_t    GetBinCenter(Int_t ivar,Int_t ibin)             const {return fGrid[0]->GetBinCenter(ivar,ibin);}
   virtual Float_t    GetBinSize  (Int_t ivar,Int_t ibin)             const {return fGrid[0]->GetBinSize  (ivar,ibin);}
-  virtual Float_t    GetBinContent(const Int_t* coordinates, Int_t step) const {return fGrid[step]->GetGrid()->GetBinContent(coordinates);}
-  virtual Float_t    GetBinError  (const Int_t* coordinates, Int_t step) const {return fGrid[step]->GetGrid()->GetBinError  (coordinates);}
+  virtual Float_t    GetBinContent(const Int_t* coordinates, Int_t step) const {return GetGrid(step)->GetGrid()->GetBinContent(coordinates);}
+  virtual Float_t    GetBinError  (const Int_t* coordinates, Int_t step) const {return GetGrid(step)->GetGrid()->GetBinError  (coordinates);}
   virtual const Char_t* GetBinLabel (Int_t ivar,Int_t ibin)          const {return GetAxis(ivar,0)->GetBinLabel(ibin);}
 
   virtual void       Print(const Option_t*) const ;
@@ -63,10 +64,18 @@ class AliCFContainer : public AliCFFrame
   virtual void  SetNStep(Int_t nStep) {fNStep=nStep;}
   virtual void  Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
 
+  // buffered filling : entries are collected as (step, bin, weight) and added to the grids
+  // bin by bin when the buffer is full, or when the grids are accessed or written
+  // the bin contents, errors and number of entries are the same as with direct filling
+  // (the THnSparse sums of weight*value used for the axis statistics are not updated)
+  virtual void  SetFillBufferSize(Int_t size) ; // 0 = no buffering (default)
+  Int_t         GetFillBufferSize() const {return fFillBufferSize;}
+  void          FlushFillBuffer() const ;
+
   virtual Float_t  GetOverFlows (Int_t var,Int_t istep,Bool_t excl=kFALSE) const;
   virtual Float_t  GetUnderFlows(Int_t var,Int_t istep,Bool_t excl=kFALSE) const ;
   virtual Float_t  GetEntries  (Int_t istep) const ;
-  virtual Long_t   GetEmptyBins(Int_t istep) const {return fGrid[istep]->GetEmptyBins();}
+  virtual Long_t   GetEmptyBins(Int_t istep) const {return GetGrid(istep)->GetEmptyBins();}
   virtual Double_t GetIntegral (Int_t istep) const ;
 
   //basic operations
@@ -83,8 +92,8 @@ class AliCFContainer : public AliCFFrame
   virtual void  SetRangeUser(Int_t ivar, Double_t varMin, Double_t varMax, Bool_t useBins=kFALSE) const ;
   virtual void  SetRangeUser(const Double_t* varMin, const Double_t* varMax, Bool_t useBins=kFALSE) const ;
 
-  virtual void  SetGrid(Int_t step, AliCFGridSparse* grid) {if (fGrid[step]) delete fGrid[step]; fGrid[step]=grid;}
-  virtual AliCFGridSparse * GetGrid(Int_t istep) const {return fGrid[istep];};
+  virtual void  SetGrid(Int_t step, AliCFGridSparse* grid) {FlushFillBuffer(); if (fGrid[step]) delete fGrid[step]; fGrid[step]=grid;}
+  virtual AliCFGridSparse * GetGrid(Int_t istep) const {FlushFillBuffer(); return fGrid[istep];};
 
   virtual void  Scale(Double_t factor) const;
 
@@ -96,17 +105,24 @@ class AliCFContainer : public AliCFFrame
  private:
   Int_t    fNStep; //number of selection steps
   AliCFGridSparse **fGrid;//[fNStep]
+
+  Int_t    fFillBufferSize;                        //! number of entries after which the fill buffer is flushed
+  mutable std::vector<Int_t>    fBufferStep;       //! buffered entries : selection step
+  mutable std::vector<Long64_t> fBufferBin;        //! buffered entries : global bin index (including under/overflows)
+  mutable std::vector<Double_t> fBufferWeight;     //! buffered entries : weight
   
-  ClassDef(AliCFContainer,5);
+  ClassDef(AliCFContainer,6);
 };
 
 inline void AliCFContainer::SetBinLimits(Int_t ivar, const Double_t* array) {
+  FlushFillBuffer(); // buffered entries keep the binning they were filled with
   for (Int_t iStep=0; iStep<GetNStep(); iStep++) {
     fGrid[iStep]->SetBinLimits(ivar,array);
   }
 }
 
 inline void AliCFContainer::SetBinLimits(Int_t ivar, Double_t min, Double_t max) {
+  FlushFillBuffer(); // buffered entries keep the binning they were filled with
   for (Int_t iStep=0; iStep<GetNStep(); iStep++) {
     fGrid[iStep]->SetBinLimits(ivar,min,max);
   }
@@ -141,6 +157,7 @@ inline void AliCFContainer::SetBinLabel(Int_t iVar, Int_t iBin, const Char_t* la
 
 inline void  AliCFContainer::Scale(Double_t factor) const {
   Double_t fact[2] = {factor,0} ;
+  FlushFillBuffer();
   for (Int_t iStep=0; iStep<fNStep; iStep++) fGrid[iStep]->Scale(fact);
 }
 
@@ -50,6 +50,12 @@
 //     - the convergence criterion below which the procedure will stop //
 // SetMaxConvergencePerDOF(Double_t val);                              //
 //                                                                     //
+// The iterations are performed on a copy of the response matrix in   //
+// compressed sparse row format (AliCFUnfolding::SparseKernel), unless //
+// smoothing is requested. The randomized spectra used for the         //
+// correlated errors can then be unfolded in parallel                  //
+// (::SetNumberOfThreads), each with its own random number stream.     //
+//                                                                     //
 // Correlated error calculation can be activated by using:             //
 // SetUseCorrelatedErrors(Bool_t b) in combination with convergence    //
 // criterion                                                           //
@@ -93,11 +99,101 @@
 #include "TH3D.h"
 #include "TRandom3.h"
 
+#include <algorithm>
+#include <map>
+#include <vector>
+#if __cplusplus >= 201103L
+#include <thread>
+#endif
+
 
 ClassImp(AliCFUnfolding)
 
 //______________________________________________________________
 
+class AliCFUnfolding::SparseKernel {
+  //
+  // Conditional matrix P(M|T) in compressed sparse row format.
+  // The measured (M) and true (T) bins filled in the response matrix are given compact indices,
+  // the matrix entries are kept in the order of the THnSparse bins, and are indexed
+  // both by measured bin (rows) and by true bin (columns).
+  // One bayes iteration is then a product of the matrix with the prior (M estimate),
+  // a rescaling of the entries (inverse response) and a product of the transposed
+  // matrix with the measured spectrum (unfolded spectrum).
+  // The sums are done in the same order as the THnSparse-based loops of AliCFUnfolding.
+  //
+  // The kernel is not modified by the iterations: all spectra are held in a State,
+  // so several spectra can be unfolded at the same time.
+  //
+
+ public:
+
+  struct State {
+    State() : fPriorUpdated(kFALSE) {}
+    std::vector<Double_t> fPrior;         // prior spectrum                             (T)
+    std::vector<Int_t>    fPriorBins;     // filled bins of the prior, in THnSparse order
+    Bool_t                fPriorUpdated;  // prior has been replaced by the unfolded spectrum
+    std::vector<Double_t> fEfficiency;    // efficiency                                 (T)
+    std::vector<Double_t> fMeasured;      // measured spectrum                          (M)
+    std::vector<Double_t> fPriorTimesEff; // prior x efficiency                         (T)
+    std::vector<Double_t> fEstMeasured;   // estimate of the measured spectrum          (M)
+    std::vector<Int_t>    fEstFirst;      // first matrix entry filling the estimate, -1 if none (M)
+    std::vector<Double_t> fInvResponse;   // inverse response                           (entries)
+    std::vector<Char_t>   fInvSet;        // inverse response entry has been set        (entries)
+    std::vector<Double_t> fUnfolded;      // unfolded spectrum                          (T)
+    std::vector<Int_t>    fUnfoldedFirst; // first matrix entry filling the unfolded bin, -1 if none (T)
+    std::vector<Int_t>    fUnfoldedBins;  // filled bins of the unfolded spectrum, in THnSparse order
+  };
+
+  SparseKernel(const THnSparse* conditional, const THnSparse* response, const THnSparse* prior, Int_t nVar);
+
+  Int_t    GetNTrueBins()     const {return (Int_t)(fCoordT.size()/fNVariables);}
+  Int_t    GetNMeasuredBins() const {return (Int_t)(fCoordM.size()/fNVariables);}
+  Int_t    FindTrueBin    (const Int_t* coord) const {return FindBin(fIndexT,fStrideT,coord);}
+  Int_t    FindMeasuredBin(const Int_t* coord) const {return FindBin(fIndexM,fStrideM,coord);}
+
+  void     InitState(State& state, const THnSparse* prior, const THnSparse* efficiency, const THnSparse* measured) const;
+  void     SetRandomizedInputs(const THnSparse* efficiency, const THnSparse* measured);
+  void     RandomizeInputs(State& state, TRandom3& random) const;
+  void     Iterate(State& state) const;
+  Double_t GetConvergence(const State& state) const;
+  void     UpdatePrior(State& state) const;
+  void     FillHistograms(const State& state, THnSparse* estMeasured, THnSparse* invResponse, THnSparse* unfolded, THnSparse* prior) const;
+  void     StoreInvResponse(const State& state) {fEntryInv = state.fInvResponse;}
+  void     UnfoldRandomized(const State& init, TRandom3& random, Int_t nIterations,
+                            const std::vector<Int_t>& bins, const std::vector<Double_t>& values, std::vector<Double_t>& delta) const;
+
+ private:
+
+  Int_t    AddBin (std::map<Long64_t,Int_t>& index, const std::vector<Long64_t>& stride, std::vector<Int_t>& coords, const Int_t* coord);
+  Int_t    FindBin(const std::map<Long64_t,Int_t>& index, const std::vector<Long64_t>& stride, const Int_t* coord) const;
+  void     FillRandomizedInput(const THnSparse* hist, Bool_t isTrue, std::vector<Int_t>& bins, std::vector<Double_t>& values, std::vector<Double_t>& errors) const;
+
+  Int_t                     fNVariables;     // number of variables
+  std::vector<Long64_t>     fStrideM;        // strides of the global bin index in measured space
+  std::vector<Long64_t>     fStrideT;        // strides of the global bin index in true space
+  std::map<Long64_t,Int_t>  fIndexM;         // global bin index -> compact measured bin
+  std::map<Long64_t,Int_t>  fIndexT;         // global bin index -> compact true bin
+  std::vector<Int_t>        fCoordM;         // coordinates of the compact measured bins
+  std::vector<Int_t>        fCoordT;         // coordinates of the compact true bins
+  std::vector<Int_t>        fEntryM;         // measured bin of each matrix entry
+  std::vector<Int_t>        fEntryT;         // true bin of each matrix entry
+  std::vector<Double_t>     fEntryValue;     // conditional probability of each matrix entry
+  std::vector<Double_t>     fEntryInv;       // inverse response at the end of the last unfolding (content of fInverseResponse)
+  std::vector<Int_t>        fRowStart;       // first entry of each measured bin in fRowEntries
+  std::vector<Int_t>        fRowEntries;     // entries sorted by measured bin
+  std::vector<Int_t>        fColStart;       // first entry of each true bin in fColEntries
+  std::vector<Int_t>        fColEntries;     // entries sorted by true bin
+  std::vector<Int_t>        fRandEffBins;    // true bin of each efficiency bin to randomize (-1 if not used)
+  std::vector<Double_t>     fRandEffValues;  // efficiency values (mean of the random distribution)
+  std::vector<Double_t>     fRandEffErrors;  // efficiency errors (sigma of the random distribution)
+  std::vector<Int_t>        fRandMeasBins;   // measured bin of each measured bin to randomize (-1 if not used)
+  std::vector<Double_t>     fRandMeasValues; // measured values (mean of the random distribution)
+  std::vector<Double_t>     fRandMeasErrors; // measured errors (sigma of the random distribution)
+};
+
+//______________________________________________________________
+
 AliCFUnfolding::AliCFUnfolding() :
   TNamed(),
   fResponseOrig(0x0),
@@ -130,7 +226,9 @@ AliCFUnfolding::AliCFUnfolding() :
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(0)
+  fRandomSeed(0),
+  fNThreads(1),
+  fSparseKernel(0x0)
 {
   //
   // default constructor
@@ -174,7 +272,9 @@ AliCFUnfolding::AliCFUnfolding(const Char_t* name, const Char_t* title, const In
   fDeltaUnfoldedP(0x0),
   fDeltaUnfoldedN(0x0),
   fNCalcCorrErrors(0),
-  fRandomSeed(randomSeed)
+  fRandomSeed(randomSeed),
+  fNThreads(1),
+  fSparseKernel(0x0)
 {
   //
   // named constructor
@@ -239,6 +339,7 @@ AliCFUnfolding::~AliCFUnfolding() {
   if (fRandom3)            delete fRandom3;
   if (fDeltaUnfoldedP)     delete fDeltaUnfoldedP;
   if (fDeltaUnfoldedN)     delete fDeltaUnfoldedN;
+  if (fSparseKernel)       delete fSparseKernel;
  
 }
 
@@ -257,6 +358,9 @@ void AliCFUnfolding::Init() {
 
   // create the matrix of conditional probabilities P(M|T)
   CreateConditional(); //done only once at initialization
+
+  // copy the conditional matrix in compressed sparse row format
+  fSparseKernel = new SparseKernel(fConditional, fResponse, fPrior, fNVariables);
   
   // create the frame of the inverse response matrix
   fInverseResponse  = (THnSparse*) fResponse->Clone();
@@ -350,6 +454,11 @@ void AliCFUnfolding::Unfold() {
   // several iterations are performed until a reasonable chi2 or convergence criterion is reached
   //
 
+  if (fSparseKernel && !fUseSmoothing) { // smoothing works on the THnSparse objects
+    UnfoldSparse();
+    return;
+  }
+
   Int_t iIterBayes     = 0 ;
   Double_t convergence = 0.;
 
@@ -457,30 +566,35 @@ void AliCFUnfolding::CalculateCorrelatedErrors() {
 
 
   //Do fNRandomIterations = bayes iterations performed
-  for (int i=0; i<fNRandomIterations; i++) {
-    
-    // reset prior to original one
-    if (fPrior) delete fPrior ;
-    fPrior = (THnSparse*) fPriorOrig->Clone();
+  if (fSparseKernel && !fUseSmoothing) {
+    CalculateCorrelatedErrorsSparse();
+  }
+  else {
+    for (int i=0; i<fNRandomIterations; i++) {
+
+      // reset prior to original one
+      if (fPrior) delete fPrior ;
+      fPrior = (THnSparse*) fPriorOrig->Clone();
 
-    // create randomized distribution and stick measured spectrum to it
-    CreateRandomizedDist();
+      // create randomized distribution and stick measured spectrum to it
+      CreateRandomizedDist();
 
-    if (fResponse) delete fResponse ;
-    fResponse = (THnSparse*) fRandomResponse->Clone();
-    fResponse->SetTitle("Response");
+      if (fResponse) delete fResponse ;
+      fResponse = (THnSparse*) fRandomResponse->Clone();
+      fResponse->SetTitle("Response");
 
-    if (fEfficiency) delete fEfficiency ;
-    fEfficiency = (THnSparse*) fRandomEfficiency->Clone();
-    fEfficiency->SetTitle("Efficiency");
+      if (fEfficiency) delete fEfficiency ;
+      fEfficiency = (THnSparse*) fRandomEfficiency->Clone();
+      fEfficiency->SetTitle("Efficiency");
 
-    if (fMeasured)   delete fMeasured   ;
-    fMeasured = (THnSparse*) fRandomMeasured->Clone();
-    fMeasured->SetTitle("Measured");
+      if (fMeasured)   delete fMeasured   ;
+      fMeasured = (THnSparse*) fRandomMeasured->Clone();
+      fMeasured->SetTitle("Measured");
 
-    //unfold with randomized distributions
-    Unfold();
-    FillDeltaUnfoldedProfile();
+      //unfold with randomized distributions
+      Unfold();
+      FillDeltaUnfoldedProfile();
+    }
   }
 
   // Get statistical errors for final unfolded spectrum
@@ -862,3 +976,481 @@ void AliCFUnfolding::CreateFlatPrior() {
   delete [] bin;
   delete [] bins;
 }
+
+//______________________________________________________________
+
+void AliCFUnfolding::UnfoldSparse() {
+  //
+  // Same as Unfold(), with the iterations performed on the sparse response matrix.
+  // The THnSparse spectra (prior, estimated measured, inverse response, unfolded)
+  // are filled from the result of the iterations.
+  //
+
+  SparseKernel::State state;
+  fSparseKernel->InitState(state,fPrior,fEfficiency,fMeasured);
+
+  Int_t iIterBayes     = 0 ;
+  Double_t convergence = 0.;
+
+  for (iIterBayes=0; iIterBayes<fMaxNumIterations; iIterBayes++) { // bayes iterations
+
+    fSparseKernel->Iterate(state); // measured estimate, inverse response and unfolded spectrum from prior
+
+    convergence = fSparseKernel->GetConvergence(state);
+    AliDebug(0,Form("convergence at iteration %d is %e",iIterBayes,convergence));
+
+    if (fMaxConvergence>0. && convergence<fMaxConvergence && fNCalcCorrErrors == 0) {
+      fNRandomIterations = iIterBayes;
+      AliDebug(0,Form("convergence is met at iteration %d",iIterBayes));
+      break;
+    }
+
+    // update the prior distribution
+    fSparseKernel->UpdatePrior(state);
+
+  } // end bayes iteration
+
+  if (fMaxNumIterations>0) {
+    fSparseKernel->FillHistograms(state,fMeasuredEstimate,fInverseResponse,fUnfolded,fPrior);
+    fSparseKernel->StoreInvResponse(state);
+  }
+
+  if (fNCalcCorrErrors==0) fUnfoldedFinal = (THnSparse*) fUnfolded->Clone() ;
+
+  if (fNCalcCorrErrors == 0) {
+    AliInfo("\n================================================\nFinished bayes iteration, now calculating errors...\n================================================\n");
+    fNCalcCorrErrors = 1;
+    CalculateCorrelatedErrors();
+  }
+
+  if (fNCalcCorrErrors >1 ) {
+    AliInfo(Form("\n\n=======================\nFinished at iteration %d : convergence is %e and you required it to be < %e\n=======================\n\n",iIterBayes,convergence,fMaxConvergence));
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::CalculateCorrelatedErrorsSparse() {
+  //
+  // Steps 1-4 of CalculateCorrelatedErrors() with the sparse response matrix :
+  // the randomized efficiency and measured spectra are unfolded independently,
+  // in fNThreads threads. Each randomized spectrum uses its own random number
+  // generator, seeded from fRandom3, so the result does not depend on the number of threads.
+  // The deltas are added to fDeltaUnfoldedP in the order of the randomized spectra.
+  //
+
+  if (!fSparseKernel->GetNTrueBins()) return;
+
+  fSparseKernel->SetRandomizedInputs(fEfficiencyOrig,fMeasuredOrig);
+
+  // bins of the final unfolded spectrum
+  const Long_t nFinal = fUnfoldedFinal->GetNbins();
+  std::vector<Int_t>    finalBins(nFinal);
+  std::vector<Double_t> finalValues(nFinal);
+  std::vector<Double_t> mean(nFinal), meanx2(nFinal), entries(nFinal);
+  for (Long_t iBin=0; iBin<nFinal; iBin++) {
+    finalValues[iBin] = fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_T);
+    finalBins[iBin]   = fSparseKernel->FindTrueBin(fCoordinatesN_T);
+    mean[iBin]        = fDeltaUnfoldedP->GetBinContent(fCoordinatesN_T);
+    meanx2[iBin]      = fDeltaUnfoldedP->GetBinError(fCoordinatesN_T);
+    entries[iBin]     = fDeltaUnfoldedN->GetBinContent(fCoordinatesN_T);
+  }
+
+  // each randomized spectrum starts from the original prior
+  SparseKernel::State initState;
+  fSparseKernel->InitState(initState,fPriorOrig,fEfficiencyOrig,fMeasuredOrig);
+
+  Int_t nThreads = fNThreads>0 ? fNThreads : 1;
+#if __cplusplus < 201103L
+  nThreads = 1;
+#endif
+
+  std::vector<std::vector<Double_t> > deltas(nThreads);
+  std::vector<TRandom3*> random(nThreads);
+  for (Int_t iThread=0; iThread<nThreads; iThread++) random[iThread] = new TRandom3(1);
+
+  for (Int_t first=0; first<fNRandomIterations; first+=nThreads) {
+    const Int_t nToys = TMath::Min(nThreads,fNRandomIterations-first);
+    for (Int_t iToy=0; iToy<nToys; iToy++) random[iToy]->SetSeed(1+fRandom3->Integer(kMaxInt)); // independent stream for each randomized spectrum
+
+    // Step 1-2 : create and unfold randomized distributions
+    if (nToys==1) {
+      fSparseKernel->UnfoldRandomized(initState,*random[0],fMaxNumIterations,finalBins,finalValues,deltas[0]);
+    }
+#if __cplusplus >= 201103L
+    else {
+      std::vector<std::thread> threads;
+      for (Int_t iToy=0; iToy<nToys; iToy++) {
+        threads.emplace_back([this,iToy,&initState,&random,&finalBins,&finalValues,&deltas]() {
+          fSparseKernel->UnfoldRandomized(initState,*random[iToy],fMaxNumIterations,finalBins,finalValues,deltas[iToy]);
+        });
+      }
+      for (std::vector<std::thread>::iterator it=threads.begin(); it!=threads.end(); ++it) it->join();
+    }
+#endif
+
+    // Step 3 : update the delta profile, in the order of the randomized distributions (see FillDeltaUnfoldedProfile())
+    for (Int_t iToy=0; iToy<nToys; iToy++) {
+      for (Long_t iBin=0; iBin<nFinal; iBin++) {
+        Double_t deltaInBin = deltas[iToy][iBin];
+        mean[iBin]   = (mean[iBin]*entries[iBin] + deltaInBin) / (entries[iBin]+1) ;
+        meanx2[iBin] = (meanx2[iBin]*entries[iBin] + deltaInBin*deltaInBin) / (entries[iBin]+1) ;
+        entries[iBin]++;
+      }
+    }
+  }
+
+  for (Int_t iThread=0; iThread<nThreads; iThread++) delete random[iThread];
+
+  for (Long_t iBin=0; iBin<nFinal; iBin++) {
+    fUnfoldedFinal->GetBinContent(iBin,fCoordinatesN_T);
+    fDeltaUnfoldedP->SetBinError  (fCoordinatesN_T,meanx2[iBin]) ;
+    fDeltaUnfoldedP->SetBinContent(fCoordinatesN_T,mean[iBin]) ;
+    fDeltaUnfoldedN->SetBinContent(fCoordinatesN_T,entries[iBin]);
+  }
+}
+
+//______________________________________________________________
+
+AliCFUnfolding::SparseKernel::SparseKernel(const THnSparse* conditional, const THnSparse* response, const THnSparse* prior, Int_t nVar) :
+  fNVariables(nVar),
+  fStrideM(nVar),
+  fStrideT(nVar),
+  fIndexM(),
+  fIndexT(),
+  fCoordM(),
+  fCoordT(),
+  fEntryM(),
+  fEntryT(),
+  fEntryValue(),
+  fEntryInv(),
+  fRowStart(),
+  fRowEntries(),
+  fColStart(),
+  fColEntries(),
+  fRandEffBins(),
+  fRandEffValues(),
+  fRandEffErrors(),
+  fRandMeasBins(),
+  fRandMeasValues(),
+  fRandMeasErrors()
+{
+  //
+  // converts the conditional matrix, done once at initialisation
+  //
+
+  Long64_t strideM = 1, strideT = 1;
+  for (Int_t i=0; i<fNVariables; i++) {
+    fStrideM[i] = strideM;
+    fStrideT[i] = strideT;
+    strideM *= conditional->GetAxis(i)           ->GetNbins()+2;
+    strideT *= conditional->GetAxis(i+fNVariables)->GetNbins()+2;
+  }
+
+  const Long64_t nEntries = conditional->GetNbins();
+  fEntryM    .reserve(nEntries);
+  fEntryT    .reserve(nEntries);
+  fEntryValue.reserve(nEntries);
+  fEntryInv  .reserve(nEntries);
+
+  std::vector<Int_t> coord2N(2*fNVariables);
+  for (Long64_t iBin=0; iBin<nEntries; iBin++) {
+    fEntryValue.push_back(conditional->GetBinContent(iBin,&coord2N[0]));
+    fEntryInv  .push_back(response->GetBinContent(&coord2N[0])); // the inverse response is a copy of the response at start
+    fEntryM    .push_back(AddBin(fIndexM,fStrideM,fCoordM,&coord2N[0]));
+    fEntryT    .push_back(AddBin(fIndexT,fStrideT,fCoordT,&coord2N[fNVariables]));
+  }
+
+  // bins of the prior which are not in the response matrix still enter the convergence criterion
+  std::vector<Int_t> coordN(fNVariables);
+  for (Long64_t iBin=0; iBin<prior->GetNbins(); iBin++) {
+    prior->GetBinContent(iBin,&coordN[0]);
+    AddBin(fIndexT,fStrideT,fCoordT,&coordN[0]);
+  }
+
+  // index the entries by measured bin (rows) and by true bin (columns), keeping the original order
+  const Int_t nM = GetNMeasuredBins();
+  const Int_t nT = GetNTrueBins();
+  fRowStart.assign(nM+1,0);
+  fColStart.assign(nT+1,0);
+  for (Long64_t iEntry=0; iEntry<nEntries; iEntry++) {
+    fRowStart[fEntryM[iEntry]+1]++;
+    fColStart[fEntryT[iEntry]+1]++;
+  }
+  for (Int_t m=0; m<nM; m++) fRowStart[m+1] += fRowStart[m];
+  for (Int_t t=0; t<nT; t++) fColStart[t+1] += fColStart[t];
+
+  fRowEntries.resize(nEntries);
+  fColEntries.resize(nEntries);
+  std::vector<Int_t> rowFill(fRowStart.begin(),fRowStart.end()-1);
+  std::vector<Int_t> colFill(fColStart.begin(),fColStart.end()-1);
+  for (Long64_t iEntry=0; iEntry<nEntries; iEntry++) {
+    fRowEntries[rowFill[fEntryM[iEntry]]++] = iEntry;
+    fColEntries[colFill[fEntryT[iEntry]]++] = iEntry;
+  }
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfolding::SparseKernel::AddBin(std::map<Long64_t,Int_t>& index, const std::vector<Long64_t>& stride, std::vector<Int_t>& coords, const Int_t* coord) {
+  //
+  // returns the compact index of the bin, adding it if not yet known
+  //
+  Long64_t global = 0;
+  for (Int_t i=0; i<fNVariables; i++) global += coord[i]*stride[i];
+  std::map<Long64_t,Int_t>::const_iterator it = index.find(global);
+  if (it != index.end()) return it->second;
+  Int_t bin = coords.size()/fNVariables;
+  index[global] = bin;
+  coords.insert(coords.end(),coord,coord+fNVariables);
+  return bin;
+}
+
+//______________________________________________________________
+
+Int_t AliCFUnfolding::SparseKernel::FindBin(const std::map<Long64_t,Int_t>& index, const std::vector<Long64_t>& stride, const Int_t* coord) const {
+  //
+  // returns the compact index of the bin, -1 if not used
+  //
+  Long64_t global = 0;
+  for (Int_t i=0; i<fNVariables; i++) global += coord[i]*stride[i];
+  std::map<Long64_t,Int_t>::const_iterator it = index.find(global);
+  return (it != index.end() ? it->second : -1);
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SparseKernel::InitState(State& state, const THnSparse* prior, const THnSparse* efficiency, const THnSparse* measured) const {
+  //
+  // copies the input spectra
+  //
+  const Int_t nM = GetNMeasuredBins();
+  const Int_t nT = GetNTrueBins();
+
+  state.fPrior.assign(nT,0.);
+  state.fPriorBins.clear();
+  state.fPriorUpdated = kFALSE;
+  std::vector<Int_t> coordN(fNVariables);
+  for (Long64_t iBin=0; iBin<prior->GetNbins(); iBin++) {
+    Double_t value = prior->GetBinContent(iBin,&coordN[0]);
+    Int_t t = FindTrueBin(&coordN[0]);
+    if (t<0) continue;
+    state.fPrior[t] = value;
+    state.fPriorBins.push_back(t);
+  }
+
+  state.fEfficiency.resize(nT);
+  for (Int_t t=0; t<nT; t++) state.fEfficiency[t] = efficiency->GetBinContent(&fCoordT[t*fNVariables]);
+  state.fMeasured.resize(nM);
+  for (Int_t m=0; m<nM; m++) state.fMeasured[m] = measured->GetBinContent(&fCoordM[m*fNVariables]);
+
+  state.fPriorTimesEff.assign(nT,0.);
+  state.fEstMeasured  .assign(nM,0.);
+  state.fEstFirst     .assign(nM,-1);
+  state.fInvResponse = fEntryInv;
+  state.fInvSet       .assign(fEntryInv.size(),0);
+  state.fUnfolded     .assign(nT,0.);
+  state.fUnfoldedFirst.assign(nT,-1);
+  state.fUnfoldedBins .clear();
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SparseKernel::FillRandomizedInput(const THnSparse* hist, Bool_t isTrue, std::vector<Int_t>& bins, std::vector<Double_t>& values, std::vector<Double_t>& errors) const {
+  //
+  // stores the bins of a spectrum to be randomized (see CreateRandomizedDist())
+  //
+  const Long64_t nBins = hist->GetNbins();
+  bins  .resize(nBins);
+  values.resize(nBins);
+  errors.resize(nBins);
+  std::vector<Int_t> coordN(fNVariables);
+  for (Long64_t iBin=0; iBin<nBins; iBin++) {
+    values[iBin] = hist->GetBinContent(iBin,&coordN[0]);
+    errors[iBin] = hist->GetBinError(iBin);
+    bins  [iBin] = (isTrue ? FindTrueBin(&coordN[0]) : FindMeasuredBin(&coordN[0]));
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SparseKernel::SetRandomizedInputs(const THnSparse* efficiency, const THnSparse* measured) {
+  //
+  // sets the spectra to be randomized for the correlated error calculation
+  // (the randomized response matrix does not enter the unfolding, as the conditional matrix is computed once)
+  //
+  FillRandomizedInput(efficiency,kTRUE ,fRandEffBins ,fRandEffValues ,fRandEffErrors );
+  FillRandomizedInput(measured  ,kFALSE,fRandMeasBins,fRandMeasValues,fRandMeasErrors);
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SparseKernel::RandomizeInputs(State& state, TRandom3& random) const {
+  //
+  // replaces efficiency and measured spectrum by randomized ones (gaussian with mean = value and sigma = error)
+  //
+  state.fEfficiency.assign(GetNTrueBins(),0.);
+  for (UInt_t iBin=0; iBin<fRandEffBins.size(); iBin++) {
+    Double_t ran = random.Gaus(fRandEffValues[iBin],fRandEffErrors[iBin]);
+    if (fRandEffBins[iBin]>=0) state.fEfficiency[fRandEffBins[iBin]] = ran;
+  }
+  state.fMeasured.assign(GetNMeasuredBins(),0.);
+  for (UInt_t iBin=0; iBin<fRandMeasBins.size(); iBin++) {
+    Double_t ran = random.Gaus(fRandMeasValues[iBin],fRandMeasErrors[iBin]);
+    if (fRandMeasBins[iBin]>=0) state.fMeasured[fRandMeasBins[iBin]] = ran;
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SparseKernel::Iterate(State& state) const {
+  //
+  // one bayes iteration (see CreateEstMeasured(), CreateInvResponse() and CreateUnfolded())
+  //
+  const Int_t nM = GetNMeasuredBins();
+  const Int_t nT = GetNTrueBins();
+
+  for (Int_t t=0; t<nT; t++) state.fPriorTimesEff[t] = state.fPrior[t] * state.fEfficiency[t];
+
+  // M(i) = SUM_k { COND(i,k) * T(k) * E (k)}
+  for (Int_t m=0; m<nM; m++) {
+    Double_t sum = 0.;
+    Int_t first = -1;
+    for (Int_t k=fRowStart[m]; k<fRowStart[m+1]; k++) {
+      Int_t iEntry = fRowEntries[k];
+      Double_t fill = fEntryValue[iEntry] * state.fPriorTimesEff[fEntryT[iEntry]];
+      if (fill>0.) {
+        sum += fill;
+        if (first<0) first = iEntry;
+      }
+    }
+    state.fEstMeasured[m] = sum;
+    state.fEstFirst[m]    = first;
+  }
+
+  // INV(i,j) = COND(i,j) * T(j) * E(j) / SUM_k { COND(i,k) * T(k) }
+  const Int_t nEntries = fEntryValue.size();
+  for (Int_t iEntry=0; iEntry<nEntries; iEntry++) {
+    Double_t estMeasuredValue = state.fEstMeasured[fEntryM[iEntry]];
+    Double_t fill = (estMeasuredValue>0. ? fEntryValue[iEntry] * state.fPriorTimesEff[fEntryT[iEntry]] / estMeasuredValue : 0.);
+    if (fill>0. || state.fInvResponse[iEntry]>0.) {
+      state.fInvResponse[iEntry] = fill;
+      state.fInvSet[iEntry] = 1;
+    }
+  }
+
+  // T(i) = SUM_k { INV(i,k) * M(k) }
+  for (Int_t t=0; t<nT; t++) {
+    Double_t effValue = state.fEfficiency[t];
+    Double_t sum = 0.;
+    Int_t first = -1;
+    for (Int_t k=fColStart[t]; k<fColStart[t+1]; k++) {
+      Int_t iEntry = fColEntries[k];
+      Double_t fill = (effValue>0. ? state.fInvResponse[iEntry] * state.fMeasured[fEntryM[iEntry]] / effValue : 0.);
+      if (fill>0.) {
+        sum += fill;
+        if (first<0) first = iEntry;
+      }
+    }
+    state.fUnfolded[t]      = sum;
+    state.fUnfoldedFirst[t] = first;
+  }
+
+  // filled bins in the order they would be created in the THnSparse
+  std::vector<std::pair<Int_t,Int_t> > filled;
+  for (Int_t t=0; t<nT; t++) if (state.fUnfoldedFirst[t]>=0) filled.push_back(std::make_pair(state.fUnfoldedFirst[t],t));
+  std::sort(filled.begin(),filled.end());
+  state.fUnfoldedBins.resize(filled.size());
+  for (UInt_t i=0; i<filled.size(); i++) state.fUnfoldedBins[i] = filled[i].second;
+}
+
+//______________________________________________________________
+
+Double_t AliCFUnfolding::SparseKernel::GetConvergence(const State& state) const {
+  //
+  // see AliCFUnfolding::GetConvergence()
+  //
+  Double_t convergence = 0.;
+  for (UInt_t i=0; i<state.fPriorBins.size(); i++) {
+    Int_t t = state.fPriorBins[i];
+    Double_t priorValue   = state.fPrior[t];
+    Double_t currentValue = state.fUnfolded[t];
+    if (priorValue > 0.)
+      convergence += ((priorValue-currentValue)/priorValue)*((priorValue-currentValue)/priorValue);
+    else
+      AliWarningGeneral("AliCFUnfolding",Form("priorValue = %f. Adding 0 to convergence criterion.",priorValue));
+  }
+  return convergence;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SparseKernel::UpdatePrior(State& state) const {
+  //
+  // the unfolded spectrum becomes the prior of the next iteration
+  //
+  state.fPrior        = state.fUnfolded;
+  state.fPriorBins    = state.fUnfoldedBins;
+  state.fPriorUpdated = kTRUE;
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SparseKernel::FillHistograms(const State& state, THnSparse* estMeasured, THnSparse* invResponse, THnSparse* unfolded, THnSparse* prior) const {
+  //
+  // fills the THnSparse spectra from the state, as they would be after the same iterations with the THnSparse-based loops
+  //
+  estMeasured->Reset();
+  std::vector<std::pair<Int_t,Int_t> > filled;
+  for (Int_t m=0; m<GetNMeasuredBins(); m++) if (state.fEstFirst[m]>=0) filled.push_back(std::make_pair(state.fEstFirst[m],m));
+  std::sort(filled.begin(),filled.end());
+  for (UInt_t i=0; i<filled.size(); i++) {
+    const Int_t* coord = &fCoordM[filled[i].second*fNVariables];
+    estMeasured->SetBinContent(coord,state.fEstMeasured[filled[i].second]);
+    estMeasured->SetBinError  (coord,0.);
+  }
+
+  std::vector<Int_t> coord2N(2*fNVariables);
+  for (UInt_t iEntry=0; iEntry<state.fInvSet.size(); iEntry++) {
+    if (!state.fInvSet[iEntry]) continue;
+    std::copy(&fCoordM[fEntryM[iEntry]*fNVariables],&fCoordM[fEntryM[iEntry]*fNVariables]+fNVariables,coord2N.begin());
+    std::copy(&fCoordT[fEntryT[iEntry]*fNVariables],&fCoordT[fEntryT[iEntry]*fNVariables]+fNVariables,coord2N.begin()+fNVariables);
+    invResponse->SetBinContent(&coord2N[0],state.fInvResponse[iEntry]);
+    invResponse->SetBinError  (&coord2N[0],0.);
+  }
+
+  unfolded->Reset();
+  for (UInt_t i=0; i<state.fUnfoldedBins.size(); i++) {
+    Int_t t = state.fUnfoldedBins[i];
+    unfolded->SetBinError  (&fCoordT[t*fNVariables],0.);
+    unfolded->SetBinContent(&fCoordT[t*fNVariables],state.fUnfolded[t]);
+  }
+
+  if (state.fPriorUpdated) {
+    prior->Reset();
+    for (UInt_t i=0; i<state.fPriorBins.size(); i++) {
+      Int_t t = state.fPriorBins[i];
+      prior->SetBinContent(&fCoordT[t*fNVariables],state.fPrior[t]);
+      prior->SetBinError  (&fCoordT[t*fNVariables],0.);
+    }
+    prior->SetTitle("Prior");
+  }
+}
+
+//______________________________________________________________
+
+void AliCFUnfolding::SparseKernel::UnfoldRandomized(const State& init, TRandom3& random, Int_t nIterations,
+                                                    const std::vector<Int_t>& bins, const std::vector<Double_t>& values, std::vector<Double_t>& delta) const {
+  //
+  // unfolds one randomized spectrum and returns the difference to the final unfolded spectrum
+  // for the given (true) bins. Only touches the arguments, so can be called from several threads.
+  //
+  State state(init);
+  RandomizeInputs(state,random);
+  for (Int_t iIterBayes=0; iIterBayes<nIterations; iIterBayes++) {
+    Iterate(state);
+    UpdatePrior(state);
+  }
+  delta.resize(bins.size());
+  for (UInt_t iBin=0; iBin<bins.size(); iBin++) delta[iBin] = values[iBin] - (bins[iBin]>=0 ? state.fUnfolded[bins[iBin]] : 0.);
+}
@@ -36,6 +36,7 @@ class AliCFUnfolding : public TNamed {
   }
 
   void SetNRandomIterations(Int_t n = 100) {fNRandomIterations = n;};
+  void SetNumberOfThreads(Int_t n = 1) {fNThreads = n;}       // number of threads used to unfold the randomized spectra
 
   void UseSmoothing(TF1* fcn=0x0, Option_t* opt="iremn") { // if fcn=0x0 then smooth using neighbouring bins 
     fUseSmoothing=kTRUE;                                   // this function must NOT be used if fNVariables > 3
@@ -111,6 +112,11 @@ class AliCFUnfolding : public TNamed {
   THnSparse     *fDeltaUnfoldedN;    // Entries of the delta-unfolded distribution (count for each bin)
   Short_t        fNCalcCorrErrors;   // Book-keeping to prevend infinite loop
   UInt_t         fRandomSeed;        // Random seed
+  Int_t          fNThreads;          // Number of threads for the correlated error calculation
+
+  /* sparse matrix engine (not used with smoothing) */
+  class SparseKernel;
+  SparseKernel  *fSparseKernel;      //! Response matrix in compressed sparse row format
 
 
   // functions
@@ -132,7 +138,11 @@ class AliCFUnfolding : public TNamed {
   void     FillDeltaUnfoldedProfile();  // Fills the fDeltaUnfoldedP profile
   void     SetMaxConvergencePerDOF (Double_t val);
 
-  ClassDef(AliCFUnfolding,1);
+  /* sparse matrix engine */
+  void     UnfoldSparse();                     // Unfold() using the sparse response matrix
+  void     CalculateCorrelatedErrorsSparse();  // Unfolds the randomized distributions using the sparse response matrix
+
+  ClassDef(AliCFUnfolding,2);
 };
 
 #endif
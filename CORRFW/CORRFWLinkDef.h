@@ -8,7 +8,7 @@
 #pragma link C++ class  AliCFGridSparse+;
 #pragma link C++ class  AliCFEffGrid+;
 #pragma link C++ class  AliCFDataGrid+;
-#pragma link C++ class  AliCFContainer+;
+#pragma link C++ class  AliCFContainer-;
 #pragma link C++ class  AliCFManager+;
 #pragma link C++ class  AliCFCutBase+;
 #pragma link C++ class  AliCFEventClassCuts+;
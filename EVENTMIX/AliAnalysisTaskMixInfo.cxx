@@ -141,6 +141,10 @@ void AliAnalysisTaskMixInfo::UserExecMix(Option_t *)
 void AliAnalysisTaskMixInfo::FinishTaskOutput()
 {
    // FinishTaskOutput
+   if (fMixInfo && fInputEHMix) {
+      fMixInfo->SetReadStatistics(fInputEHMix->MixRequests(), fInputEHMix->MixCacheHits(), fInputEHMix->MixEntriesRead(),
+                                  fInputEHMix->MixBytesRead(), fInputEHMix->MixedEventsProcessed());
+   }
    if (fMixInfo) fMixInfo->Print();
 }
 
@@ -216,6 +220,7 @@ void AliAnalysisTaskMixInfo::InitMixInfo()
          if (fMixInfo) fMixInfo->CreateHistogram(AliMixInfo::kMainEvents, num, 1, num + 1);
          if (fMixInfo) fMixInfo->CreateHistogram(AliMixInfo::kMixedEvents, num, 1, num + 1);
       }
+      if (fMixInfo) fMixInfo->CreateReadStatisticsHistogram();
    }
 }
 
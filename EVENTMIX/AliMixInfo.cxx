@@ -142,6 +142,14 @@ void AliMixInfo::Print(Option_t *option) const
          continue;
       }
    }
+   TH1D *hRead = GetReadStatisticsHistogram();
+   if (hRead && hRead->GetBinContent(kReadRequests) > 0) {
+      Double_t nMixed = hRead->GetBinContent(kReadMixedEvents);
+      AliInfo(Form("Mixed events: requested=%.0f cache hits=%.0f (%.1f%%) read=%.0f bytes per mixed event=%.0f",
+                   hRead->GetBinContent(kReadRequests), hRead->GetBinContent(kReadCacheHits),
+                   100. * hRead->GetBinContent(kReadCacheHits) / hRead->GetBinContent(kReadRequests),
+                   hRead->GetBinContent(kReadEntries), nMixed > 0 ? hRead->GetBinContent(kReadBytes) / nMixed : 0.));
+   }
 }
 //_________________________________________________________________________________________________
 void AliMixInfo::Draw(Option_t *option)
@@ -435,6 +443,8 @@ void AliMixInfo::Add(AliMixInfo *mi)
    }
    hMain->Add(mi->GetHistogramByType(kMainEvents));
    hMix->Add(mi->GetHistogramByType(kMixedEvents));
+   TH1D *hRead = GetReadStatisticsHistogram();
+   if (hRead && mi->GetReadStatisticsHistogram()) hRead->Add(mi->GetReadStatisticsHistogram());
 }
 
 //_________________________________________________________________________________________________
@@ -461,3 +471,50 @@ AliMixEventPool *AliMixInfo::GetEventPool(const char *name)
    return (AliMixEventPool *) fHistogramList->FindObject(name);
 }
 
+//_________________________________________________________________________________________________
+void AliMixInfo::CreateReadStatisticsHistogram()
+{
+   //
+   // Creates histogram with read statistics of mixed events
+   //
+   if (!fHistogramList) {
+      fHistogramList = new TList;
+      fHistogramList->SetOwner(kTRUE);
+   }
+   if (GetReadStatisticsHistogram()) return;
+   TH1D *hist = new TH1D("hMixReadStats", "Mixed events read statistics", 5, 0.5, 5.5);
+   hist->GetXaxis()->SetBinLabel(kReadRequests, "Requests");
+   hist->GetXaxis()->SetBinLabel(kReadCacheHits, "CacheHits");
+   hist->GetXaxis()->SetBinLabel(kReadEntries, "EntriesRead");
+   hist->GetXaxis()->SetBinLabel(kReadBytes, "BytesRead");
+   hist->GetXaxis()->SetBinLabel(kReadMixedEvents, "MixedEvents");
+   fHistogramList->Add(hist);
+}
+
+//_________________________________________________________________________________________________
+void AliMixInfo::SetReadStatistics(Long64_t requests, Long64_t cacheHits, Long64_t entriesRead, Long64_t bytesRead, Long64_t mixedEvents)
+{
+   //
+   // Sets read statistics of mixed events (totals, summed in Merge)
+   //
+   TH1D *hist = GetReadStatisticsHistogram();
+   if (!hist) {
+      AliError("Read statistics histogram was not created");
+      return;
+   }
+   hist->SetBinContent(kReadRequests, requests);
+   hist->SetBinContent(kReadCacheHits, cacheHits);
+   hist->SetBinContent(kReadEntries, entriesRead);
+   hist->SetBinContent(kReadBytes, bytesRead);
+   hist->SetBinContent(kReadMixedEvents, mixedEvents);
+}
+
+//_________________________________________________________________________________________________
+TH1D *AliMixInfo::GetReadStatisticsHistogram() const
+{
+   //
+   // Returns histogram with read statistics of mixed events
+   //
+   if (!fHistogramList) return 0;
+   return (TH1D *) fHistogramList->FindObject("hMixReadStats");
+}
@@ -16,11 +16,13 @@
 
 class AliMixEventPool;
 class TH1I;
+class TH1D;
 class TList;
 class TCollection;
 class AliMixInfo : public TNamed {
 public:
    enum EInfoHistorgramType { kMainEvents = 0, kMixedEvents = 1, kNumTypes };
+   enum EReadStatistics { kReadRequests = 1, kReadCacheHits, kReadEntries, kReadBytes, kReadMixedEvents };
 
    AliMixInfo(const char *name = "mix", const char *title = "MixInfo");
    AliMixInfo(const AliMixInfo &obj);
@@ -40,6 +42,10 @@ public:
    const char *GetTitleHistogramByType(Int_t index) const;
    TH1I  *GetHistogramByType(Int_t index) const;
 
+   void   CreateReadStatisticsHistogram();
+   void   SetReadStatistics(Long64_t requests, Long64_t cacheHits, Long64_t entriesRead, Long64_t bytesRead, Long64_t mixedEvents);
+   TH1D  *GetReadStatisticsHistogram() const;
+
    void    SetEventPool(AliMixEventPool *evPool);
    AliMixEventPool *GetEventPool(const char *name);
 
@@ -11,6 +11,9 @@
 #include <TChain.h>
 #include <TChainElement.h>
 #include <TSystem.h>
+#include <TMath.h>
+
+#include <utility>
 
 #include "AliLog.h"
 #include "AliAnalysisManager.h"
@@ -43,7 +46,16 @@ AliMixInputEventHandler::AliMixInputEventHandler(const Int_t size, const Int_t m
    fCurrentBinIndex(-1),
    fOfflineTriggerMask(0),
    fCurrentMixEntry(),
-   fCurrentEntryMainTree(0)
+   fCurrentEntryMainTree(0),
+   fMixEventCacheSize(0),
+   fMixReadCacheSize(0),
+   fMixAsyncPrefetch(kFALSE),
+   fMixBranches(),
+   fMixCachedEntry(),
+   fMixCacheStamp(),
+   fMixRequests(0),
+   fMixCacheHits(0),
+   fMixedEventsProcessed(0)
 {
    //
    // Default constructor.
@@ -66,11 +78,12 @@ void AliMixInputEventHandler::SetInputHandlerForMixing(const AliInputEventHandle
 {
    //
    // Create N (fBufferSize) copies of input handler
+   // (+ fMixEventCacheSize copies keeping cached mixed events)
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
    fInputHandlers.Clear();
-   AliDebug(AliLog::kDebug + 5, Form("Creating %d input event handlers ...", fBufferSize));
-   for (Int_t i = 0; i < fBufferSize; i++) {
+   AliDebug(AliLog::kDebug + 5, Form("Creating %d input event handlers ...", fBufferSize + fMixEventCacheSize));
+   for (Int_t i = 0; i < fBufferSize + fMixEventCacheSize; i++) {
       AliDebug(AliLog::kDebug + 5, Form("Adding %d ...", i));
       fInputHandlers.Add((AliInputEventHandler *) inHandler->Clone());
    }
@@ -99,6 +112,7 @@ Bool_t AliMixInputEventHandler::Init(TTree *tree, Option_t *opt)
 
    // clears array of input handlers
    fMixTrees.Delete();
+   ResetMixEventCache();
    // create AliMixInputHandlerInfo
    if (!fMixIntupHandlerInfoTmp) {
       // loads first file TChain (tree)
@@ -149,10 +163,13 @@ Bool_t AliMixInputEventHandler::Notify(const char *path)
    fMixIntupHandlerInfoTmp->AddTreeToChain(path);
    Int_t lastIndex = fMixIntupHandlerInfoTmp->GetChain()->GetListOfFiles()->GetEntries();
    TChainElement *che = (TChainElement *)fMixIntupHandlerInfoTmp->GetChain()->GetListOfFiles()->At(lastIndex - 1);
+   // input handlers will be connected to new chains
+   if (doPrepareEntry) FinishMixEventCache();
    AliMixInputHandlerInfo *mixIHI = 0;
    for (Int_t i = 0; i < fInputHandlers.GetEntries(); i++) {
       AliDebug(AliLog::kDebug + 5, Form("fInputHandlers[%d]", i));
       mixIHI = new AliMixInputHandlerInfo(fMixIntupHandlerInfoTmp->GetName(), fMixIntupHandlerInfoTmp->GetTitle());
+      mixIHI->SetReadCache(fMixReadCacheSize, fMixBranches.Data(), fMixAsyncPrefetch);
       if (doPrepareEntry) mixIHI->PrepareEntry(che, -1, (AliInputEventHandler *)InputEventHandler(i), fAnalysisType);
       AliDebug(AliLog::kDebug + 5, Form("chain[%d]->GetEntries() = %lld", i, mixIHI->GetChain()->GetEntries()));
       fMixTrees.Add(mixIHI);
@@ -245,7 +262,6 @@ Bool_t AliMixInputEventHandler::MixStd()
    AliDebug(AliLog::kDebug + 3, Form("++++++++++++++ BEGIN SETUP EVENT %lld +++++++++++++++++++", fEntryCounter));
    // reset mix number
    fNumberMixed = 0;
-   AliMixInputHandlerInfo *mihi = 0;
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
    for (counter = 0; counter < mixNum; counter++) {
@@ -253,16 +269,15 @@ Bool_t AliMixInputEventHandler::MixStd()
       AliDebug(AliLog::kDebug + 5, Form("Handler[%d] entryMix %lld ", counter, entryMix));
       if (entryMix < 0) break;
       entryMixReal = entryMix;
-      mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
       TChainElement *te = fMixIntupHandlerInfoTmp->GetEntryInTree(entryMix);
       if (!te) {
          AliError("te is null. this is error. tell to developer (#1)");
       } else {
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         if (fDoMixEventGetEntryAuto) PrepareMixEntry(0, entryMixReal, te, entryMix, 1);
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, 1, fEntryCounter, entryMixReal, fNumberMixed);
-         InputEventHandler(0)->FinishEvent();
+         FinishMixEntry(0);
       }
    }
    AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
@@ -328,12 +343,12 @@ Bool_t AliMixInputEventHandler::MixBuffer()
       }
    }
 
-   AliMixInputHandlerInfo *mihi = 0;
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
    AliInputEventHandler *eh = 0;
    TObjArrayIter next(&fInputHandlers);
-   while ((eh = dynamic_cast<AliInputEventHandler *>(next()))) {
+   // input handlers behind fBufferSize belong to event cache (see PrepareMixEntry)
+   while (counter < fBufferSize && (eh = dynamic_cast<AliInputEventHandler *>(next()))) {
       if (fEventPool && fEventPool->GetListOfEventCuts()->GetEntries() > 0) {
          entryMix = -1;
          if (elNum >= fBufferSize) {
@@ -348,14 +363,13 @@ Bool_t AliMixInputEventHandler::MixBuffer()
          break;
       }
       entryMixReal = entryMix;
-      mihi = (AliMixInputHandlerInfo *) fMixTrees.At(counter);
       TChainElement *te = fMixIntupHandlerInfoTmp->GetEntryInTree(entryMix);
       if (!te) {
          AliError("te is null. this is error. tell to developer (#1)");
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
          AliDebug(AliLog::kDebug + 3, Form("Preparing InputEventHandler(%d)", counter));
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(counter), fAnalysisType);
+         if (fDoMixEventGetEntryAuto) PrepareMixEntry(counter, entryMixReal, te, entryMix, counter + 1);
          fNumberMixed++;
       }
       counter++;
@@ -452,10 +466,8 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
    if (fDoMixExtra) {
       if (elNum <= 2 * fMixNumber + 1) mixNum = elNum + 1;
    }
-   AliMixInputHandlerInfo *mihi = 0;
    Long64_t entryMix = 0, entryMixReal = 0;
    Int_t counter = 0;
-   mihi = (AliMixInputHandlerInfo *) fMixTrees.At(0);
    // fills num for main events
    for (counter = 0; counter < mixNum; counter++) {
       fCurrentMixEntry.Reset();
@@ -471,11 +483,11 @@ Bool_t AliMixInputEventHandler::MixEventsMoreTimesWithOneEvent()
          AliError("te is null. this is error. tell to developer (#2)");
       } else {
          fCurrentMixEntry.Enter(entryMixReal);
-         if (fDoMixEventGetEntryAuto) mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(0), fAnalysisType);
+         if (fDoMixEventGetEntryAuto) PrepareMixEntry(0, entryMixReal, te, entryMix, 1);
          // runs UserExecMix for all tasks
          fNumberMixed++;
          UserExecMixAllTasks(fEntryCounter, idEntryList, currentMainEntry, entryMixReal, fNumberMixed);
-         InputEventHandler(0)->FinishEvent();
+         FinishMixEntry(0);
       }
    }
    AliDebug(AliLog::kDebug + 3, Form("fEntryCounter=%lld fMixEventNumber=%d", fEntryCounter, fNumberMixed));
@@ -502,7 +514,9 @@ Bool_t AliMixInputEventHandler::FinishEvent()
    // FinishEvent() is called for all mix input handlers
    //
    AliDebug(AliLog::kDebug + 5, Form("<-"));
-   AliMultiInputEventHandler::FinishEvent();
+   // with event cache mixing input handlers keep their events,
+   // they are finished only before they are reused (see PrepareMixEntry)
+   if (fMixEventCacheSize <= 0) AliMultiInputEventHandler::FinishEvent();
    fEntryCounter++;
    AliDebug(AliLog::kDebug + 5, Form("->"));
    return kTRUE;
@@ -518,6 +532,19 @@ void AliMixInputEventHandler::AddInputEventHandler(AliVEventHandler *)
    AliWarning("Use AliMixEventInputHandler::SetInputHandlerForMixing instead. Exiting ...");
 }
 
+//_____________________________________________________________________________
+Bool_t AliMixInputEventHandler::Terminate()
+{
+   //
+   // Terminate() is called for all mix input handlers
+   // (mixed events kept in event cache are finished first)
+   //
+   AliDebug(AliLog::kDebug + 5, Form("<-"));
+   FinishMixEventCache();
+   AliDebug(AliLog::kDebug + 5, Form("->"));
+   return AliMultiInputEventHandler::Terminate();
+}
+
 //_____________________________________________________________________________
 void AliMixInputEventHandler::UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed)
 {
@@ -526,6 +553,7 @@ void AliMixInputEventHandler::UserExecMixAllTasks(Long64_t entryCounter, Int_t i
    //
    AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
    AliAnalysisTaskSE *mixTask = 0;
+   if (entryMixReal >= 0) fMixedEventsProcessed++;
    TObjArrayIter next(mgr->GetTasks());
    while ((mixTask = dynamic_cast<AliAnalysisTaskSE *>(next()))) {
       AliDebug(AliLog::kDebug, Form("%s %lld %d [%lld,%lld] %d", mixTask->GetName(), entryCounter, numMixed, entryMainReal, entryMixReal, idEntryList));
@@ -605,9 +633,8 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
    // (Should be used in UserExecMix() only)
    //
 
-   AliMixInputHandlerInfo *mihi = (AliMixInputHandlerInfo *) fMixTrees.At(id);
-
    Long64_t entryMix = fCurrentMixEntry.GetEntry(fCurrentMixEntry.GetN()-id-1);
+   Long64_t entryMixReal = entryMix;
    if(entryMix<0) {
       AliError(Form("GetEntryMixedEvent(%d) => entryMix<0 [1]",id));
       return kFALSE;
@@ -621,7 +648,147 @@ Bool_t AliMixInputEventHandler::GetEntryMixedEvent(Int_t id) {
       AliError(Form("GetEntryMixedEvent(%d) => entryMix<0 [2]",id));
       return kFALSE;
    }
-   mihi->PrepareEntry(te, entryMix, (AliInputEventHandler *)InputEventHandler(id), fAnalysisType);
+   // other buffer positions are in use, only spare input handlers may be taken
+   PrepareMixEntry(id, entryMixReal, te, entryMix, fBufferSize);
 
    return kTRUE;
 }
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::SetMixEventCache(Int_t nEvents)
+{
+   //
+   // Keeps up to nEvents already read mixed events in extra input handlers,
+   // so events which are mixed again (e.g. for next main event from the same
+   // pool) are not read and processed by input handler again.
+   // Input handlers are created in SetInputHandlerForMixing (or here,
+   // when it was called already)
+   //
+   fMixEventCacheSize = (nEvents > 0) ? nEvents : 0;
+   if (fInputHandlers.GetEntriesFast() > 0) {
+      AliInputEventHandler *ih = (AliInputEventHandler *) fInputHandlers.At(0);
+      while (fInputHandlers.GetEntriesFast() < fBufferSize + fMixEventCacheSize)
+         fInputHandlers.Add((AliInputEventHandler *) ih->Clone());
+   }
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::AddMixBranch(const char *name)
+{
+   //
+   // Adds branch which is read for mixed events. When no branch is added,
+   // all branches are read
+   //
+   if (!fMixBranches.IsNull()) fMixBranches += ",";
+   fMixBranches += name;
+}
+
+//_____________________________________________________________________________
+Long64_t AliMixInputEventHandler::MixEntriesRead() const
+{
+   //
+   // Returns number of entries read by mixing input handlers
+   //
+   Long64_t n = 0;
+   Int_t nHandlers = TMath::Min(fInputHandlers.GetEntriesFast(), fMixTrees.GetEntriesFast());
+   for (Int_t i = 0; i < nHandlers; i++) n += ((AliMixInputHandlerInfo *) fMixTrees.At(i))->GetNEntriesRead();
+   return n;
+}
+
+//_____________________________________________________________________________
+Long64_t AliMixInputEventHandler::MixBytesRead() const
+{
+   //
+   // Returns number of (uncompressed) bytes read by mixing input handlers
+   //
+   Long64_t n = 0;
+   Int_t nHandlers = TMath::Min(fInputHandlers.GetEntriesFast(), fMixTrees.GetEntriesFast());
+   for (Int_t i = 0; i < nHandlers; i++) n += ((AliMixInputHandlerInfo *) fMixTrees.At(i))->GetBytesRead();
+   return n;
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::PrepareMixEntry(Int_t position, Long64_t entryMix, TChainElement *te, Long64_t entryInTree, Int_t firstFree)
+{
+   //
+   // Loads chain entry entryMix (entryInTree in tree te) in mixing input handler at position.
+   // With event cache input handler which still holds entryMix (searched at position
+   // and from firstFree on) is moved to position without reading. Otherwise least
+   // recently used input handler is finished and reused.
+   //
+   fMixRequests++;
+   Int_t nHandlers = fMixCachedEntry.size();
+   if (fMixEventCacheSize > 0 && position < nHandlers) {
+      Int_t hit = (fMixCachedEntry[position] == entryMix) ? position : -1;
+      Int_t lru = position;
+      for (Int_t i = TMath::Max(position + 1, firstFree); hit < 0 && i < nHandlers; i++) {
+         if (fMixCachedEntry[i] == entryMix) hit = i;
+         else if (fMixCacheStamp[i] < fMixCacheStamp[lru]) lru = i;
+      }
+      if (hit >= 0) {
+         SwapMixHandlers(position, hit);
+         fMixCacheStamp[position] = fEntryCounter;
+         fMixCacheHits++;
+         AliDebug(AliLog::kDebug + 1, Form("Mixed entry %lld found in cache (handler %d -> %d)", entryMix, hit, position));
+         return;
+      }
+      SwapMixHandlers(position, lru);
+      if (fMixCachedEntry[position] >= 0) InputEventHandler(position)->FinishEvent();
+      fMixCachedEntry[position] = entryMix;
+      fMixCacheStamp[position] = fEntryCounter;
+   }
+   AliMixInputHandlerInfo *mihi = (AliMixInputHandlerInfo *) fMixTrees.At(position);
+   mihi->PrepareEntry(te, entryInTree, (AliInputEventHandler *)InputEventHandler(position), fAnalysisType);
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::FinishMixEntry(Int_t position)
+{
+   //
+   // Finishes mixed event at position (postponed to its reuse with event cache)
+   //
+   if (fMixEventCacheSize > 0) return;
+   InputEventHandler(position)->FinishEvent();
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::SwapMixHandlers(Int_t i, Int_t j)
+{
+   //
+   // Swaps mixing input handlers (together with their chains) at positions i and j
+   //
+   if (i == j) return;
+   TObject *ih = fInputHandlers.At(i);
+   fInputHandlers.AddAt(fInputHandlers.At(j), i);
+   fInputHandlers.AddAt(ih, j);
+   TObject *mihi = fMixTrees.At(i);
+   fMixTrees.AddAt(fMixTrees.At(j), i);
+   fMixTrees.AddAt(mihi, j);
+   std::swap(fMixCachedEntry[i], fMixCachedEntry[j]);
+   std::swap(fMixCacheStamp[i], fMixCacheStamp[j]);
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::FinishMixEventCache()
+{
+   //
+   // Finishes mixed events still kept in event cache and marks all
+   // mixing input handlers as empty
+   //
+   Int_t nHandlers = TMath::Min((Int_t) fMixCachedEntry.size(), fInputHandlers.GetEntriesFast());
+   for (Int_t i = 0; i < nHandlers; i++) {
+      if (fMixCachedEntry[i] >= 0) InputEventHandler(i)->FinishEvent();
+   }
+   ResetMixEventCache();
+}
+
+//_____________________________________________________________________________
+void AliMixInputEventHandler::ResetMixEventCache()
+{
+   //
+   // Marks all mixing input handlers as empty
+   //
+   Int_t nHandlers = fInputHandlers.GetEntriesFast();
+   fMixCachedEntry.assign(nHandlers, -1);
+   fMixCacheStamp.assign(nHandlers, -1);
+}
@@ -10,6 +10,8 @@
 #ifndef ALIMIXINPUTEVENTHANDLER_H
 #define ALIMIXINPUTEVENTHANDLER_H
 
+#include <vector>
+
 #include <TObjArray.h>
 #include <TEntryList.h>
 #include <TArrayI.h>
@@ -36,6 +38,7 @@ public:
    virtual Bool_t  BeginEvent(Long64_t entry);
    virtual Bool_t  GetEntry();
    virtual Bool_t  FinishEvent();
+   virtual Bool_t  Terminate();
 
    // removing default impementation
    virtual void            AddInputEventHandler(AliVEventHandler */*inHandler*/);
@@ -73,6 +76,17 @@ public:
 
    Bool_t                  GetEntryMainEvent();
    Bool_t                  GetEntryMixedEvent(Int_t idHandler=0);
+
+   // mixed event cache and read-ahead
+   void                    SetMixEventCache(Int_t nEvents);
+   void                    SetMixReadCache(Long64_t cacheSize, Bool_t asyncPrefetch = kTRUE) { fMixReadCacheSize = cacheSize; fMixAsyncPrefetch = asyncPrefetch; }
+   void                    AddMixBranch(const char *name);
+   Int_t                   MixEventCacheSize() const { return fMixEventCacheSize; }
+   Long64_t                MixRequests() const { return fMixRequests; }
+   Long64_t                MixCacheHits() const { return fMixCacheHits; }
+   Long64_t                MixedEventsProcessed() const { return fMixedEventsProcessed; }
+   Long64_t                MixEntriesRead() const;
+   Long64_t                MixBytesRead() const;
 protected:
 
    TObjArray               fMixTrees;              // buffer of input handlers
@@ -100,17 +114,33 @@ private:
    TEntryList fCurrentMixEntry;    //! array of mix entries currently used (user should touch)
    Long64_t fCurrentEntryMainTree; //! current entry in current tree (main event)
 
+   // mixed event cache and read-ahead
+   Int_t    fMixEventCacheSize;    // number of extra input handlers keeping decoded mixed events
+   Long64_t fMixReadCacheSize;     // TTreeCache size for mixing chains (0 = ROOT default)
+   Bool_t   fMixAsyncPrefetch;     // enable asynchronous prefetching in TTreeCache of mixing chains
+   TString  fMixBranches;          // comma separated list of branches read for mixed events ("" = all)
+   std::vector<Long64_t> fMixCachedEntry; //! chain entry held by every mixing input handler (-1 = none)
+   std::vector<Long64_t> fMixCacheStamp;  //! main event counter when input handler was last used
+   Long64_t fMixRequests;          //! number of mixed events requested
+   Long64_t fMixCacheHits;         //! number of mixed events found in cache
+   Long64_t fMixedEventsProcessed; //! number of mixed events passed to tasks
+
    virtual Bool_t          MixStd();
    virtual Bool_t          MixBuffer();
    virtual Bool_t          MixEventsMoreTimesWithOneEvent();
    virtual Bool_t          MixEventsMoreTimesWithBuffer();
 
    void                    UserExecMixAllTasks(Long64_t entryCounter, Int_t idEntryList, Long64_t entryMainReal, Long64_t entryMixReal, Int_t numMixed);
+   void                    PrepareMixEntry(Int_t position, Long64_t entryMix, TChainElement *te, Long64_t entryInTree, Int_t firstFree);
+   void                    FinishMixEntry(Int_t position);
+   void                    SwapMixHandlers(Int_t i, Int_t j);
+   void                    FinishMixEventCache();
+   void                    ResetMixEventCache();
 
    AliMixInputEventHandler(const AliMixInputEventHandler &handler);
    AliMixInputEventHandler &operator=(const AliMixInputEventHandler &handler);
 
-   ClassDef(AliMixInputEventHandler, 5)
+   ClassDef(AliMixInputEventHandler, 6)
 };
 
 #endif
@@ -10,7 +10,10 @@
 #include <TTree.h>
 #include <TChain.h>
 #include <TFile.h>
+#include <TTreeCache.h>
 #include <TChainElement.h>
+#include <TObjArray.h>
+#include <TObjString.h>
 
 #include "AliLog.h"
 #include "AliInputEventHandler.h"
@@ -24,7 +27,13 @@ AliMixInputHandlerInfo::AliMixInputHandlerInfo(const char *name, const char *tit
    fChain(0),
    fChainEntriesArray(),
    fZeroEntryNumber(0),
-   fNeedNotify(kFALSE)
+   fNeedNotify(kFALSE),
+   fCacheSize(0),
+   fBranches(),
+   fAsyncPrefetch(kFALSE),
+   fNEntriesRead(0),
+   fBytesRead(0),
+   fNFilesOpened(0)
 {
    //
    // Default constructor.
@@ -127,13 +136,7 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
    }
    if (entry < 0) {
       AliDebug(AliLog::kDebug, Form("We are creating new chain from file %s ...", te->GetTitle()));
-      if (!fChain) {
-         fChain = new TChain(te->GetName());
-         fChain->AddFile(te->GetTitle());
-         fChain->GetEntry(0);
-         eh->Init(opt);
-         eh->Init(fChain->GetTree(), opt);
-      }
+      if (!fChain) OpenChain(te, eh, opt);
       fNeedNotify = kTRUE;
       AliDebug(AliLog::kDebug + 5, "->");
       return;
@@ -145,14 +148,9 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
          AliDebug(AliLog::kDebug, Form("Filename %s is NOT same ...", te->GetTitle()));
          AliDebug(AliLog::kDebug, Form("We are changing to file %s ...", te->GetTitle()));
          // change file
-         delete fChain;
-         fChain = new TChain(te->GetName());
-         fChain->AddFile(te->GetTitle());
-         fChain->GetEntry(0);
-         eh->Init(opt);
-         eh->Init(fChain->GetTree(), opt);
+         OpenChain(te, eh, opt);
          eh->Notify(te->GetTitle());
-         fChain->GetEntry(entry);
+         ReadEntry(entry);
          eh->BeginEvent(entry);
          fNeedNotify = kFALSE;
       } else {
@@ -160,7 +158,7 @@ void AliMixInputHandlerInfo::PrepareEntry(TChainElement *te, Long64_t entry, Ali
          if (fNeedNotify) eh->Notify(te->GetTitle());
          fNeedNotify = kFALSE;
          AliDebug(AliLog::kDebug, Form("Entry is %lld  fChain->GetEntries %lld ...", entry, fChain->GetEntries()));
-         fChain->GetEntry(entry);
+         ReadEntry(entry);
          eh->BeginEvent(entry);
          // file is in tree fChain already
       }
@@ -180,3 +178,69 @@ Long64_t AliMixInputHandlerInfo::GetEntries()
    if (fChain) return fChain->GetEntries();
    return -1;
 }
+
+//_____________________________________________________________________________
+void AliMixInputHandlerInfo::SetReadCache(Long64_t cacheSize, const char *branches, Bool_t asyncPrefetch)
+{
+   //
+   // Sets size of TTreeCache and list of branches (comma separated) which
+   // are read for mixed events. With asyncPrefetch TTreeCache of this chain
+   // reads ahead in background (other files in process are not affected).
+   // Applied when chain is opened on next file.
+   //
+   fCacheSize = cacheSize;
+   fBranches = branches;
+   fAsyncPrefetch = asyncPrefetch;
+}
+
+//_____________________________________________________________________________
+void AliMixInputHandlerInfo::OpenChain(TChainElement *te, AliInputEventHandler *eh, Option_t *opt)
+{
+   //
+   // Creates chain with file from te and connects input handler to it
+   //
+   if (fChain) delete fChain;
+   fChain = new TChain(te->GetName());
+   fChain->AddFile(te->GetTitle());
+   fChain->GetEntry(0);
+   eh->Init(opt);
+   eh->Init(fChain->GetTree(), opt);
+   fNFilesOpened++;
+
+   // branch selection and cache are set after input handler connected its branches
+   TObjArray *branches = 0;
+   if (!fBranches.IsNull()) {
+      branches = fBranches.Tokenize(",");
+      fChain->SetBranchStatus("*", 0);
+      for (Int_t i = 0; i < branches->GetEntriesFast(); i++) {
+         fChain->SetBranchStatus(((TObjString *) branches->At(i))->GetString().Data(), 1);
+      }
+   }
+   if (fCacheSize > 0) {
+      fChain->SetCacheSize(fCacheSize);
+      if (branches) {
+         for (Int_t i = 0; i < branches->GetEntriesFast(); i++) {
+            fChain->AddBranchToCache(((TObjString *) branches->At(i))->GetString().Data(), kTRUE);
+         }
+      } else {
+         fChain->AddBranchToCache("*", kTRUE);
+      }
+      if (fAsyncPrefetch && fChain->GetTree()) {
+         TTreeCache *cache = fChain->GetTree()->GetReadCache(fChain->GetCurrentFile());
+         if (cache) cache->SetEnablePrefetching(kTRUE);
+      }
+   }
+   delete branches;
+   AliDebug(AliLog::kDebug, Form("Chain opened on file %s (cache=%lld async=%d branches='%s')", te->GetTitle(), fCacheSize, fAsyncPrefetch, fBranches.Data()));
+}
+
+//_____________________________________________________________________________
+void AliMixInputHandlerInfo::ReadEntry(Long64_t entry)
+{
+   //
+   // Reads entry from chain and updates read statistics
+   //
+   Int_t nBytes = fChain->GetEntry(entry);
+   fNEntriesRead++;
+   if (nBytes > 0) fBytesRead += nBytes;
+}
@@ -33,16 +33,30 @@ public:
    TChainElement *GetEntryInTree(Long64_t &entry);
    Long64_t      GetEntries();
 
+   void SetReadCache(Long64_t cacheSize, const char *branches = "", Bool_t asyncPrefetch = kFALSE);
+   Long64_t GetNEntriesRead() const { return fNEntriesRead; }
+   Long64_t GetBytesRead() const { return fBytesRead; }
+   Long64_t GetNFilesOpened() const { return fNFilesOpened; }
+
 private:
    TChain    *fChain;              // current chain
    TArrayI   fChainEntriesArray;   // array of entries of every chaing
    Long64_t  fZeroEntryNumber;     // zero entry number (will be used when we will delete not needed chains)
    Bool_t    fNeedNotify;          // flag if Notify is needed for current input handler
+   Long64_t  fCacheSize;           // size of TTreeCache for chain (0 = ROOT default)
+   TString   fBranches;            // comma separated list of branches to read ("" = all)
+   Bool_t    fAsyncPrefetch;       // enable asynchronous prefetching in TTreeCache
+   Long64_t  fNEntriesRead;        //! number of entries read from chain
+   Long64_t  fBytesRead;           //! number of (uncompressed) bytes read from chain
+   Long64_t  fNFilesOpened;        //! number of times chain was opened on new file
+
+   void      OpenChain(TChainElement *te, AliInputEventHandler *eh, Option_t *opt);
+   void      ReadEntry(Long64_t entry);
 
    AliMixInputHandlerInfo(const AliMixInputHandlerInfo &handler);
    AliMixInputHandlerInfo &operator=(const AliMixInputHandlerInfo &handler);
 
-   ClassDef(AliMixInputHandlerInfo, 1); // Mix Input Handler info
+   ClassDef(AliMixInputHandlerInfo, 2); // Mix Input Handler info
 };
 
 #endif // ALIMIXINPUTHANDLERINFO_H
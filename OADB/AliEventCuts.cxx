@@ -38,6 +38,11 @@ using std::vector;
 ClassImp(AliEventCutsContainer);
 ClassImp(AliEventCuts);
 
+namespace {
+  /// Functional form of the FB32 vs V0M correlation cut, evaluated by AliEventCuts::EvalMultiplicityV0McorrCut
+  const char* kMultV0McorrFormula = "[0]+[1]*x+[2]*exp([3]-[4]*x) - 5.*([5]+[6]*exp([7]-[8]*x))";
+}
+
 
 
 /// Standard constructor with null selection
@@ -124,7 +129,8 @@ AliEventCuts::AliEventCuts(bool saveplots) : TList(),
   fTPCvsTrkl{nullptr},
   fVZEROvsTPCout{nullptr},
   fFB32trackCuts{nullptr},
-  fTPConlyCuts{nullptr}
+  fTPConlyCuts{nullptr},
+  fMultV0McorrClosedForm{false}
 {
   SetName("AliEventCuts");
   SetOwner(true);
@@ -150,6 +156,7 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
     if (fUseTimeRangeCut) {
       fTimeRangeCut.InitFromRunNumber(fCurrentRun);
     }
+    CompileCutKernels();
   }
 
   if (fSavePlots && !this->Last()) {
@@ -176,17 +183,21 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
   /// Use of trigger classes overrides the trigger mask
   /// (i.e. if trigger mask is not fired but we see the trigger class we want we enable the trigger bit)
   /// A special bit is set in this case
-  TString classes = ev->GetFiredTriggerClasses();
   if (fTriggerClasses.empty())
     fFlag |= BIT(kTriggerClasses);
-  for (const std::string& myClass : fTriggerClasses) {
-    if (classes.Contains(myClass.data()) && !myClass.empty()) {
-      fFlag |= BIT(kTrigger);
-      fFlag |= BIT(kTriggerClasses);
-      break;
+  else {
+    TString classes = ev->GetFiredTriggerClasses();
+    for (const std::string& myClass : fTriggerClasses) {
+      if (classes.Contains(myClass.data()) && !myClass.empty()) {
+        fFlag |= BIT(kTrigger);
+        fFlag |= BIT(kTriggerClasses);
+        break;
+      }
     }
   }
 
+  AliAODEvent* aodEvent = dynamic_cast<AliAODEvent*>(ev);
+
   /// Vertex existance
   const AliVVertex* vtTrc = ev->GetPrimaryVertex();
   bool isTrackV = true;
@@ -194,7 +205,7 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
   const AliVVertex* vtSPD = ev->GetPrimaryVertexSPD();
   /// On current AODs primary vertex could be from TPC or invalid SPD vertex
   /// The following check should be applied only on AOD.
-  bool goodAODvtx = (dynamic_cast<AliAODEvent*>(ev) ? GoodPrimaryAODVertex(ev) : true) || !fCheckAODvertex;
+  bool goodAODvtx = (aodEvent ? GoodPrimaryAODVertex(ev) : true) || !fCheckAODvertex;
 
   if (vtSPD->GetNContributors() > 0) fFlag |= BIT(kVertexSPD);
   if (vtTrc->GetNContributors() > 1 && isTrackV && goodAODvtx) fFlag |= BIT(kVertexTracks);
@@ -246,7 +257,7 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
   int nCluSDDSSD=0;
   for(Int_t iLay=2; iLay<6; iLay++) nCluSDDSSD+=mult->GetNumberOfITSClusters(iLay);
   int nCluTPC=0;
-  if (dynamic_cast<AliAODEvent*>(ev)) nCluTPC=dynamic_cast<AliAODEvent*>(ev)->GetNumberOfTPCClusters();
+  if (aodEvent) nCluTPC=aodEvent->GetNumberOfTPCClusters();
   else if (dynamic_cast<AliESDEvent*>(ev)) nCluTPC=dynamic_cast<AliESDEvent*>(ev)->GetNumberOfTPCClusters();
   if(fUseVariablesCorrelationCuts || fTOFvsFB32[0] || fUseStrongVarCorrelationCut ||
      fUseTPCTracklCorrelationCut) ComputeTrackMultiplicity(ev);
@@ -307,7 +318,7 @@ bool AliEventCuts::AcceptEvent(AliVEvent *ev) {
     const double mu32tof = PolN(fb32,fTOFvsFB32correlationPars,3);
     const double sigma32tof = PolN(fb32,fTOFvsFB32sigmaPars, 5);
 
-    const bool multV0Mcut = (fMultiplicityV0McorrCut) ? fb32acc > fMultiplicityV0McorrCut->Eval(fCentPercentiles[0]) : true;
+    const bool multV0Mcut = (fMultiplicityV0McorrCut) ? fb32acc > EvalMultiplicityV0McorrCut(fCentPercentiles[0]) : true;
 
     if (((fb32tof <= mu32tof + fTOFvsFB32nSigmaCut[0] * sigma32tof && fb32tof >= mu32tof - fTOFvsFB32nSigmaCut[1] * sigma32tof) &&
         (esd < fESDvsTPConlyLinearCut[0] + fESDvsTPConlyLinearCut[1] * fb128) &&
@@ -601,6 +612,27 @@ string AliEventCuts::GetCentralityEstimator (unsigned int estimator) const {
 }
 
 
+void AliEventCuts::CompileCutKernels() {
+  /// The cut functions with a known functional form are evaluated in closed form
+  /// for every event. The form is recognised from the expanded formula of the TF1,
+  /// compared with the one of a reference function built from the same expression.
+  fMultV0McorrClosedForm = false;
+  if (fMultiplicityV0McorrCut) {
+    TF1 reference("AliEventCuts_MultV0McorrReference",kMultV0McorrFormula,0,100);
+    fMultV0McorrClosedForm = fMultiplicityV0McorrCut->GetNpar() == reference.GetNpar() &&
+      fMultiplicityV0McorrCut->GetExpFormula() == reference.GetExpFormula();
+  }
+}
+
+double AliEventCuts::EvalMultiplicityV0McorrCut(double x) const {
+  /// Same operations as the TF1 built from kMultV0McorrFormula, with the current
+  /// parameters of the cut function. Other functional forms are evaluated through the TF1.
+  if (!fMultV0McorrClosedForm)
+    return fMultiplicityV0McorrCut->Eval(x);
+  const double* p = fMultiplicityV0McorrCut->GetParameters();
+  return p[0] + p[1] * x + p[2] * std::exp(p[3] - p[4] * x) - 5. * (p[5] + p[6] * std::exp(p[7] - p[8] * x));
+}
+
 void AliEventCuts::ComputeTrackMultiplicity(AliVEvent *ev) {
   AliEventCutsContainer* tmp_cont = static_cast<AliEventCutsContainer*>(ev->FindListObject("AliEventCutsContainer"));
   if (tmp_cont) {
@@ -833,7 +865,7 @@ void AliEventCuts::SetupPbPb2018() {
   std::copy(its_tpcclus_polcut.begin(),its_tpcclus_polcut.end(),fITSvsTPCcluPolCut);
   
   if (fCentralityFramework != 0) {
-    if(!fMultiplicityV0McorrCut) fMultiplicityV0McorrCut = new TF1("fMultiplicityV0McorrCut","[0]+[1]*x+[2]*exp([3]-[4]*x) - 5.*([5]+[6]*exp([7]-[8]*x))",0,100);
+    if(!fMultiplicityV0McorrCut) fMultiplicityV0McorrCut = new TF1("fMultiplicityV0McorrCut",kMultV0McorrFormula,0,100);
     fMultiplicityV0McorrCut->SetParameters(-6.15980e+02, 4.89828e+00, 4.84776e+03, -5.22988e-01, 3.04363e-02, -1.21144e+01, 2.95321e+02, -9.20062e-01, 2.17372e-02);
   }
 
@@ -916,7 +948,7 @@ void AliEventCuts::SetupRun2PbPb() {
   }
 
   if (fCentralityFramework != 0) {
-    if(!fMultiplicityV0McorrCut) fMultiplicityV0McorrCut = new TF1("fMultiplicityV0McorrCut","[0]+[1]*x+[2]*exp([3]-[4]*x) - 5.*([5]+[6]*exp([7]-[8]*x))",0,100);
+    if(!fMultiplicityV0McorrCut) fMultiplicityV0McorrCut = new TF1("fMultiplicityV0McorrCut",kMultV0McorrFormula,0,100);
     fMultiplicityV0McorrCut->SetParameters(-6.15980e+02, 4.89828e+00, 4.84776e+03, -5.22988e-01, 3.04363e-02, -1.21144e+01, 2.95321e+02, -9.20062e-01, 2.17372e-02);
   }
   if (!fOverrideAutoTriggerMask) {
@@ -125,6 +125,11 @@ class AliEventCuts : public TList {
     std::string       GetCentralityEstimator (unsigned int estimator = 0) const;
     const AliVVertex* GetPrimaryVertex() const { return fPrimaryVertex; }
 
+    /// Cut functions with a known functional form are evaluated in closed form, recognised
+    /// at each run change (call CompileCutKernels() again after replacing a cut function)
+    void              CompileCutKernels();
+    double            EvalMultiplicityV0McorrCut(double x) const;
+
     void          SetCentralityEstimators (std::string first = "V0M", std::string second = "CL0") { fCentEstimators[0] = first; fCentEstimators[1] = second; }
     void          SetCentralityRange (float min, float max) { fMinCentrality = min; fMaxCentrality = max; }
     void          SetMaxVertexZposition (float max) { fMinVtz = -fabs(max); fMaxVtz = fabs(max); }
@@ -245,6 +250,8 @@ class AliEventCuts : public TList {
     AliESDtrackCuts* fFB32trackCuts; //!<! Cuts corresponding to FB32 in the ESD (used only for correlations cuts in ESDs)
     AliESDtrackCuts* fTPConlyCuts;   //!<! Cuts corresponding to the standalone TPC cuts in the ESDs (used only for correlations cuts in ESDs)
 
+    bool fMultV0McorrClosedForm;     //!<! fMultiplicityV0McorrCut has the standard functional form and is evaluated in closed form
+
     ClassDef(AliEventCuts, 16)
 };
 
@@ -18,6 +18,7 @@
 #include <TFile.h>
 #include <TGeoManager.h>
 #include <TStreamerInfo.h>
+#include <algorithm>
 
 // ---- ANALYSIS system ----
 #include "AliMCEvent.h"
@@ -180,8 +181,12 @@ fhPtHardEnClusterRatio(0),   fhPtHardEnClusterCenRatio(0),
 fEnergyHistogramNbins(0),    fHistoCentDependent(0),          fHistoPtDependent(0),
 fhNEventsAfterCut(0),        fNMCGenerToAccept(0),            fMCGenerEventHeaderToAccept(""),
 fGenEventHeader(0),          fGenPythiaEventHeader(0),        fCheckPythiaEventHeader(1),
-fAcceptMCPromptPhotonOnly(0),fRejectMCFragmentationPhoton(0)
+fAcceptMCPromptPhotonOnly(0),fRejectMCFragmentationPhoton(0),
+fUseEtaPhiIndex(kFALSE),     fEtaPhiIndexNEta(20),            fEtaPhiIndexNPhi(64),
+fEtaPhiIndexEtaMax(1.),      fEtaPhiIndexCellStart(),         fEtaPhiIndexObjects(),
+fEtaPhiIndexObjectCell(),    fEtaPhiIndexQueryCells()
 {
+  for(Int_t i = 0; i < 3; i++) fEtaPhiIndexFilled    [i]= kFALSE ;
   for(Int_t i = 0; i < 9; i++) fhEMCALClusterCutsE   [i]= 0x0 ;
   for(Int_t i = 0; i < 9; i++) fhEMCALClusterCutsECen[i]= 0x0 ;
   for(Int_t i = 0; i < 9; i++) fhEMCALClusterCutsESignal   [i]= 0x0 ;
@@ -2555,6 +2560,168 @@ void AliCaloTrackReader::FillInputCTS()
                   fCTSTracks->GetEntriesFast(), nTracks, fTrackMult[0]));
 }
 
+//_____________________________________________________________________
+/// \return cell of the (eta,phi) index. Objects out of the eta range
+/// are assigned to the edge cells, phi is taken modulo 2 pi.
+//_____________________________________________________________________
+Int_t AliCaloTrackReader::GetEtaPhiIndexCell(Float_t eta, Float_t phi) const
+{
+  Int_t ieta = Int_t(TMath::Floor((eta+fEtaPhiIndexEtaMax)/(2*fEtaPhiIndexEtaMax)*fEtaPhiIndexNEta));
+  if ( ieta < 0                 ) ieta = 0;
+  if ( ieta >= fEtaPhiIndexNEta ) ieta = fEtaPhiIndexNEta-1;
+
+  phi -= TMath::TwoPi()*TMath::Floor(phi/TMath::TwoPi());
+  Int_t iphi = Int_t(phi/TMath::TwoPi()*fEtaPhiIndexNPhi);
+  if ( iphi < 0                 ) iphi = 0;
+  if ( iphi >= fEtaPhiIndexNPhi ) iphi = fEtaPhiIndexNPhi-1;
+
+  return ieta*fEtaPhiIndexNPhi + iphi;
+}
+
+//_____________________________________________________________________
+/// Fill the (eta,phi) cell index of the selected tracks or clusters:
+/// counting sort of the positions in the detector array by cell,
+/// keeping the array order inside each cell.
+/// Clusters direction is calculated with respect to the main vertex.
+///
+/// \param det: AliFiducialCut::kCTS, kEMCAL or kPHOS.
+//_____________________________________________________________________
+void AliCaloTrackReader::FillEtaPhiIndex(Int_t det)
+{
+  TObjArray * list = 0x0;
+  if      ( det == AliFiducialCut::kCTS   ) list = fCTSTracks;
+  else if ( det == AliFiducialCut::kEMCAL ) list = fEMCALClusters;
+  else if ( det == AliFiducialCut::kPHOS  ) list = fPHOSClusters;
+
+  Int_t nCells = fEtaPhiIndexNEta*fEtaPhiIndexNPhi;
+  Int_t nObj   = list ? list->GetEntriesFast() : 0;
+
+  std::vector<Int_t> & cellStart = fEtaPhiIndexCellStart[det];
+  std::vector<Int_t> & objects   = fEtaPhiIndexObjects  [det];
+
+  cellStart.assign(nCells+1, 0);
+  objects.resize(nObj);
+  fEtaPhiIndexObjectCell.resize(nObj);
+
+  for(Int_t iobj = 0; iobj < nObj; iobj++)
+  {
+    Float_t eta = 0, phi = 0;
+
+    if ( det == AliFiducialCut::kCTS )
+    {
+      AliVTrack * track = dynamic_cast<AliVTrack*>(list->At(iobj));
+      if ( track )
+      {
+        eta = track->Eta();
+        phi = track->Phi();
+      }
+    }
+    else
+    {
+      AliVCluster * calo = dynamic_cast<AliVCluster*>(list->At(iobj));
+      if ( calo )
+      {
+        calo->GetMomentum(fMomentum, fVertex[0]);
+        eta = fMomentum.Eta();
+        phi = fMomentum.Phi();
+      }
+    }
+
+    Int_t cell = GetEtaPhiIndexCell(eta, phi);
+    fEtaPhiIndexObjectCell[iobj] = cell;
+    cellStart[cell+1]++;
+  }
+
+  for(Int_t icell = 0; icell < nCells; icell++)
+    cellStart[icell+1] += cellStart[icell];
+
+  // Place the objects, use the query cells vector as fill counter per cell
+  fEtaPhiIndexQueryCells.assign(cellStart.begin(), cellStart.end()-1);
+  for(Int_t iobj = 0; iobj < nObj; iobj++)
+    objects[fEtaPhiIndexQueryCells[fEtaPhiIndexObjectCell[iobj]]++] = iobj;
+
+  fEtaPhiIndexFilled[det] = kTRUE;
+}
+
+//_____________________________________________________________________
+/// Get the positions in the detector array of the tracks or clusters
+/// in the (eta,phi) cells overlapping any of the requested windows.
+/// The index is filled on the first request in the event.
+/// The selection is coarse, at the cell level: the caller still has to check
+/// the exact distance, but can skip all the objects in non overlapping cells.
+///
+/// \param det: AliFiducialCut::kCTS, kEMCAL or kPHOS.
+/// \param nWindows: number of (eta,phi) windows.
+/// \param etaMin: minimum eta of each window.
+/// \param etaMax: maximum eta of each window.
+/// \param phiMin: minimum phi of each window, can be negative or above 2 pi.
+/// \param phiMax: maximum phi of each window, can be negative or above 2 pi.
+/// \param objects: filled with the array positions, in increasing order.
+/// \return kFALSE if the index is not available and the full array must be looped.
+//_____________________________________________________________________
+Bool_t AliCaloTrackReader::GetEtaPhiIndexedObjects(Int_t det, Int_t nWindows,
+                                                   const Float_t * etaMin, const Float_t * etaMax,
+                                                   const Float_t * phiMin, const Float_t * phiMax,
+                                                   std::vector<Int_t> & objects)
+{
+  objects.clear();
+
+  // Mixed events have one vertex per event, clusters direction not unique
+  if ( !fUseEtaPhiIndex || fMixedEvent ) return kFALSE;
+
+  if ( det != AliFiducialCut::kCTS && det != AliFiducialCut::kEMCAL && det != AliFiducialCut::kPHOS ) return kFALSE;
+
+  if ( fEtaPhiIndexNEta <= 0 || fEtaPhiIndexNPhi <= 0 || fEtaPhiIndexEtaMax <= 0 ) return kFALSE;
+
+  if ( !fEtaPhiIndexFilled[det] ) FillEtaPhiIndex(det);
+
+  Float_t etaCellSize = 2*fEtaPhiIndexEtaMax/fEtaPhiIndexNEta;
+  Float_t phiCellSize = TMath::TwoPi()/fEtaPhiIndexNPhi;
+
+  fEtaPhiIndexQueryCells.clear();
+
+  for(Int_t iwin = 0; iwin < nWindows; iwin++)
+  {
+    Int_t ietaMin = Int_t(TMath::Floor((etaMin[iwin]+fEtaPhiIndexEtaMax)/etaCellSize));
+    Int_t ietaMax = Int_t(TMath::Floor((etaMax[iwin]+fEtaPhiIndexEtaMax)/etaCellSize));
+
+    ietaMin = TMath::Max(0, TMath::Min(ietaMin, fEtaPhiIndexNEta-1));
+    ietaMax = TMath::Max(0, TMath::Min(ietaMax, fEtaPhiIndexNEta-1));
+
+    Int_t iphiMin   = Int_t(TMath::Floor(phiMin[iwin]/phiCellSize));
+    Int_t iphiMax   = Int_t(TMath::Floor(phiMax[iwin]/phiCellSize));
+    Int_t nPhiCells = TMath::Min(iphiMax-iphiMin+1, fEtaPhiIndexNPhi);
+
+    for(Int_t ieta = ietaMin; ieta <= ietaMax; ieta++)
+    {
+      for(Int_t jphi = 0; jphi < nPhiCells; jphi++)
+      {
+        Int_t iphi = ((iphiMin+jphi) % fEtaPhiIndexNPhi + fEtaPhiIndexNPhi) % fEtaPhiIndexNPhi;
+        fEtaPhiIndexQueryCells.push_back(ieta*fEtaPhiIndexNPhi + iphi);
+      }
+    }
+  }
+
+  // Windows can overlap, count each cell once
+  std::sort(fEtaPhiIndexQueryCells.begin(), fEtaPhiIndexQueryCells.end());
+  fEtaPhiIndexQueryCells.erase(std::unique(fEtaPhiIndexQueryCells.begin(), fEtaPhiIndexQueryCells.end()),
+                               fEtaPhiIndexQueryCells.end());
+
+  const std::vector<Int_t> & cellStart = fEtaPhiIndexCellStart[det];
+  const std::vector<Int_t> & indexed   = fEtaPhiIndexObjects  [det];
+
+  for(UInt_t icell = 0; icell < fEtaPhiIndexQueryCells.size(); icell++)
+  {
+    Int_t cell = fEtaPhiIndexQueryCells[icell];
+    objects.insert(objects.end(), indexed.begin()+cellStart[cell], indexed.begin()+cellStart[cell+1]);
+  }
+
+  // Same order as the detector array, sums in cone do not change
+  std::sort(objects.begin(), objects.end());
+
+  return kTRUE;
+}
+
 //_______________________________________________________________________________
 /// Select the tracks based on kinematic cuts, DCA, 
 /// re-fit status and timing cuts are applied. 
@@ -4480,6 +4647,8 @@ void AliCaloTrackReader::ResetLists()
   if(fEMCALClusters)   fEMCALClusters -> Clear("C");
   if(fPHOSClusters)    fPHOSClusters  -> Clear("C");
   
+  for(Int_t i = 0; i < 3; i++) fEtaPhiIndexFilled[i] = kFALSE;
+  
   fV0ADC[0] = 0;   fV0ADC[1] = 0;
   fV0Mul[0] = 0;   fV0Mul[1] = 0;
   
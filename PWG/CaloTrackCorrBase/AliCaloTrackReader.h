@@ -31,6 +31,7 @@ class TTree ;
 class TArrayI ;
 class TObjString;
 #include <TRandom3.h>
+#include <vector>
 
 //--- ANALYSIS system ---
 #include "AliVEvent.h"
@@ -333,6 +334,9 @@ public:
   virtual void     FillInputPHOSCells() ;
   virtual void     FillInputVZERO() ;  
   
+  void             FillEtaPhiIndex(Int_t det) ;
+  Int_t            GetEtaPhiIndexCell(Float_t eta, Float_t phi) const ;
+  
   Int_t            GetV0Signal(Int_t i)              const { return fV0ADC[i]               ; }
   Int_t            GetV0Multiplicity(Int_t i)        const { return fV0Mul[i]               ; }
   
@@ -351,6 +355,22 @@ public:
   virtual AliVCaloCells* GetEMCALCells()             const { return fEMCALCells             ; }
   virtual AliVCaloCells* GetPHOSCells()              const { return fPHOSCells              ; }
   
+  // (eta,phi) cell index of the selected tracks and clusters, filled once per event
+  // on first request, to restrict cone and band searches to the overlapping cells. Off by default
+  
+  void             SwitchOnEtaPhiIndex()                   { fUseEtaPhiIndex = kTRUE  ; }
+  void             SwitchOffEtaPhiIndex()                  { fUseEtaPhiIndex = kFALSE ; }
+  Bool_t           IsEtaPhiIndexOn()                 const { return fUseEtaPhiIndex   ; }
+  
+  void             SetEtaPhiIndexBinning(Int_t nEta, Int_t nPhi, Float_t etaMax)
+                                                           { fEtaPhiIndexNEta   = nEta ; fEtaPhiIndexNPhi = nPhi ;
+                                                             fEtaPhiIndexEtaMax = etaMax ; }
+  
+  Bool_t           GetEtaPhiIndexedObjects(Int_t det, Int_t nWindows,
+                                           const Float_t * etaMin, const Float_t * etaMax,
+                                           const Float_t * phiMin, const Float_t * phiMax,
+                                           std::vector<Int_t> & objects) ;
+  
   //-------------------------------------
   // Event/track selection methods
   //-------------------------------------
@@ -1242,6 +1262,17 @@ public:
   Bool_t           fAcceptMCPromptPhotonOnly ;     ///< Accept in the analysis task (AliiAnaPhoton) only cluster from prompt photons, to be used in gamma-jet simulations
   Bool_t           fRejectMCFragmentationPhoton ;  ///< Reject in the analysis task (AliAnaPhoton) clusters from fragmentation photons, to be used in jet-jet simulations
 
+  // (eta,phi) cell index of CTS tracks, EMCal and PHOS clusters, indexed with AliFiducialCut::detector
+  Bool_t              fUseEtaPhiIndex;             ///<  Use the (eta,phi) cell index in cone and UE band searches.
+  Int_t               fEtaPhiIndexNEta;            ///<  Number of eta cells of the index.
+  Int_t               fEtaPhiIndexNPhi;            ///<  Number of phi cells of the index, over 2 pi.
+  Float_t             fEtaPhiIndexEtaMax;          ///<  Index covers |eta| < fEtaPhiIndexEtaMax, objects beyond go to the edge cells.
+  Bool_t              fEtaPhiIndexFilled[3];       //!<! Index of EMCal, PHOS, CTS filled in this event.
+  std::vector<Int_t>  fEtaPhiIndexCellStart[3];    //!<! Position of the first object of each cell in fEtaPhiIndexObjects, plus end.
+  std::vector<Int_t>  fEtaPhiIndexObjects[3];      //!<! Position in the detector array of the objects, grouped by cell.
+  std::vector<Int_t>  fEtaPhiIndexObjectCell;      //!<! Temporary cell of each object while filling.
+  std::vector<Int_t>  fEtaPhiIndexQueryCells;      //!<! Temporary list of cells of a query.
+
   /// Copy constructor not implemented.
   AliCaloTrackReader(              const AliCaloTrackReader & r) ; 
   
@@ -1249,7 +1280,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,95) ;
+  ClassDef(AliCaloTrackReader,96) ;
   /// \endcond
 
 } ;
@@ -54,6 +54,7 @@ fSumPtThreshold(0.), fSumPtThresholdMax(10000.),    fSumPtThresholdGap(0.),
 fPtFraction(0.),     fICMethod(0),                  fPartInCone(0),
 fFracIsThresh(1),    fIsTMClusterInConeRejected(1), fDistMinToTrigger(-1.),
 fDebug(0),           fMomentum(),                   fTrackVector(),
+fIndexedObjects(),
 fEMCEtaSize(-1),     fEMCPhiMin(-1),                fEMCPhiMax(-1),
 fTPCEtaSize(-1),     fTPCPhiSize(-1),
 // Histograms
@@ -215,11 +216,21 @@ void AliIsolationCut::CalculateCaloSignalInCone
   TObjArray * refclusters  = 0x0;
   Int_t       nclusterrefs = 0;
   
+  // Loop only the clusters in the reader (eta,phi) cells overlapping the cone
+  // and UE regions, unless the eta-phi distribution of all clusters is filled
+  Bool_t useIndex = kFALSE;
+  if ( !bgCls && !useRefs && !(fFillHistograms && fFillEtaPhiHistograms) )
+    useIndex = GetIndexedObjectsInConeAndUE(reader, calorimeter, etaC, phiC);
+  
+  Int_t nClusters = useIndex ? fIndexedObjects.size() : plNe->GetEntries();
+  
   // Get the clusters
   //
   //printf("Loop calo\n");
-  for(Int_t ipr = 0;ipr < plNe->GetEntries() ; ipr ++ )
+  for(Int_t icl = 0; icl < nClusters; icl++ )
   {
+    Int_t ipr = useIndex ? fIndexedObjects[icl] : icl;
+    
     AliVCluster * calo = dynamic_cast<AliVCluster *>(plNe->At(ipr)) ;
     
     if ( calo )
@@ -612,13 +623,23 @@ void AliIsolationCut::CalculateTrackSignalInCone
   
   TObjArray * reftracks  = 0x0;
   Int_t       ntrackrefs = 0;
+  
+  // Loop only the tracks in the reader (eta,phi) cells overlapping the cone
+  // and UE regions, unless the eta-phi distribution of all tracks is filled
+  Bool_t useIndex = kFALSE;
+  if ( !bgTrk && !useRefs && !(fFillHistograms && fFillEtaPhiHistograms) )
+    useIndex = GetIndexedObjectsInConeAndUE(reader, AliFiducialCut::kCTS, etaTrig, phiTrig);
+  
+  Int_t nTracks = useIndex ? fIndexedObjects.size() : plCTS->GetEntries();
     
   //-----------------------------------------------------------
   // Get the tracks in cone
   //
   //-----------------------------------------------------------
-  for(Int_t ipr = 0;ipr < plCTS->GetEntries() ; ipr ++ )
+  for(Int_t itr = 0; itr < nTracks; itr++ )
   {
+    Int_t ipr = useIndex ? fIndexedObjects[itr] : itr;
+    
     AliVTrack* track = dynamic_cast<AliVTrack*>(plCTS->At(ipr)) ;
     
     if(track)
@@ -960,6 +981,68 @@ void AliIsolationCut::CalculateTrackSignalInCone
   if ( bFillAOD && reftracks ) pCandidate->AddObjArray(reftracks);  
 }
 
+//_________________________________________________________________________________________________________________________________
+/// Get from the reader (eta,phi) index the tracks or clusters that can contribute
+/// to the cone sum or the UE estimation: the cells overlapping the cone, the
+/// perpendicular cones for kSumBkgSubIC and the eta and phi bands for the band methods.
+/// The result is stored in fIndexedObjects, positions in the reader detector array.
+///
+/// \param reader: pointer to AliCaloTrackReader.
+/// \param det: AliFiducialCut::kCTS, kEMCAL or kPHOS.
+/// \param etaC: candidate pseudorapidity.
+/// \param phiC: candidate azimuthal angle.
+/// \return kFALSE if the index is not available, loop all the objects.
+//_________________________________________________________________________________________________________________________________
+Bool_t AliIsolationCut::GetIndexedObjectsInConeAndUE(AliCaloTrackReader * reader, Int_t det,
+                                                     Float_t etaC, Float_t phiC)
+{
+  // Widen a bit the windows to not depend on rounding at the cell edges,
+  // the exact selection is done in the loops.
+  const Float_t margin = 0.01;
+  
+  Float_t etaMin[4], etaMax[4], phiMin[4], phiMax[4];
+  Int_t   nWindows = 0;
+  
+  // Cone
+  Float_t rCone = fConeSize + margin;
+  etaMin[nWindows] = etaC - rCone; etaMax[nWindows] = etaC + rCone;
+  phiMin[nWindows] = phiC - rCone; phiMax[nWindows] = phiC + rCone;
+  nWindows++;
+  
+  // Perpendicular cones, only tracks
+  if ( fICMethod == kSumBkgSubIC && det == AliFiducialCut::kCTS )
+  {
+    for(Int_t iside = -1; iside <= 1; iside+=2)
+    {
+      etaMin[nWindows] = etaC - rCone; 
+      etaMax[nWindows] = etaC + rCone;
+      phiMin[nWindows] = phiC + iside*TMath::PiOver2() - rCone; 
+      phiMax[nWindows] = phiC + iside*TMath::PiOver2() + rCone;
+      nWindows++;
+    }
+  }
+  
+  // Phi band: eta cone size within 90 degrees; eta band: phi cone size, all eta
+  if ( fICMethod > kSumBkgSubIC )
+  {
+    Float_t rBand = fConeSize + fConeSizeBandGap + margin;
+    
+    etaMin[nWindows] = etaC - rBand; 
+    etaMax[nWindows] = etaC + rBand;
+    phiMin[nWindows] = phiC - TMath::PiOver2() - margin; 
+    phiMax[nWindows] = phiC + TMath::PiOver2() + margin;
+    nWindows++;
+    
+    etaMin[nWindows] = -1000; 
+    etaMax[nWindows] =  1000;
+    phiMin[nWindows] = phiC - rBand; 
+    phiMax[nWindows] = phiC + rBand;
+    nWindows++;
+  }
+  
+  return reader->GetEtaPhiIndexedObjects(det, nWindows, etaMin, etaMax, phiMin, phiMax, fIndexedObjects);
+}
+
 //_________________________________________________________________________________________________________________________________
 /// Get normalization of cluster background band.
 //_________________________________________________________________________________________________________________________________
@@ -24,6 +24,7 @@ class TObjArray ;
 class TList ;
 class TH3F ;
 #include <TLorentzVector.h>
+#include <vector>
 
 // --- ANALYSIS system ---
 class AliCaloTrackParticleCorrelation ;
@@ -103,6 +104,9 @@ class AliIsolationCut : public TObject {
                                         Double_t  histoWeight=1,
                                         Float_t centrality = -1, Int_t cenBin = -1) ;
   
+  Bool_t     GetIndexedObjectsInConeAndUE(AliCaloTrackReader * reader, Int_t det,
+                                          Float_t etaC, Float_t phiC) ;
+  
   // Cone background studies medthods
 
   void       GetDetectorAngleLimits( AliCaloTrackReader * reader, Int_t calorimeter );
@@ -249,6 +253,8 @@ class AliIsolationCut : public TObject {
   TLorentzVector fMomentum;                            //!<! Momentum of cluster, temporal object.
 
   TVector3   fTrackVector;                             //!<! Track moment, temporal object.
+
+  std::vector<Int_t> fIndexedObjects;                  //!<! Positions of tracks or clusters in cells overlapping cone and UE regions, temporal object.
   
   Float_t    fEMCEtaSize;                              ///< Eta size of Calo
   Float_t    fEMCPhiMin;                               ///< Minimim Phi limit of Calo
@@ -423,7 +429,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,20) ;
+  ClassDef(AliIsolationCut,21) ;
   /// \endcond
 
 } ;
@@ -35,6 +35,9 @@
 #include <TH1F.h>
 #include <TRandom3.h>
 #include <TList.h>
+#include <TEnv.h>
+#include <TBranch.h>
+#include <TTree.h>
 
 #include <AliLog.h>
 #include <AliAnalysisManager.h>
@@ -139,6 +142,12 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper() :
   fCentMax(-999),
   fRandomRejectionFactor(1.),
   fRandom(0),
+  fPreselectFromHeaderBranches(false),
+  fPreselectionBranchNames({"header", "vertices", "mcHeader"}),
+  fReadCacheSize(0),
+  fAsyncPrefetching(false),
+  fPreselectionBranches(),
+  fPreselectionTreeNumber(-1),
   fAutoConfigurePtHardBins(false),
   fAutoConfigureBasePath(""),
   fAutoConfigureTrainTypePath(""),
@@ -216,6 +225,12 @@ AliAnalysisTaskEmcalEmbeddingHelper::AliAnalysisTaskEmcalEmbeddingHelper(const c
   fCentMax(-999),
   fRandomRejectionFactor(1.),
   fRandom(0),
+  fPreselectFromHeaderBranches(false),
+  fPreselectionBranchNames({"header", "vertices", "mcHeader"}),
+  fReadCacheSize(0),
+  fAsyncPrefetching(false),
+  fPreselectionBranches(),
+  fPreselectionTreeNumber(-1),
   fAutoConfigurePtHardBins(false),
   fAutoConfigureBasePath("alien:///alice/cern.ch/user/a/alitrain/"),
   fAutoConfigureTrainTypePath("PWGJE/Jets_EMC_PbPb/"),
@@ -336,6 +351,14 @@ void AliAnalysisTaskEmcalEmbeddingHelper::RetrieveTaskPropertiesFromYAMLConfig()
   res = fYAMLConfig.GetProperty("randomFileAccess", fRandomFileAccess, false);
   res = fYAMLConfig.GetProperty("createHisto", fCreateHisto, false);
   res = fYAMLConfig.GetProperty("printTimingInfoInLog", fPrintTimingInfoToLog, false);
+  res = fYAMLConfig.GetProperty("preselectFromHeaderBranches", fPreselectFromHeaderBranches, false);
+  std::vector <std::string> preselectionBranches;
+  res = fYAMLConfig.GetProperty("additionalPreselectionBranches", preselectionBranches, false);
+  if (res) {
+    fPreselectionBranchNames.insert(fPreselectionBranchNames.end(), preselectionBranches.begin(), preselectionBranches.end());
+  }
+  res = fYAMLConfig.GetProperty("readCacheSize", fReadCacheSize, false);
+  res = fYAMLConfig.GetProperty("asyncPrefetching", fAsyncPrefetching, false);
   // More general embedding helper properties
   res = fYAMLConfig.GetProperty("filePattern", fFilePattern, false);
   res = fYAMLConfig.GetProperty("inputFilename", fInputFilename, false);
@@ -930,7 +953,7 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
     // Load current event
     // Can be a simple less than, because fFileNumber counts from 0.
     if (fFileNumber < fMaxNumberOfFiles) {
-      fChain->GetEntry(fCurrentEntry);
+      LoadEmbeddedEntry(fCurrentEntry);
     }
     else {
       AliError("====================================================================================================");
@@ -948,7 +971,7 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
 
       // Access the relevant entry
       // We are certain that fFileNumber is less than fMaxNumberOfFiles, so we are resetting to start
-      fChain->GetEntry(fCurrentEntry);
+      LoadEmbeddedEntry(fCurrentEntry);
     }
     AliDebug(4, TString::Format("Loading entry %i between %i-%i, starting with offset %i from the lower bound of %i", fCurrentEntry, fLowerEntry, fUpperEntry, fOffset, fLowerEntry));
 
@@ -977,9 +1000,68 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::GetNextEntry()
 
   if (!fChain) return kFALSE;
 
+  // Only the preselection branches were read so far. Now that the event is accepted, read the full entry.
+  // NOTE: fCurrentEntry has already been incremented past the accepted entry.
+  if (fPreselectFromHeaderBranches) {
+    fChain->GetEntry(fCurrentEntry - 1);
+    SetEmbeddedEventProperties();
+  }
+
   return kTRUE;
 }
 
+/**
+ * Load an entry of the external event chain for the embedded event selection. If preselection is
+ * enabled, only the preselection branches are read. Otherwise, the full entry is read.
+ *
+ * @param[in] entry Entry in the TChain to load
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::LoadEmbeddedEntry(Long64_t entry)
+{
+  if (fPreselectFromHeaderBranches) {
+    LoadPreselectionBranches(entry);
+  }
+  else {
+    fChain->GetEntry(entry);
+  }
+}
+
+/**
+ * Read only the preselection branches of an entry in the external event chain. The branch
+ * addresses were already set by ReadFromTree(), so the corresponding objects of the external
+ * event are updated in place. The branches are looked up again only when the chain moves to
+ * a new tree.
+ *
+ * @param[in] entry Entry in the TChain to load
+ * @return Number of bytes read
+ */
+Int_t AliAnalysisTaskEmcalEmbeddingHelper::LoadPreselectionBranches(Long64_t entry)
+{
+  Long64_t localEntry = fChain->LoadTree(entry);
+  if (localEntry < 0) return 0;
+
+  if (fChain->GetTreeNumber() != fPreselectionTreeNumber) {
+    fPreselectionBranches.clear();
+    for (const auto & name : fPreselectionBranchNames) {
+      TBranch * branch = fChain->GetTree()->GetBranch(name.c_str());
+      if (branch) {
+        fPreselectionBranches.push_back(branch);
+      }
+      else {
+        AliDebugStream(2) << "Preselection branch \"" << name << "\" not found in the embedded tree.\n";
+      }
+    }
+    fPreselectionTreeNumber = fChain->GetTreeNumber();
+  }
+
+  Int_t nBytes = 0;
+  for (auto branch : fPreselectionBranches) {
+    nBytes += branch->GetEntry(localEntry);
+  }
+
+  return nBytes;
+}
+
 /**
  * Set some properties of the event that are not immediately available from the external event to make them
  * available to user tasks.
@@ -1193,10 +1275,42 @@ Bool_t AliAnalysisTaskEmcalEmbeddingHelper::InitEvent()
   }
 
   fExternalEvent->ReadFromTree(fChain, fTreeName);
+
+  if (fPreselectFromHeaderBranches && fTreeName != "aodTree") {
+    AliWarningStream() << "Preselection from header branches is only available for AODs. Reading full entries instead.\n";
+    fPreselectFromHeaderBranches = false;
+  }
+
+  InitReadCache();
   
   return kTRUE;
 }
 
+/**
+ * Setup the TTreeCache for the external event chain. With preselection, only the preselection branches
+ * are added explicitly, and the remaining branches are learned by the cache from the accepted (fully read)
+ * entries. Must be called before the first file of the chain is opened so that asynchronous prefetching
+ * applies to it.
+ */
+void AliAnalysisTaskEmcalEmbeddingHelper::InitReadCache()
+{
+  if (fReadCacheSize <= 0) return;
+
+  if (fAsyncPrefetching) {
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+  }
+
+  fChain->SetCacheSize(fReadCacheSize);
+  if (fPreselectFromHeaderBranches) {
+    for (const auto & name : fPreselectionBranchNames) {
+      fChain->AddBranchToCache(name.c_str(), kTRUE);
+    }
+  }
+  else {
+    fChain->AddBranchToCache("*", kTRUE);
+  }
+}
+
 /**
  * Performing run-independent initialization to setup embedding.
  *
@@ -2031,6 +2145,16 @@ std::string AliAnalysisTaskEmcalEmbeddingHelper::toString(bool includeFileList)
   tempSS << "Z vertex cut: " << fZVertexCut << "\n";
   tempSS << "Max difference between internal and embedded vertex: " << fMaxVertexDist << "\n";
   tempSS << "Random event rejection factor: " << fRandomRejectionFactor << "\n";
+  tempSS << "Preselect from header branches: " << fPreselectFromHeaderBranches << "\n";
+  if (fPreselectFromHeaderBranches) {
+    tempSS << "Preselection branches:";
+    for (const auto & name : fPreselectionBranchNames) {
+      tempSS << " " << name;
+    }
+    tempSS << "\n";
+  }
+  tempSS << "Read cache size: " << fReadCacheSize << "\n";
+  tempSS << "Async prefetching: " << fAsyncPrefetching << "\n";
 
   if (includeFileList) {
     tempSS << "\nFiles to embed:\n";
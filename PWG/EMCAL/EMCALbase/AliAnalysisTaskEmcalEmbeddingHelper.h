@@ -19,6 +19,7 @@
 class TString;
 class TChain;
 class TFile;
+class TBranch;
 class AliVEvent;
 class AliMCEvent;
 class AliVHeader;
@@ -194,6 +195,29 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   void SetRandomRejectionFactor(Double_t configure = 1.)          { fRandomRejectionFactor = configure; }
   /* @} */
 
+  /**
+   * @{
+   * @name Reading of the embedded event
+   */
+  bool GetPreselectFromHeaderBranches()                     const { return fPreselectFromHeaderBranches; }
+  const std::vector<std::string> & GetPreselectionBranches() const { return fPreselectionBranchNames; }
+  Long64_t GetEmbeddedReadCacheSize()                       const { return fReadCacheSize; }
+  bool GetAsyncPrefetching()                                const { return fAsyncPrefetching; }
+  /**
+   * Apply the embedded event selection after reading only the (small) branches listed in
+   * fPreselectionBranchNames. The full entry is only read once the event is accepted. Only
+   * available for AODs. If CheckIsEmbeddedEventSelected() is overridden to use other objects,
+   * their branches must be added with AddPreselectionBranch().
+   */
+  void SetPreselectFromHeaderBranches(bool b = true)              { fPreselectFromHeaderBranches = b; }
+  /// Add a branch which should be read before the embedded event selection is applied.
+  void AddPreselectionBranch(const char * name)                   { fPreselectionBranchNames.push_back(name); }
+  /// Size (in bytes) of the TTreeCache used when reading the embedded events. 0 disables the cache.
+  void SetEmbeddedReadCacheSize(Long64_t size)                    { fReadCacheSize = size; }
+  /// Let ROOT prefetch the baskets of the next cache cluster in the background. Requires a read cache.
+  void SetAsyncPrefetching(bool b = true)                         { fAsyncPrefetching = b; }
+  /* @} */
+
   /**
    * @{
    * @name Options for the embedded event
@@ -302,11 +326,14 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Bool_t          SetupInputFiles()     ;
   std::string     ConstructFullPythiaXSecFilename(std::string inputFilename, const std::string & pythiaFilename, bool testIfExists) const;
   Bool_t          GetNextEntry()        ;
+  void            LoadEmbeddedEntry(Long64_t entry);
+  Int_t           LoadPreselectionBranches(Long64_t entry);
   void            SetEmbeddedEventProperties();
   void            RecordEmbeddedEventProperties();
   Bool_t          IsEventSelected()     ;
   virtual Bool_t  CheckIsEmbeddedEventSelected();
   Bool_t          InitEvent()           ;
+  void            InitReadCache()       ;
   void            InitTree()            ;
   bool            PythiaInfoFromCrossSectionFile(std::string filename);
   // Validation helper
@@ -347,6 +374,13 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   Double_t                                      fRandomRejectionFactor; ///< factor by which to reject events
   TRandom3                                      fRandom           ; ///< for random rejection of events
 
+  bool                                fPreselectFromHeaderBranches; ///<  If true, select embedded events after only reading the preselection branches (AOD only)
+  std::vector <std::string>               fPreselectionBranchNames; ///<  Branches read before the embedded event selection is applied
+  Long64_t                                      fReadCacheSize    ; ///<  Size of the TTreeCache for the external event chain (0 to disable)
+  bool                                          fAsyncPrefetching ; ///<  If true, enable ROOT asynchronous prefetching of the read cache
+  std::vector <TBranch *>                   fPreselectionBranches ; //!<! Preselection branches of the current tree in the chain
+  Int_t                                   fPreselectionTreeNumber ; //!<! Tree number in the chain corresponding to fPreselectionBranches
+
   bool                                    fAutoConfigurePtHardBins; ///<  If true, attempt to auto configure pt hard bins. Only works on the LEGO train.
   std::string                               fAutoConfigureBasePath; ///<  The base path to the auto configuration (for example, "/alice/cern.ch/user/a/alitrain/")
   std::string                          fAutoConfigureTrainTypePath; ///<  The path associated with the train type (for example, "PWGJE/Jets_EMC_PbPb/")
@@ -394,7 +428,7 @@ class AliAnalysisTaskEmcalEmbeddingHelper : public AliAnalysisTaskSE {
   AliAnalysisTaskEmcalEmbeddingHelper &operator=(const AliAnalysisTaskEmcalEmbeddingHelper&); // not implemented
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 14);
+  ClassDef(AliAnalysisTaskEmcalEmbeddingHelper, 15);
   /// \endcond
 };
 #endif
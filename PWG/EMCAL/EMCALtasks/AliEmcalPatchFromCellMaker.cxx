@@ -25,6 +25,8 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker() :
   AliAnalysisTaskEmcal("AliEmcalPatchFromCellMaker",kTRUE),
   fCaloTriggersOutName("EmcalPatches32x32"),
   fCaloTriggersOut(0),
+  fPatchADCTable(),
+  fPatchETable(),
   fPatchDim(32),
   fMinCellE(0.05),
   fCellTimeMin(485e-9),
@@ -51,6 +53,8 @@ AliEmcalPatchFromCellMaker::AliEmcalPatchFromCellMaker(const char *name) :
   AliAnalysisTaskEmcal(name,kTRUE),
   fCaloTriggersOutName("EmcalPatches32x32"),
   fCaloTriggersOut(0),
+  fPatchADCTable(),
+  fPatchETable(),
   fPatchDim(32),
   fMinCellE(0.05),
   fCellTimeMin(485e-9),
@@ -199,6 +203,7 @@ Bool_t AliEmcalPatchFromCellMaker::Run()
     return kFALSE;
   }
 
+  BuildPatchTables();
   RunSimpleOfflineTrigger();
 
   Double_t sum = 0.;
@@ -257,6 +262,17 @@ Bool_t AliEmcalPatchFromCellMaker::FillPatchADCSimple()
   return kTRUE;
 }
 
+//________________________________________________________________________
+void AliEmcalPatchFromCellMaker::BuildPatchTables()
+{
+  // Build the summed-area tables of the ADC and energy maps.
+  // Afterwards the amplitude of any patch is obtained from four lookups.
+  // The ADC of each trigger channel is truncated before summing, as for the online patches.
+
+  fPatchADCTable.Build(fPatchADCSimple);
+  fPatchETable.Build(fPatchESimple);
+}
+
 //________________________________________________________________________
 void AliEmcalPatchFromCellMaker::RunSimpleOfflineTrigger()
 {
@@ -274,17 +290,9 @@ void AliEmcalPatchFromCellMaker::RunSimpleOfflineTrigger()
 
   for (Int_t i = 0; i <= maxCol; i += stepSize) {
     for (Int_t j = 0; j <= maxRow; j += stepSize) {
-      // get the trigger towers composing the patch
-      Int_t   adcAmp = 0;
-      Double_t enAmp = 0.;
-      // window
-      for (Int_t k = 0; k < patchSize; ++k) {
-        for (Int_t l = 0; l < patchSize; ++l) {
-	  // add amplitudes
-          adcAmp += (ULong64_t)fPatchADCSimple[i+k][j+l];
-	  enAmp += fPatchESimple[i+k][j+l];
-	}
-      }
+      // sum of the trigger towers composing the patch
+      Int_t   adcAmp = fPatchADCTable.GetPatchSum(i, j, patchSize);
+      Double_t enAmp = fPatchETable.GetPatchSum(i, j, patchSize);
 
       if (adcAmp == 0) {
 	AliDebug(2,"EMCal trigger patch with 0 ADC counts.");
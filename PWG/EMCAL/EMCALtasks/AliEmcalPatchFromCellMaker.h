@@ -6,6 +6,7 @@ class TH3F;
 class AliEMCALTriggerBitConfig;
 
 #include "AliAnalysisTaskEmcal.h"
+#include "AliEmcalTriggerSummedAreaTable.h"
 
 class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
  public:
@@ -31,6 +32,7 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
   void               UserCreateOutputObjects();
 
   Bool_t             FillPatchADCSimple();
+  void               BuildPatchTables();
   void               RunSimpleOfflineTrigger();
 
   //Getters
@@ -38,12 +40,16 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
   Double_t           GetPatchArea() const                              { return (Double_t)(fPatchDim*fPatchDim)*0.014*0.014; }
   Int_t              GetDimFastor() const;
   Int_t              GetSlidingStepSizeFastor() const;
+  const PWG::EMCAL::AliEmcalTriggerSummedAreaTable<Long64_t> &GetPatchADCTable() const { return fPatchADCTable; }
+  const PWG::EMCAL::AliEmcalTriggerSummedAreaTable<Double_t> &GetPatchETable() const   { return fPatchETable;   }
 
   TString            fCaloTriggersOutName;  // name of output patch array
   TClonesArray      *fCaloTriggersOut;      //!trigger array out
       
   Double_t           fPatchADCSimple[kPatchCols][kPatchRows];   // patch map for simple offline trigger
   Double_t           fPatchESimple[kPatchCols][kPatchRows];     // patch map for simple offline trigger
+  PWG::EMCAL::AliEmcalTriggerSummedAreaTable<Long64_t> fPatchADCTable; //!summed-area table of fPatchADCSimple
+  PWG::EMCAL::AliEmcalTriggerSummedAreaTable<Double_t> fPatchETable;   //!summed-area table of fPatchESimple
 
   Int_t              fPatchDim;             // dimension of patch in #cells
   Double_t           fMinCellE;             // minimum cell energy
@@ -60,6 +66,6 @@ class AliEmcalPatchFromCellMaker : public AliAnalysisTaskEmcal {
   AliEmcalPatchFromCellMaker(const AliEmcalPatchFromCellMaker&);            // not implemented
   AliEmcalPatchFromCellMaker &operator=(const AliEmcalPatchFromCellMaker&); // not implemented
 
-  ClassDef(AliEmcalPatchFromCellMaker, 1); // Task to make PicoTracks in a grid corresponding to EMCAL/DCAL acceptance
+  ClassDef(AliEmcalPatchFromCellMaker, 2); // Task to make PicoTracks in a grid corresponding to EMCAL/DCAL acceptance
 };
 #endif
@@ -33,6 +33,7 @@
 
 #include <TObject.h>
 #include <TArrayF.h>
+#include "AliEmcalTriggerSummedAreaTable.h"
 //#include <AliEMCALTriggerPatchInfoV1.h>
 
 class TF1;
@@ -192,6 +193,39 @@ public:
    */
   double GetTriggerChannelEnergySmeared(Int_t col, Int_t row) const;
 
+  /**
+   * @brief Build the summed-area tables of the offline ADC and smeared energy grids
+   *
+   * Called in CreateTriggerPatches() once the data grids of the event are filled.
+   * Needs to be called explicitly only when patch sums are requested before
+   * the patches are created.
+   */
+  void BuildPatchTables();
+
+  /**
+   * @brief Get the offline ADC of a patch estimated from cell energies (in col-row space)
+   * @param[in] col Start column of the patch
+   * @param[in] row Start row of the patch
+   * @param[in] size Patch size in trigger channels
+   * @return Sum of the offline ADC values in the patch (0 for patches outside the grid)
+   */
+  double GetPatchADCSimple(Int_t col, Int_t row, Int_t size) const { return fPatchADCSimpleTable.GetPatchSum(col, row, size); }
+
+  /**
+   * @brief Get the (simulated) smeared energy of a patch (in col-row space)
+   * @param[in] col Start column of the patch
+   * @param[in] row Start row of the patch
+   * @param[in] size Patch size in trigger channels
+   * @return Sum of the smeared energies in the patch (0 if smearing is disabled)
+   */
+  double GetPatchEnergySmeared(Int_t col, Int_t row, Int_t size) const { return fPatchEnergySmearedTable.GetPatchSum(col, row, size); }
+
+  /**
+   * @brief Access to the summed-area table of the offline ADC grid, i.e. for offline patch recalculation
+   * @return Summed-area table of the offline ADC values
+   */
+  const PWG::EMCAL::AliEmcalTriggerSummedAreaTable<double> &GetPatchADCSimpleTable() const { return fPatchADCSimpleTable; }
+
   /**
    * @brief Get the dimension of the underlying data grids in row direction
    * @return Number of rows
@@ -619,8 +653,10 @@ protected:
   Double_t                                  fRhoValues[kNIndRho];         //!<! Rho values for background subtraction (only online ADC)
 
   Double_t                                  fADCtoGeV;                    //!<! Conversion factor from ADC to GeV
+  PWG::EMCAL::AliEmcalTriggerSummedAreaTable<double> fPatchADCSimpleTable;        //!<! Summed-area table of fPatchADCSimple
+  PWG::EMCAL::AliEmcalTriggerSummedAreaTable<double> fPatchEnergySmearedTable;    //!<! Summed-area table of fPatchEnergySimpleSmeared
 
-  ClassDef(AliEmcalTriggerMakerKernel, 4);
+  ClassDef(AliEmcalTriggerMakerKernel, 5);
 };
 
 #endif
@@ -0,0 +1,184 @@
+/************************************************************************************
+ * Copyright (C) 2020, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef __ALIEMCALTRIGGERSUMMEDAREATABLE_H__
+#define __ALIEMCALTRIGGERSUMMEDAREATABLE_H__
+#include <vector>
+
+namespace PWG {
+
+namespace EMCAL {
+
+/**
+ * @class AliEmcalTriggerSummedAreaTable
+ * @brief Summed-area table (integral image) of a FastOR grid
+ * @ingroup EMCALTRGFW
+ *
+ * The table stores for each (col, row) the sum of all channels with smaller
+ * column and row index. It is built once per event from the channel grid
+ * (one pass over the grid). Afterwards the sum over any rectangular patch is
+ * obtained from four lookups, independent of the patch size:
+ *
+ * ~~~{.cxx}
+ * PWG::EMCAL::AliEmcalTriggerSummedAreaTable<double> table;
+ * table.Build(grid);                                       // grid(col, row)
+ * double amp = table.GetPatchSum(col, row, 16);            // 16x16 patch starting at (col, row)
+ * ~~~
+ *
+ * For an integer value type the channels are converted with static_cast
+ * before summing, which is the same truncation that is applied when the
+ * channel ADCs are summed as integers.
+ *
+ * Any grid type providing GetNumberOfCols(), GetNumberOfRows() and
+ * operator()(col, row) (i.e. AliEMCALTriggerDataGrid) can be used as
+ * input, as well as plain two-dimensional arrays indexed [col][row].
+ */
+template<typename T>
+class AliEmcalTriggerSummedAreaTable {
+public:
+  /**
+   * @struct PatchMaximum
+   * @brief Position and amplitude of the patch with the largest sum
+   */
+  struct PatchMaximum {
+    int fCol;         ///< Start column of the patch (-1 if no patch found)
+    int fRow;         ///< Start row of the patch (-1 if no patch found)
+    T   fAmplitude;   ///< Sum over the patch
+  };
+
+  AliEmcalTriggerSummedAreaTable(): fNCols(0), fNRows(0), fTable() {}
+  ~AliEmcalTriggerSummedAreaTable() {}
+
+  /**
+   * @brief Build the table from a grid providing GetNumberOfCols(), GetNumberOfRows() and operator()(col, row)
+   * @param[in] grid Input channel grid
+   */
+  template<typename G>
+  void Build(const G &grid) {
+    Allocate(grid.GetNumberOfCols(), grid.GetNumberOfRows());
+    for(int icol = 0; icol < fNCols; icol++){
+      T colsum = 0;
+      for(int irow = 0; irow < fNRows; irow++){
+        colsum += static_cast<T>(grid(icol, irow));
+        Entry(icol + 1, irow + 1) = Entry(icol, irow + 1) + colsum;
+      }
+    }
+  }
+
+  /**
+   * @brief Build the table from a plain two-dimensional array indexed [col][row]
+   * @param[in] grid Input channel array
+   * @param[in] ncols Number of columns to use (at most C)
+   * @param[in] nrows Number of rows to use (at most R)
+   */
+  template<typename V, int C, int R>
+  void Build(const V (&grid)[C][R], int ncols = C, int nrows = R) {
+    Allocate(ncols, nrows);
+    for(int icol = 0; icol < fNCols; icol++){
+      T colsum = 0;
+      for(int irow = 0; irow < fNRows; irow++){
+        colsum += static_cast<T>(grid[icol][irow]);
+        Entry(icol + 1, irow + 1) = Entry(icol, irow + 1) + colsum;
+      }
+    }
+  }
+
+  /**
+   * @brief Sum over a rectangular region of the grid
+   * @param[in] col Start column
+   * @param[in] row Start row
+   * @param[in] ncols Number of columns of the region
+   * @param[in] nrows Number of rows of the region
+   * @return Sum of all channels in the region (0 if the region exceeds the grid)
+   */
+  T GetSum(int col, int row, int ncols, int nrows) const {
+    if(col < 0 || row < 0 || col + ncols > fNCols || row + nrows > fNRows) return 0;
+    return Entry(col + ncols, row + nrows) - Entry(col, row + nrows) - Entry(col + ncols, row) + Entry(col, row);
+  }
+
+  /**
+   * @brief Sum over a square patch of the grid
+   * @param[in] col Start column
+   * @param[in] row Start row
+   * @param[in] size Patch size in channels
+   * @return Sum of all channels in the patch
+   */
+  T GetPatchSum(int col, int row, int size) const { return GetSum(col, row, size, size); }
+
+  /**
+   * @brief Find the patch with the largest sum among all patches of a given size
+   * @param[in] size Patch size in channels
+   * @param[in] stepsize Step between patch start positions
+   * @param[in] maxcol Largest start column (default: all patches inside the grid)
+   * @param[in] maxrow Largest start row (default: all patches inside the grid)
+   * @return Patch with the largest sum (ties resolved to the first patch found)
+   */
+  PatchMaximum FindMaximum(int size, int stepsize = 1, int maxcol = -1, int maxrow = -1) const {
+    PatchMaximum result = {-1, -1, 0};
+    if(maxcol < 0 || maxcol > fNCols - size) maxcol = fNCols - size;
+    if(maxrow < 0 || maxrow > fNRows - size) maxrow = fNRows - size;
+    if(stepsize < 1) stepsize = 1;
+    for(int icol = 0; icol <= maxcol; icol += stepsize){
+      for(int irow = 0; irow <= maxrow; irow += stepsize){
+        T amp = GetPatchSum(icol, irow, size);
+        if(result.fCol < 0 || amp > result.fAmplitude){
+          result.fCol = icol;
+          result.fRow = irow;
+          result.fAmplitude = amp;
+        }
+      }
+    }
+    return result;
+  }
+
+  int GetNumberOfCols() const { return fNCols; }
+  int GetNumberOfRows() const { return fNRows; }
+
+  /**
+   * @brief Clear the table
+   */
+  void Reset() { fNCols = fNRows = 0; fTable.clear(); }
+
+private:
+  void Allocate(int ncols, int nrows) {
+    fNCols = ncols;
+    fNRows = nrows;
+    fTable.assign((fNCols + 1) * (fNRows + 1), T(0));
+  }
+
+  T &Entry(int col, int row) { return fTable[col * (fNRows + 1) + row]; }
+  const T &Entry(int col, int row) const { return fTable[col * (fNRows + 1) + row]; }
+
+  int            fNCols;    ///< Number of columns of the underlying grid
+  int            fNRows;    ///< Number of rows of the underlying grid
+  std::vector<T> fTable;    ///< Table with (fNCols+1) x (fNRows+1) entries, first row and column are 0
+};
+
+}
+
+}
+
+#endif
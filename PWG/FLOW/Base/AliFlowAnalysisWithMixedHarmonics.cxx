@@ -219,31 +219,37 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
  Double_t wPhi = 1.; // phi weight
  Double_t wPt  = 1.; // pt weight
  Double_t wEta = 1.; // eta weight
- AliFlowTrackSimple *aftsTrack = NULL; // simple track
  
  // c) Fill common control histograms:
  fCommonHists->FillControlHistograms(anEvent);  
  
  // d) Loop over data and calculate e-b-e quantities:
- Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks, i.e. nPrim = nRP + nPOI
+ Int_t nPrim = anEvent->FillTrackArrays();  // nPrim = total number of primary tracks, i.e. nPrim = nRP + nPOI
                                            // nRP   = # of particles used to determine the reaction plane ("Reference Particles");
                                            // nPOI  = # of particles of interest for a detailed flow analysis ("Particles of Interest");
 
  Int_t nRefMult = anEvent->GetReferenceMultiplicity();
 
+ // Contiguous per-track arrays of the event, shared by all methods:
+ const Double_t *trackPhi = anEvent->GetTrackPhiArray();
+ const Double_t *trackPt = anEvent->GetTrackPtArray();
+ const Double_t *trackEta = anEvent->GetTrackEtaArray();
+ const Int_t *trackCharge = anEvent->GetTrackChargeArray();
+ const UInt_t *trackPOItype = anEvent->GetTrackPOItypeArray();
+ const UInt_t kRPbit = (1u<<AliFlowTrackSimple::kRP);
+ const UInt_t kPOIbit = (1u<<AliFlowTrackSimple::kPOI);
+
  // Start loop over data:
  for(Int_t i=0;i<nPrim;i++) 
  { 
-  aftsTrack=anEvent->GetTrack(i);
-  if(aftsTrack)
+  if(trackPOItype[i] & (kRPbit|kPOIbit)) // consider only tracks which are either RPs or POIs
   {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())) continue; // consider only tracks which are either RPs or POIs
    Int_t n = fHarmonic; 
-   if(aftsTrack->InRPSelection()) // checking RP condition:
+   if(trackPOItype[i] & kRPbit) // checking RP condition:
    {    
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
+    dPhi = trackPhi[i];
+    dPt  = trackPt[i];
+    dEta = trackEta[i];
     if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi-weight for this particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
@@ -273,31 +279,30 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
       (*fSpk)(p,k)+=pow(wPhi*wPt*wEta,k);
      }
     }    
-   } // end of if(aftsTrack->InRPSelection())
+   } // end of if(trackPOItype[i] & kRPbit)
    // POIs:
    if(fEvaluateDifferential3pCorrelator)
    {
-    if(aftsTrack->InPOISelection()) // 1st POI
+    if(trackPOItype[i] & kPOIbit) // 1st POI
     {
-     Double_t dPsi1 = aftsTrack->Phi();
-     Double_t dPt1 = aftsTrack->Pt();
-     Double_t dEta1 = aftsTrack->Eta();
-     Int_t iCharge1 = aftsTrack->Charge();
+     Double_t dPsi1 = trackPhi[i];
+     Double_t dPt1 = trackPt[i];
+     Double_t dEta1 = trackEta[i];
+     Int_t iCharge1 = trackCharge[i];
      Bool_t b1stPOIisAlsoRP = kFALSE;
-     if(aftsTrack->InRPSelection()){b1stPOIisAlsoRP = kTRUE;}
+     if(trackPOItype[i] & kRPbit){b1stPOIisAlsoRP = kTRUE;}
      for(Int_t j=0;j<nPrim;j++)
      {
       if(j==i){continue;}
-      aftsTrack=anEvent->GetTrack(j);
-      if(aftsTrack->InPOISelection()) // 2nd POI
+      if(trackPOItype[j] & kPOIbit) // 2nd POI
       {
-       Double_t dPsi2 = aftsTrack->Phi();
-       Double_t dPt2 = aftsTrack->Pt(); 
-       Double_t dEta2 = aftsTrack->Eta();
-       Int_t iCharge2 = aftsTrack->Charge();
+       Double_t dPsi2 = trackPhi[j];
+       Double_t dPt2 = trackPt[j]; 
+       Double_t dEta2 = trackEta[j];
+       Int_t iCharge2 = trackCharge[j];
        if(fOppositeChargesPOI && iCharge1 == iCharge2){continue;}
        Bool_t b2ndPOIisAlsoRP = kFALSE;
-       if(aftsTrack->InRPSelection()){b2ndPOIisAlsoRP = kTRUE;}
+       if(trackPOItype[j] & kRPbit){b2ndPOIisAlsoRP = kTRUE;}
 
        // Fill:Pt
        fRePEBE[0]->Fill((dPt1+dPt2)/2.,TMath::Cos(n*(dPsi1+dPsi2)),1.);
@@ -388,11 +393,11 @@ void AliFlowAnalysisWithMixedHarmonics::Make(AliFlowEventSimple* anEvent)
         fImNITEBE[1][1][2]->Fill((dEta1+dEta2)/2.,TMath::Sin(n*(dPsi2)),1.);
         fImNITEBE[1][1][3]->Fill(TMath::Abs(dEta1-dEta2),TMath::Sin(n*(dPsi2)),1.);       
        }
-      } // end of if(aftsTrack->InPOISelection()) // 2nd POI
+      } // end of if(trackPOItype[j] & kPOIbit) // 2nd POI
      } // end of for(Int_t j=i+1;j<nPrim;j++)
-    } // end of if(aftsTrack->InPOISelection()) // 1st POI  
+    } // end of if(trackPOItype[i] & kPOIbit) // 1st POI  
    } // end of if(fEvaluateDifferential3pCorrelator)
-  } else // to if(aftsTrack)
+  } else if(!anEvent->GetTrack(i)) // NULL tracks are neither RPs nor POIs in the track arrays
     {
      cout<<endl;
      cout<<" WARNING (MH): No particle! (i.e. aftsTrack is a NULL pointer in Make().)"<<endl;
@@ -24,6 +24,7 @@
 #define AliFlowAnalysisWithMultiparticleCorrelations_cxx
 
 #include "AliFlowAnalysisWithMultiparticleCorrelations.h"
+#include "AliMultiParticleCorrelator.h"
 
 using std::endl;
 using std::cout;
@@ -2000,6 +2001,7 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
  Double_t dPt = 0., wPt = 1.; // transverse momentum and corresponding pT weight
  Double_t dEta = 0., wEta = 1.; // pseudorapidity and corresponding eta weight
  Double_t wToPowerP = 1.; // weight raised to power p
+ Double_t dCosHarmonic[49] = {0.}, dSinHarmonic[49] = {0.}; // cos(h*dPhi) and sin(h*dPhi), same dimension as fQvector
  Int_t nCounterRPs = 0;
  for(Int_t t=0;t<nTracks;t++) // loop over all tracks
  {
@@ -2036,15 +2038,18 @@ void AliFlowAnalysisWithMultiparticleCorrelations::FillQvector(AliFlowEventSimpl
    dEta = pTrack->Eta();
    if(fUseWeights[0][2]){wEta = Weight(dEta,"RP","eta");} // corresponding eta weight
 
-   // Calculate Q-vector components:
-   for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+   // Calculate Q-vector components (cos(h*dPhi) and sin(h*dPhi) via recurrence, one sin/cos call per track):
+   AliMultiParticleCorrelator::Harmonics(dPhi,fMaxHarmonic*fMaxCorrelator,dCosHarmonic,dSinHarmonic);
+   Bool_t bUseWeights = fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2];
+   Double_t dWeight = wPhi*wPt*wEta;
+   for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
    {
-    for(Int_t wp=0;wp<fMaxCorrelator+1;wp++) // weight power
+    for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
     {
-     if(fUseWeights[0][0]||fUseWeights[0][1]||fUseWeights[0][2]){wToPowerP = pow(wPhi*wPt*wEta,wp);} 
-     fQvector[h][wp] += TComplex(wToPowerP*TMath::Cos(h*dPhi),wToPowerP*TMath::Sin(h*dPhi));
-    } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
-   } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+     fQvector[h][wp] += TComplex(wToPowerP*dCosHarmonic[h],wToPowerP*dSinHarmonic[h]);
+    } // for(Int_t h=0;h<fMaxHarmonic*fMaxCorrelator+1;h++)
+    if(bUseWeights){wToPowerP *= dWeight;} 
+   } // for(Int_t wp=0;wp<fMaxCorrelator+1;wp++)
   } // if(pTrack->InRPSelection()) // fill Q-vector components only with reference particles
 
   // Differential Q-vectors (a.k.a. p-vector and q-vector):
@@ -5026,37 +5031,13 @@ TComplex AliFlowAnalysisWithMultiparticleCorrelations::Recursion(Int_t n, Int_t*
 TComplex AliFlowAnalysisWithMultiparticleCorrelations::Recursion(Int_t n, Int_t* harmonic, Int_t mult, Int_t skip) 
 {
  // Calculate multi-particle correlators by using recursion (an improved faster version) originally developed by 
- // Kristjan Gulbrandsen (gulbrand@nbi.dk). 
+ // Kristjan Gulbrandsen (gulbrand@nbi.dk). The recursion itself is the shared one in AliMultiParticleCorrelator, 
+ // which works directly on fQvector without temporary TComplex objects.
 
-  Int_t nm1 = n-1;
-  TComplex c(Q(harmonic[nm1], mult));
-  if (nm1 == 0) return c;
-  c *= Recursion(nm1, harmonic);
-  if (nm1 == skip) return c;
-
-  Int_t multp1 = mult+1;
-  Int_t nm2 = n-2;
-  Int_t counter1 = 0;
-  Int_t hhold = harmonic[counter1];
-  harmonic[counter1] = harmonic[nm2];
-  harmonic[nm2] = hhold + harmonic[nm1];
-  TComplex c2(Recursion(nm1, harmonic, multp1, nm2));
-  Int_t counter2 = n-3;
-  while (counter2 >= skip) {
-    harmonic[nm2] = harmonic[counter1];
-    harmonic[counter1] = hhold;
-    ++counter1;
-    hhold = harmonic[counter1];
-    harmonic[counter1] = harmonic[nm2];
-    harmonic[nm2] = hhold + harmonic[nm1];
-    c2 += Recursion(nm1, harmonic, multp1, counter2);
-    --counter2;
-  }
-  harmonic[nm2] = harmonic[counter1];
-  harmonic[counter1] = hhold;
+ AliQnArrayView<TComplex> qvector(&fQvector[0][0],9);
+ std::complex<Double_t> c = AliMultiParticleCorrelator::Recursion(qvector,n,harmonic,mult,skip);
 
-  if (mult == 1) return c-c2;
-  return c-Double_t(mult)*c2;
+ return TComplex(c.real(),c.imag());
 
 } // TComplex AliFlowAnalysisWithMultiparticleCorrelations::Recursion(Int_t n, Int_t* harmonic, Int_t mult, Int_t skip) 
 
@@ -171,6 +171,7 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fCalculateDiffFlow(kTRUE),
  fCalculate2DDiffFlow(kFALSE),
  fCalculateDiffFlowVsEta(kTRUE),
+ fnBins1dBuffer(0),
  // 5.) other differential correlators:
  fOtherDiffCorrelatorsList(NULL),
  // 6.) distributions:
@@ -368,7 +369,6 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  fNumberOfPOIsEBE = anEvent->GetNumberOfPOIs(); // number of POIs (i.e. number of particles of interest)
  fReferenceMultiplicityEBE = anEvent->GetReferenceMultiplicity(); // reference multiplicity for current event
  //Printf("Reference multiplicity (QC): %.1f",fReferenceMultiplicityEBE);
- Double_t ptEta[2] = {0.,0.}; // 0 = dPt, 1 = dEta
   
  // c) Fill the common control histograms and call the method to fill fAvMultiplicity:
  this->FillCommonControlHistograms(anEvent);                                                               
@@ -376,22 +376,26 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  if(fStoreControlHistograms){this->FillControlHistograms(anEvent);}                                                              
                                                                                                                                                                                                                                                                                         
  // d) Loop over data and calculate e-b-e quantities Q_{n,k}, S_{p,k} and s_{p,k}:
- Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
- AliFlowTrackSimple *aftsTrack = NULL;
+ Int_t nPrim = anEvent->FillTrackArrays();  // nPrim = total number of primary tracks
+ const Double_t *trackPhi = anEvent->GetTrackPhiArray(); // contiguous per-track arrays of the event, shared by all methods
+ const Double_t *trackPt = anEvent->GetTrackPtArray();
+ const Double_t *trackEta = anEvent->GetTrackEtaArray();
+ const Double_t *trackWeight = anEvent->GetTrackWeightArray();
+ const UInt_t *trackPOItype = anEvent->GetTrackPOItypeArray();
  Int_t n = fHarmonic; // shortcut for the harmonic 
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
-  aftsTrack=anEvent->GetTrack(i);
-  if(aftsTrack)
+  Bool_t bRP = (trackPOItype[i] & (1u<<AliFlowTrackSimple::kRP)); // RP condition
+  Bool_t bPOI = (trackPOItype[i] & (1u<<AliFlowTrackSimple::kPOI)); // POI condition
+  if(bRP || bPOI) // safety measure: consider only tracks which are RPs or POIs
   {
-   if(!(aftsTrack->InRPSelection() || aftsTrack->InPOISelection())){continue;} // safety measure: consider only tracks which are RPs or POIs
-   if(aftsTrack->InRPSelection()) // RP condition:
+   if(bRP) // RP condition:
    {    
     nCounterNoRPs++;
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
+    dPhi = trackPhi[i];
+    dPt  = trackPt[i];
+    dEta = trackEta[i];
     if(fUsePhiWeights && fPhiWeights && fnBinsPhi) // determine phi weight for this particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
@@ -407,147 +411,82 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
     // Access track weight:
     if(fUseTrackWeights)
     {
-     wTrack = aftsTrack->Weight(); 
+     wTrack = trackWeight[i]; 
     }
+    // Calculate w^k and cos/sin((m+1)*n*phi) once for this particle:
+    this->CalculateWeightPowersAndHarmonics(dPhi,wPhi*wPt*wEta*wTrack,n);
     // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
+    Double_t *reQ = fReQ->GetMatrixArray(); // row-major [m][k]
+    Double_t *imQ = fImQ->GetMatrixArray(); // row-major [m][k]
     for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
     {
      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
      {
-      (*fReQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1)*n*dPhi); 
-      (*fImQ)(m,k)+=pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1)*n*dPhi); 
+      reQ[m*9+k]+=fWeightPowers[k]*fCosMn[m]; 
+      imQ[m*9+k]+=fWeightPowers[k]*fSinMn[m]; 
      } 
     }
     // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
+    Double_t *spk = fSpk->GetMatrixArray(); // row-major [p][k]
     for(Int_t p=0;p<8;p++)
     {
      for(Int_t k=0;k<9;k++)
      {     
-      (*fSpk)(p,k)+=pow(wPhi*wPt*wEta*wTrack,k);
+      spk[p*9+k]+=fWeightPowers[k];
      }
     } 
     // Differential flow:
     if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
-     ptEta[0] = dPt; 
-     ptEta[1] = dEta; 
      // Calculate r_{m*n,k} and s_{p,k} (r_{m,k} is 'p-vector' for RPs): 
-     for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-     {
-      for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      {
-       if(fCalculateDiffFlow)
-       {
-        for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-        {
-         fReRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ1dEBE[0][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs1dEBE[0][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-       } // end of if(fCalculateDiffFlow) 
-       if(fCalculate2DDiffFlow)
-       {
-        fReRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ2dEBE[0][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-        if(m==0) // s_{p,k} does not depend on index m
-        {
-         fs2dEBE[0][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
-        } // end of if(m==0) // s_{p,k} does not depend on index m
-       } // end of if(fCalculate2DDiffFlow)
-      } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+     this->FillDiffFlowQvectorBuffers(0,dPt,dEta,kTRUE);
      // Checking if RP particle is also POI particle:      
-     if(aftsTrack->InPOISelection())
+     if(bPOI)
      {
       // Calculate q_{m*n,k} and s_{p,k} ('q-vector' and 's' for RPs && POIs): 
-      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
-      {
-       for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-       {
-        if(fCalculateDiffFlow)
-        {
-         for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-         {
-          fReRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-          fImRPQ1dEBE[2][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-          if(m==0) // s_{p,k} does not depend on index m
-          {
-           fs1dEBE[2][pe][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k),1.);
-          } // end of if(m==0) // s_{p,k} does not depend on index m
-         } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-        } // end of if(fCalculateDiffFlow) 
-        if(fCalculate2DDiffFlow)
-        {
-         fReRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-         fImRPQ2dEBE[2][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-         if(m==0) // s_{p,k} does not depend on index m
-         {
-          fs2dEBE[2][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k),1.);
-         } // end of if(m==0) // s_{p,k} does not depend on index m
-        } // end of if(fCalculate2DDiffFlow)
-       } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-      } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
-     } // end of if(aftsTrack->InPOISelection())  
+      this->FillDiffFlowQvectorBuffers(2,dPt,dEta,kTRUE);
+     } // end of if(bPOI)  
     } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)         
    } // end of if(pTrack->InRPSelection())
-   if(aftsTrack->InPOISelection())
+   if(bPOI)
    {
-    dPhi = aftsTrack->Phi();
-    dPt  = aftsTrack->Pt();
-    dEta = aftsTrack->Eta();
+    dPhi = trackPhi[i];
+    dPt  = trackPt[i];
+    dEta = trackEta[i];
     wPhi = 1.;
     wPt  = 1.;
     wEta = 1.;
     wTrack = 1.;
-    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && aftsTrack->InRPSelection()) // determine phi weight for POI && RP particle:
+    if(fUsePhiWeights && fPhiWeights && fnBinsPhi && bRP) // determine phi weight for POI && RP particle:
     {
      wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(dPhi*fnBinsPhi/TMath::TwoPi())));
     }
-    if(fUsePtWeights && fPtWeights && fnBinsPt && aftsTrack->InRPSelection()) // determine pt weight for POI && RP particle:
+    if(fUsePtWeights && fPtWeights && fnBinsPt && bRP) // determine pt weight for POI && RP particle:
     {
      wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((dPt-fPtMin)/fPtBinWidth))); 
     }              
-    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && aftsTrack->InRPSelection()) // determine eta weight for POI && RP particle: 
+    if(fUseEtaWeights && fEtaWeights && fEtaBinWidth && bRP) // determine eta weight for POI && RP particle: 
     {
      wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((dEta-fEtaMin)/fEtaBinWidth))); 
     }      
     // Access track weight for POI && RP particle:
-    if(aftsTrack->InRPSelection() && fUseTrackWeights)
+    if(bRP && fUseTrackWeights)
     {
-     wTrack = aftsTrack->Weight(); 
+     wTrack = trackWeight[i]; 
     }
-    ptEta[0] = dPt;
-    ptEta[1] = dEta;
     // Calculate p_{m*n,k} ('p-vector' for POIs): 
-    for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
+    if(fCalculateDiffFlow || fCalculate2DDiffFlow)
     {
-     for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-     {
-      if(fCalculateDiffFlow)
-      {
-       for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
-       {
-        fReRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-        fImRPQ1dEBE[1][pe][m][k]->Fill(ptEta[pe],pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);          
-       } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
-      } // end of if(fCalculateDiffFlow) 
-      if(fCalculate2DDiffFlow)
-      {
-       fReRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Cos((m+1.)*n*dPhi),1.);
-       fImRPQ2dEBE[1][m][k]->Fill(dPt,dEta,pow(wPhi*wPt*wEta*wTrack,k)*TMath::Sin((m+1.)*n*dPhi),1.);      
-      } // end of if(fCalculate2DDiffFlow)
-     } // end of for(Int_t m=0;m<4;m++) // to be improved - hardwired 4
-    } // end of for(Int_t k=0;k<9;k++) // to be improved - hardwired 9    
+     this->CalculateWeightPowersAndHarmonics(dPhi,wPhi*wPt*wEta*wTrack,n);
+     this->FillDiffFlowQvectorBuffers(1,dPt,dEta,kFALSE);
+    } // end of if(fCalculateDiffFlow || fCalculate2DDiffFlow)
    } // end of if(pTrack->InPOISelection())    
-  } else // to if(aftsTrack)
-    {
-     printf("\n WARNING (QC): No particle (i.e. aftsTrack is a NULL pointer in AFAWQC::Make())!!!!\n\n");
-    }
+  } // end of if(bRP || bPOI)
  } // end of for(Int_t i=0;i<nPrim;i++) 
 
+ // Transfer e-b-e quantities for differential flow from flat buffers to e-b-e profiles:
+ if(fCalculateDiffFlow || fCalculate2DDiffFlow){this->FillEventByEventDiffFlowProfiles();}
+
  // e) Calculate the final expressions for S_{p,k} and s_{p,k} (important !!!!):
  for(Int_t p=0;p<8;p++)
  {
@@ -15381,6 +15320,16 @@ void AliFlowAnalysisWithQCumulants::InitializeArraysForDiffFlow()
    }   
   }
  }
+ // Flat buffers for current particle:
+ for(Int_t k=0;k<9;k++) // power of weight
+ {
+  fWeightPowers[k] = 0.;
+ }
+ for(Int_t m=0;m<12;m++) // multiple of harmonic
+ {
+  fCosMn[m] = 0.;
+  fSinMn[m] = 0.;
+ }
  
  // d) Initialize profiles:
  for(Int_t t=0;t<2;t++) // type: RP or POI
@@ -19389,6 +19338,16 @@ void AliFlowAnalysisWithQCumulants::BookEverythingFor2DDifferentialFlow()
    fs2dEBE[t][k] = (TProfile2D*)styleS.Clone(Form("typeFlag%dpower%d",t,k));
   }
  }
+ // flat buffers which are filled in the loop over particles and transferred to the above profiles once per event:
+ Int_t nBins2d = (fnBinsPt+2)*(fnBinsEta+2); // +2 = underflow and overflow
+ fReRPQ2dBuffer.assign(3*nBins2d*4*9,0.);
+ fImRPQ2dBuffer.assign(3*nBins2d*4*9,0.);
+ fs2dBuffer.assign(3*nBins2d*9,0.);
+ fEntries2dBuffer.assign(3*nBins2d,0.);
+ for(Int_t t=0;t<3;t++) // typeFlag (0 = RP, 1 = POI, 2 = RP&&POI )
+ {
+  fFilled2dBins[t].clear();
+ }
 
  // c) Book 2D profiles:
  TString s2DDiffFlowCorrelationsProName = "f2DDiffFlowCorrelationsPro";
@@ -19514,6 +19473,19 @@ void AliFlowAnalysisWithQCumulants::BookEverythingForDifferentialFlow()
    }
   }
  }
+ // flat buffers which are filled in the loop over particles and transferred to the above profiles once per event:
+ fnBins1dBuffer = TMath::Max(nBinsPtEta[0],nBinsPtEta[1])+2; // +2 = underflow and overflow
+ fReRPQ1dBuffer.assign(3*2*fnBins1dBuffer*4*9,0.);
+ fImRPQ1dBuffer.assign(3*2*fnBins1dBuffer*4*9,0.);
+ fs1dBuffer.assign(3*2*fnBins1dBuffer*9,0.);
+ fEntries1dBuffer.assign(3*2*fnBins1dBuffer,0.);
+ for(Int_t t=0;t<3;t++) // typeFlag (0 = RP, 1 = POI, 2 = RP&&POI )
+ {
+  for(Int_t pe=0;pe<2;pe++) // pt or eta
+  {
+   fFilled1dBins[t][pe].clear();
+  }
+ }
  // correction terms for nua:
  for(Int_t t=0;t<2;t++) // typeFlag (0 = RP, 1 = POI)
  { 
@@ -21007,30 +20979,36 @@ void AliFlowAnalysisWithQCumulants::ResetEventByEventQuantities()
  // Differential flow:
  if(fCalculateDiffFlow)
  {
+  // only the bins set in FillEventByEventDiffFlowProfiles() are reset:
   for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
   {
    for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // 1D in pt or eta
    {
-    for(Int_t m=0;m<4;m++) // multiple of harmonic
+    for(UInt_t fb=0;fb<fFilled1dBins[t][pe].size();fb++) // filled pt or eta bins only
     {
-     for(Int_t k=0;k<9;k++) // power of weight
+     Int_t bin = fFilled1dBins[t][pe][fb];
+     for(Int_t m=0;m<4;m++) // multiple of harmonic
      {
-      if(fReRPQ1dEBE[t][pe][m][k]) fReRPQ1dEBE[t][pe][m][k]->Reset();
-      if(fImRPQ1dEBE[t][pe][m][k]) fImRPQ1dEBE[t][pe][m][k]->Reset();
-     }   
-    } 
+      for(Int_t k=0;k<9;k++) // power of weight
+      {
+       fReRPQ1dEBE[t][pe][m][k]->SetBinContent(bin,0.);
+       fReRPQ1dEBE[t][pe][m][k]->SetBinEntries(bin,0.);
+       fImRPQ1dEBE[t][pe][m][k]->SetBinContent(bin,0.);
+       fImRPQ1dEBE[t][pe][m][k]->SetBinEntries(bin,0.);
+      }   
+     } 
+     if(t!=1) // s_{p,k} is not filled for POIs
+     {
+      for(Int_t k=0;k<9;k++) // power of weight
+      {
+       fs1dEBE[t][pe][k]->SetBinContent(bin,0.);
+       fs1dEBE[t][pe][k]->SetBinEntries(bin,0.);
+      }
+     }
+    } // end of for(UInt_t fb=0;fb<fFilled1dBins[t][pe].size();fb++)
+    fFilled1dBins[t][pe].clear();
    }
   } 
-  for(Int_t t=0;t<3;t++) // type (0 = RP, 1 = POI, 2 = RP&&POI )
-  { 
-   for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // 1D in pt or eta
-   {
-    for(Int_t k=0;k<9;k++)
-    {
-     if(fs1dEBE[t][pe][k]) fs1dEBE[t][pe][k]->Reset();
-    }
-   }
-  }
   // e-b-e reduced correlations:
   for(Int_t t=0;t<2;t++) // type (0 = RP, 1 = POI)
   {  
@@ -21062,27 +21040,213 @@ void AliFlowAnalysisWithQCumulants::ResetEventByEventQuantities()
  // 2D (pt,eta)
  if(fCalculate2DDiffFlow)
  {
+  // only the bins set in FillEventByEventDiffFlowProfiles() are reset:
   for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
   {
+   for(UInt_t fb=0;fb<fFilled2dBins[t].size();fb++) // filled (pt,eta) bins only
+   {
+    Int_t bin = fFilled2dBins[t][fb];
+    for(Int_t m=0;m<4;m++) // multiple of harmonic
+    {
+     for(Int_t k=0;k<9;k++) // power of weight
+     {
+      fReRPQ2dEBE[t][m][k]->SetBinContent(bin,0.);
+      fReRPQ2dEBE[t][m][k]->SetBinEntries(bin,0.);
+      fImRPQ2dEBE[t][m][k]->SetBinContent(bin,0.);
+      fImRPQ2dEBE[t][m][k]->SetBinEntries(bin,0.);
+     }   
+    }
+    if(t!=1) // s_{p,k} is not filled for POIs
+    {
+     for(Int_t k=0;k<9;k++) // power of weight
+     {
+      fs2dEBE[t][k]->SetBinContent(bin,0.);
+      fs2dEBE[t][k]->SetBinEntries(bin,0.);
+     }
+    }
+   } // end of for(UInt_t fb=0;fb<fFilled2dBins[t].size();fb++)
+   fFilled2dBins[t].clear();
+  }  
+ } // end of if(fCalculate2DDiffFlow) 
+
+} // end of void AliFlowAnalysisWithQCumulants::ResetEventByEventQuantities();
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::CalculateWeightPowersAndHarmonics(Double_t dPhi, Double_t dWeight, Int_t n)
+{
+ // Calculate for current particle w^k (k = 0,1,...,8) by repeated multiplication and 
+ // cos((m+1)*n*phi), sin((m+1)*n*phi) (m = 0,1,...,11) by recurrence from cos(n*phi) and sin(n*phi).
+ 
+ fWeightPowers[0] = 1.;
+ for(Int_t k=1;k<9;k++)
+ {
+  fWeightPowers[k] = fWeightPowers[k-1]*dWeight;
+ }
+ 
+ fCosMn[0] = TMath::Cos(n*dPhi);
+ fSinMn[0] = TMath::Sin(n*dPhi);
+ for(Int_t m=1;m<12;m++)
+ {
+  fCosMn[m] = fCosMn[m-1]*fCosMn[0]-fSinMn[m-1]*fSinMn[0];
+  fSinMn[m] = fSinMn[m-1]*fCosMn[0]+fCosMn[m-1]*fSinMn[0];
+ }
+
+} // end of void AliFlowAnalysisWithQCumulants::CalculateWeightPowersAndHarmonics(Double_t dPhi, Double_t dWeight, Int_t n)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FillDiffFlowQvectorBuffers(Int_t t, Double_t dPt, Double_t dEta, Bool_t bFillS)
+{
+ // Add current particle to flat e-b-e buffers of r_{m*n,k}, p_{m*n,k} or q_{m*n,k} (t = 0,1,2) and s_{p,k}
+ // in its pt, eta and (pt,eta) bins. Powers of weights and harmonics must be calculated before with 
+ // CalculateWeightPowersAndHarmonics(). Buffers are transferred to e-b-e profiles in FillEventByEventDiffFlowProfiles().
+ 
+ if(fCalculateDiffFlow)
+ {
+  Double_t ptEta[2] = {dPt,dEta}; // 0 = dPt, 1 = dEta
+  for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+  {
+   Int_t bin = fReRPQ1dEBE[t][pe][0][0]->FindBin(ptEta[pe]);
+   Int_t b = (t*2+pe)*fnBins1dBuffer + bin;
+   if(fEntries1dBuffer[b]==0.){fFilled1dBins[t][pe].push_back(bin);}
+   fEntries1dBuffer[b]++;
+   Double_t *reQ = &fReRPQ1dBuffer[b*36];
+   Double_t *imQ = &fImRPQ1dBuffer[b*36];
    for(Int_t m=0;m<4;m++) // multiple of harmonic
    {
     for(Int_t k=0;k<9;k++) // power of weight
     {
-     if(fReRPQ2dEBE[t][m][k]){fReRPQ2dEBE[t][m][k]->Reset();}
-     if(fImRPQ2dEBE[t][m][k]){fImRPQ2dEBE[t][m][k]->Reset();}
-    }   
+     reQ[m*9+k]+=fWeightPowers[k]*fCosMn[m];
+     imQ[m*9+k]+=fWeightPowers[k]*fSinMn[m];
+    }
+   }
+   if(bFillS) // s_{p,k} does not depend on index m
+   {
+    Double_t *sk = &fs1dBuffer[b*9];
+    for(Int_t k=0;k<9;k++) // power of weight
+    {
+     sk[k]+=fWeightPowers[k];
+    }
+   }
+  } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+ } // end of if(fCalculateDiffFlow)
+ 
+ if(fCalculate2DDiffFlow)
+ {
+  Int_t nBins2d = (fnBinsPt+2)*(fnBinsEta+2);
+  Int_t bin = fReRPQ2dEBE[t][0][0]->FindBin(dPt,dEta);
+  Int_t b = t*nBins2d + bin;
+  if(fEntries2dBuffer[b]==0.){fFilled2dBins[t].push_back(bin);}
+  fEntries2dBuffer[b]++;
+  Double_t *reQ = &fReRPQ2dBuffer[b*36];
+  Double_t *imQ = &fImRPQ2dBuffer[b*36];
+  for(Int_t m=0;m<4;m++) // multiple of harmonic
+  {
+   for(Int_t k=0;k<9;k++) // power of weight
+   {
+    reQ[m*9+k]+=fWeightPowers[k]*fCosMn[m];
+    imQ[m*9+k]+=fWeightPowers[k]*fSinMn[m];
    }
   }
-  for(Int_t t=0;t<3;t++) // type (0 = RP, 1 = POI, 2 = RP&&POI )
-  { 
-   for(Int_t k=0;k<9;k++)
+  if(bFillS) // s_{p,k} does not depend on index m
+  {
+   Double_t *sk = &fs2dBuffer[b*9];
+   for(Int_t k=0;k<9;k++) // power of weight
    {
-    if(fs2dEBE[t][k]){fs2dEBE[t][k]->Reset();}
+    sk[k]+=fWeightPowers[k];
    }
-  }  
- } // end of if(fCalculate2DDiffFlow) 
+  }
+ } // end of if(fCalculate2DDiffFlow)
 
-} // end of void AliFlowAnalysisWithQCumulants::ResetEventByEventQuantities();
+} // end of void AliFlowAnalysisWithQCumulants::FillDiffFlowQvectorBuffers(Int_t t, Double_t dPt, Double_t dEta, Bool_t bFillS)
+
+//=======================================================================================================================
+
+void AliFlowAnalysisWithQCumulants::FillEventByEventDiffFlowProfiles()
+{
+ // Transfer flat e-b-e buffers to e-b-e profiles, once per event, and clear the buffers. 
+ // Each particle entered the profiles with unit weight, so bin entries are the number of particles in the bin
+ // and bin content is the sum. Only bin content and entries are set, which is all that is used later from these profiles.
+ // The filled bins are kept in fFilled1dBins and fFilled2dBins until ResetEventByEventQuantities().
+ 
+ if(fCalculateDiffFlow)
+ {
+  for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
+  {
+   for(Int_t pe=0;pe<1+(Int_t)fCalculateDiffFlowVsEta;pe++) // pt or eta
+   {
+    for(UInt_t fb=0;fb<fFilled1dBins[t][pe].size();fb++) // filled pt or eta bins only
+    {
+     Int_t bin = fFilled1dBins[t][pe][fb];
+     Int_t b = (t*2+pe)*fnBins1dBuffer + bin;
+     Double_t dEntries = fEntries1dBuffer[b];
+     for(Int_t m=0;m<4;m++) // multiple of harmonic
+     {
+      for(Int_t k=0;k<9;k++) // power of weight
+      {
+       Int_t i = b*36+m*9+k;
+       fReRPQ1dEBE[t][pe][m][k]->SetBinContent(bin,fReRPQ1dBuffer[i]);
+       fReRPQ1dEBE[t][pe][m][k]->SetBinEntries(bin,dEntries);
+       fImRPQ1dEBE[t][pe][m][k]->SetBinContent(bin,fImRPQ1dBuffer[i]);
+       fImRPQ1dEBE[t][pe][m][k]->SetBinEntries(bin,dEntries);
+       fReRPQ1dBuffer[i] = 0.;
+       fImRPQ1dBuffer[i] = 0.;
+      }
+     }
+     if(t!=1) // s_{p,k} is not filled for POIs
+     {
+      for(Int_t k=0;k<9;k++) // power of weight
+      {
+       fs1dEBE[t][pe][k]->SetBinContent(bin,fs1dBuffer[b*9+k]);
+       fs1dEBE[t][pe][k]->SetBinEntries(bin,dEntries);
+       fs1dBuffer[b*9+k] = 0.;
+      }
+     }
+     fEntries1dBuffer[b] = 0.;
+    } // end of for(UInt_t fb=0;fb<fFilled1dBins[t][pe].size();fb++)
+   } // end of for(Int_t pe=0;pe<2;pe++) // pt or eta
+  } // end of for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
+ } // end of if(fCalculateDiffFlow)
+
+ if(fCalculate2DDiffFlow)
+ {
+  Int_t nBins2d = (fnBinsPt+2)*(fnBinsEta+2);
+  for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
+  {
+   for(UInt_t fb=0;fb<fFilled2dBins[t].size();fb++) // filled (pt,eta) bins only
+   {
+    Int_t bin = fFilled2dBins[t][fb];
+    Int_t b = t*nBins2d + bin;
+    Double_t dEntries = fEntries2dBuffer[b];
+    for(Int_t m=0;m<4;m++) // multiple of harmonic
+    {
+     for(Int_t k=0;k<9;k++) // power of weight
+     {
+      Int_t i = b*36+m*9+k;
+      fReRPQ2dEBE[t][m][k]->SetBinContent(bin,fReRPQ2dBuffer[i]);
+      fReRPQ2dEBE[t][m][k]->SetBinEntries(bin,dEntries);
+      fImRPQ2dEBE[t][m][k]->SetBinContent(bin,fImRPQ2dBuffer[i]);
+      fImRPQ2dEBE[t][m][k]->SetBinEntries(bin,dEntries);
+      fReRPQ2dBuffer[i] = 0.;
+      fImRPQ2dBuffer[i] = 0.;
+     }
+    }
+    if(t!=1) // s_{p,k} is not filled for POIs
+    {
+     for(Int_t k=0;k<9;k++) // power of weight
+     {
+      fs2dEBE[t][k]->SetBinContent(bin,fs2dBuffer[b*9+k]);
+      fs2dEBE[t][k]->SetBinEntries(bin,dEntries);
+      fs2dBuffer[b*9+k] = 0.;
+     }
+    }
+    fEntries2dBuffer[b] = 0.;
+   } // end of for(UInt_t fb=0;fb<fFilled2dBins[t].size();fb++)
+  } // end of for(Int_t t=0;t<3;t++) // type (RP, POI, POI&&RP)
+ } // end of if(fCalculate2DDiffFlow)
+
+} // end of void AliFlowAnalysisWithQCumulants::FillEventByEventDiffFlowProfiles()
 
 //=======================================================================================================================
 
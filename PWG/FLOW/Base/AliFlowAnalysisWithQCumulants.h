@@ -14,6 +14,7 @@
 #ifndef ALIFLOWANALYSISWITHQCUMULANTS_H
 #define ALIFLOWANALYSISWITHQCUMULANTS_H
 
+#include <vector>
 #include "TMatrixD.h"
 #include "TH2D.h"
 #include "TRandom3.h"
@@ -82,6 +83,9 @@ class AliFlowAnalysisWithQCumulants{
     virtual void FillCommonControlHistograms(AliFlowEventSimple *anEvent);
     virtual void FillControlHistograms(AliFlowEventSimple *anEvent);
     virtual void ResetEventByEventQuantities();
+    virtual void CalculateWeightPowersAndHarmonics(Double_t dPhi, Double_t dWeight, Int_t n);
+    virtual void FillDiffFlowQvectorBuffers(Int_t t, Double_t dPt, Double_t dEta, Bool_t bFillS);
+    virtual void FillEventByEventDiffFlowProfiles();
     // 2b.) Reference flow:
     virtual void CalculateIntFlowCorrelations(); 
     virtual void CalculateIntFlowCorrelationsUsingParticleWeights();
@@ -368,6 +372,13 @@ class AliFlowAnalysisWithQCumulants{
   Bool_t GetCalculate2DDiffFlow() const {return this->fCalculate2DDiffFlow;};
   void SetCalculateDiffFlowVsEta(Bool_t const cdfve) {this->fCalculateDiffFlowVsEta = cdfve;};
   Bool_t GetCalculateDiffFlowVsEta() const {return this->fCalculateDiffFlowVsEta;};
+  //  Event-by-event quantities (filled in Make(), valid until ResetEventByEventQuantities()):
+  TProfile* GetReRPQ1dEBE(Int_t t, Int_t pe, Int_t m, Int_t k) const {return this->fReRPQ1dEBE[t][pe][m][k];};
+  TProfile* GetImRPQ1dEBE(Int_t t, Int_t pe, Int_t m, Int_t k) const {return this->fImRPQ1dEBE[t][pe][m][k];};
+  TProfile* Gets1dEBE(Int_t t, Int_t pe, Int_t k) const {return this->fs1dEBE[t][pe][k];};
+  TProfile2D* GetReRPQ2dEBE(Int_t t, Int_t m, Int_t k) const {return this->fReRPQ2dEBE[t][m][k];};
+  TProfile2D* GetImRPQ2dEBE(Int_t t, Int_t m, Int_t k) const {return this->fImRPQ2dEBE[t][m][k];};
+  TProfile2D* Gets2dEBE(Int_t t, Int_t k) const {return this->fs2dEBE[t][k];};
   //  Profiles:
   //   1D:
   void SetDiffFlowCorrelationsPro(TProfile* const diffFlowCorrelationsPro, Int_t const i, Int_t const j, Int_t const k) {this->fDiffFlowCorrelationsPro[i][j][k] = diffFlowCorrelationsPro;};
@@ -720,6 +731,21 @@ class AliFlowAnalysisWithQCumulants{
   TProfile2D *fReRPQ2dEBE[3][4][9]; // real part of r_{m*n,k}(pt,eta), p_{m*n,k}(pt,eta) and q_{m*n,k}(pt,eta)
   TProfile2D *fImRPQ2dEBE[3][4][9]; // imaginary part of r_{m*n,k}(pt,eta), p_{m*n,k}(pt,eta) and q_{m*n,k}(pt,eta)
   TProfile2D *fs2dEBE[3][9]; //! [t][k] // to be improved
+  //   flat e-b-e buffers filled in the loop over particles, transferred once per event to the e-b-e profiles above:
+  Double_t fWeightPowers[9]; //! w^k for current particle, k = 0,...,8
+  Double_t fCosMn[12]; //! cos((m+1)*n*phi) for current particle, m = 0,...,11
+  Double_t fSinMn[12]; //! sin((m+1)*n*phi) for current particle, m = 0,...,11
+  Int_t fnBins1dBuffer; //! number of bins (incl. under/overflow) per [t][pe] in 1D buffers
+  std::vector<Double_t> fReRPQ1dBuffer; //! [t][pe][bin][m][k]
+  std::vector<Double_t> fImRPQ1dBuffer; //! [t][pe][bin][m][k]
+  std::vector<Double_t> fs1dBuffer; //! [t][pe][bin][k]
+  std::vector<Double_t> fEntries1dBuffer; //! [t][pe][bin]
+  std::vector<Double_t> fReRPQ2dBuffer; //! [t][global (pt,eta) bin][m][k]
+  std::vector<Double_t> fImRPQ2dBuffer; //! [t][global (pt,eta) bin][m][k]
+  std::vector<Double_t> fs2dBuffer; //! [t][global (pt,eta) bin][k]
+  std::vector<Double_t> fEntries2dBuffer; //! [t][global (pt,eta) bin]
+  std::vector<Int_t> fFilled1dBins[3][2]; //! [t][pe] pt or eta bins filled in current event, reset in ResetEventByEventQuantities()
+  std::vector<Int_t> fFilled2dBins[3]; //! [t] global (pt,eta) bins filled in current event, reset in ResetEventByEventQuantities()
   //  4d.) profiles:
   //   1D:
   TProfile *fDiffFlowCorrelationsPro[2][2][4]; //! [0=RP,1=POI][0=pt,1=eta][correlation index]
@@ -847,7 +873,7 @@ class AliFlowAnalysisWithQCumulants{
   TH2D *fBootstrapCumulants; // x-axis => QC{2}, QC{4}, QC{6}, QC{8}; y-axis => subsample # 
   TH2D *fBootstrapCumulantsVsM[4]; // index => QC{2}, QC{4}, QC{6}, QC{8}; x-axis => multiplicity; y-axis => subsample # 
 
-  ClassDef(AliFlowAnalysisWithQCumulants, 4);
+  ClassDef(AliFlowAnalysisWithQCumulants, 5);
 
 };
 
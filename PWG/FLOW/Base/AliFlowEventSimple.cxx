@@ -89,7 +89,15 @@ AliFlowEventSimple::AliFlowEventSimple():
   fZPAM(0.),
   fAbsOrbit(0),
   fNumberOfPOItypes(2),
-  fNumberOfPOIs(NULL)
+  fNumberOfPOIs(NULL),
+  fTrackArraysFilled(kFALSE),
+  fTrackPhi(),
+  fTrackPt(),
+  fTrackEta(),
+  fTrackWeight(),
+  fTrackCharge(),
+  fTrackPOItype(),
+  fTrackSubevent()
 {
   fZNCQ = AliFlowVector();
   fZNAQ = AliFlowVector();
@@ -148,7 +156,15 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fZPAM(0.),
   fAbsOrbit(0),
   fNumberOfPOItypes(2),
-  fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
+  fNumberOfPOIs(new Int_t[fNumberOfPOItypes]),
+  fTrackArraysFilled(kFALSE),
+  fTrackPhi(),
+  fTrackPt(),
+  fTrackEta(),
+  fTrackWeight(),
+  fTrackCharge(),
+  fTrackPOItype(),
+  fTrackSubevent()
 {
   //ctor
   // if second argument is set to AliFlowEventSimple::kGenerate
@@ -211,7 +227,15 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZPAM(anEvent.fZPAM),
   fAbsOrbit(anEvent.fAbsOrbit),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
-  fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
+  fNumberOfPOIs(new Int_t[fNumberOfPOItypes]),
+  fTrackArraysFilled(kFALSE),
+  fTrackPhi(),
+  fTrackPt(),
+  fTrackEta(),
+  fTrackWeight(),
+  fTrackCharge(),
+  fTrackPOItype(),
+  fTrackSubevent()
 {
   //copy constructor
   memcpy(fNumberOfPOIs,anEvent.fNumberOfPOIs,fNumberOfPOItypes*sizeof(Int_t));
@@ -266,6 +290,7 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
   delete [] fNumberOfPOIs;
   fNumberOfPOIs=new Int_t[fNumberOfPOItypes];
   memcpy(fNumberOfPOIs,anEvent.fNumberOfPOIs,fNumberOfPOItypes*sizeof(Int_t));
+  fTrackArraysFilled = kFALSE;
   fUseGlauberMCSymmetryPlanes = anEvent.fUseGlauberMCSymmetryPlanes;
   fUseExternalSymmetryPlanes = anEvent.fUseExternalSymmetryPlanes;
   fPsi1 = anEvent.fPsi1;
@@ -418,6 +443,8 @@ void AliFlowEventSimple::Generate(Int_t nParticles,
 AliFlowTrackSimple* AliFlowEventSimple::GetTrack(Int_t i)
 {
   //get track i from collection
+  //tracks modified directly (SetForRPSelection(), SetPhi(), ...) after
+  //FillTrackArrays() require InvalidateTrackArrays()
   if (i>=fNumberOfTracks) return NULL;
   Int_t trackIndex=i;
   //if asked use the shuffled index
@@ -433,6 +460,7 @@ AliFlowTrackSimple* AliFlowEventSimple::GetTrack(Int_t i)
 //-----------------------------------------------------------------------
 void AliFlowEventSimple::ShuffleTracks()
 {
+  InvalidateTrackArrays();
   //shuffle track indexes
   if (!fShuffledIndexes)
   {
@@ -470,6 +498,7 @@ void AliFlowEventSimple::TrackAdded()
 {
   //book keeping after a new track has been added
   fNumberOfTracks++;
+  fTrackArraysFilled=kFALSE;
   if (fShuffledIndexes)
   {
     delete [] fShuffledIndexes;
@@ -897,7 +926,15 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fZPAM(0.),
   fAbsOrbit(0),
   fNumberOfPOItypes(2),
-  fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
+  fNumberOfPOIs(new Int_t[fNumberOfPOItypes]),
+  fTrackArraysFilled(kFALSE),
+  fTrackPhi(),
+  fTrackPt(),
+  fTrackEta(),
+  fTrackWeight(),
+  fTrackCharge(),
+  fTrackPOItype(),
+  fTrackSubevent()
 {
   //constructor, fills the event from a TTree of kinematic.root files
   //applies RP and POI cuts, tags the tracks
@@ -957,6 +994,7 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
 //_____________________________________________________________________________
 void AliFlowEventSimple::CloneTracks(Int_t n)
 {
+  InvalidateTrackArrays();
   //clone every track n times to add non-flow
   if (n<=0) return; //no use to clone stuff zero or less times
   Int_t ntracks = fNumberOfTracks;
@@ -976,6 +1014,7 @@ void AliFlowEventSimple::CloneTracks(Int_t n)
 //_____________________________________________________________________________
 void AliFlowEventSimple::ResolutionPt(Double_t res)
 {
+  InvalidateTrackArrays();
   //smear pt of all tracks by gaussian with sigma=res
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -991,6 +1030,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
                                             Double_t etaMinB,
                                             Double_t etaMaxB )
 {
+  InvalidateTrackArrays();
   //Flag two subevents in given eta ranges
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1006,6 +1046,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
 //_____________________________________________________________________________
 void AliFlowEventSimple::TagSubeventsByCharge()
 {
+  InvalidateTrackArrays();
   //Flag two subevents in given eta ranges
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1021,6 +1062,7 @@ void AliFlowEventSimple::TagSubeventsByCharge()
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV1( Double_t v1 )
 {
+  InvalidateTrackArrays();
   //add v2 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1038,6 +1080,7 @@ void AliFlowEventSimple::AddV1( Double_t v1 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV2( Double_t v2 )
 {
+  InvalidateTrackArrays();
   //add v2 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1055,6 +1098,7 @@ void AliFlowEventSimple::AddV2( Double_t v2 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV3( Double_t v3 )
 {
+  InvalidateTrackArrays();
   //add v3 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1072,6 +1116,7 @@ void AliFlowEventSimple::AddV3( Double_t v3 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV4( Double_t v4 )
 {
+  InvalidateTrackArrays();
   //add v4 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1089,6 +1134,7 @@ void AliFlowEventSimple::AddV4( Double_t v4 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV5( Double_t v5 )
 {
+  InvalidateTrackArrays();
   //add v4 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1107,6 +1153,7 @@ void AliFlowEventSimple::AddV5( Double_t v5 )
 void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_t v4, Double_t v5,
                                   Double_t rp1, Double_t rp2, Double_t rp3, Double_t rp4, Double_t rp5 )
 {
+  InvalidateTrackArrays();
   //add flow to all tracks wrt the reaction plane angle, for all harmonic separate angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1119,6 +1166,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_t v4, Double_t v5 )
 {
+  InvalidateTrackArrays();
   //add flow to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1131,6 +1179,7 @@ void AliFlowEventSimple::AddFlow( Double_t v1, Double_t v2, Double_t v3, Double_
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
 {
+  InvalidateTrackArrays();
   //add v2 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1145,6 +1194,7 @@ void AliFlowEventSimple::AddV2( TF1* ptDepV2 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 {
+  InvalidateTrackArrays();
   //add v2 to all tracks wrt the reaction plane angle
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1159,6 +1209,7 @@ void AliFlowEventSimple::AddV2( TF2* ptEtaDepV2 )
 //_____________________________________________________________________________
 void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 {
+  InvalidateTrackArrays();
   //tag tracks as reference particles (RPs)
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1181,6 +1232,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
 //_____________________________________________________________________________
 void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiType )
 {
+  InvalidateTrackArrays();
   //tag tracks as particles of interest (POIs)
   for (Int_t i=0; i<fNumberOfTracks; i++)
   {
@@ -1213,6 +1265,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
                                          Double_t phiMin,
                                          Double_t phiMax )
 {
+  InvalidateTrackArrays();
   //mark tracks in given eta-phi region as dead
   //by resetting the flow bits
   for (Int_t i=0; i<fNumberOfTracks; i++)
@@ -1235,6 +1288,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
 //_____________________________________________________________________________
 Int_t AliFlowEventSimple::CleanUpDeadTracks()
 {
+  InvalidateTrackArrays();
   //remove tracks that have no flow tags set and cleanup the container
   //returns number of cleaned tracks
   Int_t ncleaned=0;
@@ -1286,4 +1340,105 @@ void AliFlowEventSimple::ClearFast()
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  fTrackArraysFilled=kFALSE;
+}
+
+//-----------------------------------------------------------------------
+Int_t AliFlowEventSimple::FillTrackArrays()
+{
+  //fill the contiguous per-track arrays in GetTrack(i) order, if not yet done for
+  //the current content of the event. Memory is kept between events.
+  //Tracks modified directly through GetTrack(i)->Set...() after the arrays were
+  //filled require InvalidateTrackArrays().
+  if (fTrackArraysFilled && (Int_t)fTrackPhi.size()==fNumberOfTracks) return fNumberOfTracks;
+
+  fTrackPhi.resize(fNumberOfTracks);
+  fTrackPt.resize(fNumberOfTracks);
+  fTrackEta.resize(fNumberOfTracks);
+  fTrackWeight.resize(fNumberOfTracks);
+  fTrackCharge.resize(fNumberOfTracks);
+  fTrackPOItype.resize(fNumberOfTracks);
+  fTrackSubevent.resize(fNumberOfTracks);
+
+  for (Int_t i=0; i<fNumberOfTracks; i++)
+  {
+    AliFlowTrackSimple* track = GetTrack(i);
+    UInt_t poiType = 0;
+    UInt_t subevent = 0;
+    if (track)
+    {
+      fTrackPhi[i] = track->Phi();
+      fTrackPt[i] = track->Pt();
+      fTrackEta[i] = track->Eta();
+      fTrackWeight[i] = track->Weight();
+      fTrackCharge[i] = track->Charge();
+      for (Int_t j=0; j<32; j++)
+      {
+        if (track->InPOISelection(j)) poiType |= (1u<<j);
+        if (track->InSubevent(j)) subevent |= (1u<<j);
+      }
+    }
+    else
+    {
+      fTrackPhi[i] = 0.;
+      fTrackPt[i] = 0.;
+      fTrackEta[i] = 0.;
+      fTrackWeight[i] = 0.;
+      fTrackCharge[i] = 0;
+    }
+    fTrackPOItype[i] = poiType;
+    fTrackSubevent[i] = subevent;
+  }
+
+  fTrackArraysFilled = kTRUE;
+  return fNumberOfTracks;
+}
+
+//-----------------------------------------------------------------------
+const Double_t* AliFlowEventSimple::GetTrackPhiArray() const
+{
+  //phi of the tracks, valid after FillTrackArrays()
+  return fTrackPhi.empty() ? NULL : &fTrackPhi[0];
+}
+
+//-----------------------------------------------------------------------
+const Double_t* AliFlowEventSimple::GetTrackPtArray() const
+{
+  //pt of the tracks, valid after FillTrackArrays()
+  return fTrackPt.empty() ? NULL : &fTrackPt[0];
+}
+
+//-----------------------------------------------------------------------
+const Double_t* AliFlowEventSimple::GetTrackEtaArray() const
+{
+  //eta of the tracks, valid after FillTrackArrays()
+  return fTrackEta.empty() ? NULL : &fTrackEta[0];
+}
+
+//-----------------------------------------------------------------------
+const Double_t* AliFlowEventSimple::GetTrackWeightArray() const
+{
+  //weight of the tracks, valid after FillTrackArrays()
+  return fTrackWeight.empty() ? NULL : &fTrackWeight[0];
+}
+
+//-----------------------------------------------------------------------
+const Int_t* AliFlowEventSimple::GetTrackChargeArray() const
+{
+  //charge of the tracks, valid after FillTrackArrays()
+  return fTrackCharge.empty() ? NULL : &fTrackCharge[0];
+}
+
+//-----------------------------------------------------------------------
+const UInt_t* AliFlowEventSimple::GetTrackPOItypeArray() const
+{
+  //POI type bits of the tracks (bit i set if InPOISelection(i)), valid after FillTrackArrays()
+  return fTrackPOItype.empty() ? NULL : &fTrackPOItype[0];
+}
+
+//-----------------------------------------------------------------------
+const UInt_t* AliFlowEventSimple::GetTrackSubeventArray() const
+{
+  //subevent bits of the tracks (bit i set if InSubevent(i)), valid after FillTrackArrays()
+  return fTrackSubevent.empty() ? NULL : &fTrackSubevent[0];
 }
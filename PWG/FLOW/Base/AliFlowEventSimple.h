@@ -16,6 +16,7 @@
 #ifndef ALIFLOWEVENTSIMPLE_H
 #define ALIFLOWEVENTSIMPLE_H
 
+#include <vector>
 #include "TObject.h"
 #include "TParameter.h"
 #include "TMath.h"
@@ -82,7 +83,7 @@ class AliFlowEventSimple: public TObject {
   Bool_t   IsSetMCReactionPlaneAngle() const        { return fMCReactionPlaneAngleIsSet; }
   void     SetAfterBurnerPrecision(Double_t p)      { fAfterBurnerPrecision=p; }
   Double_t GetAfterBurnerPrecision() const          { return fAfterBurnerPrecision; }
-  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; }
+  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; fTrackArraysFilled=kFALSE; }
   Bool_t   IsUserModified() const                   { return fUserModified; }
   void     SetShuffleTracks(Bool_t b)               {fShuffleTracks=b;}
   void     ShuffleTracks();
@@ -112,11 +113,23 @@ class AliFlowEventSimple: public TObject {
   static TF1* SimplePtDepV2();
   static TF2* SimplePtEtaDepV2();
 
-  AliFlowTrackSimple* GetTrack(Int_t i);
+  AliFlowTrackSimple* GetTrack(Int_t i);    // direct track edits require InvalidateTrackArrays()
   void AddTrack( AliFlowTrackSimple* track );
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
 
+  // contiguous per-track arrays, in GetTrack(i) order, for fast iteration in the analysis methods;
+  // filled on first request after the event changed and reused (also their memory) by all methods
+  Int_t           FillTrackArrays();
+  void            InvalidateTrackArrays()           { fTrackArraysFilled=kFALSE; }
+  const Double_t* GetTrackPhiArray() const;
+  const Double_t* GetTrackPtArray() const;
+  const Double_t* GetTrackEtaArray() const;
+  const Double_t* GetTrackWeightArray() const;
+  const Int_t*    GetTrackChargeArray() const;
+  const UInt_t*   GetTrackPOItypeArray() const;     // bit i set if InPOISelection(i), bit 0 = RP
+  const UInt_t*   GetTrackSubeventArray() const;    // bit i set if InSubevent(i)
+
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void GetZDC2Qsub(AliFlowVector* Qarray);
@@ -208,8 +221,16 @@ class AliFlowEventSimple: public TObject {
  private:
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
   Int_t*                  fNumberOfPOIs;          //[fNumberOfPOItypes] number of tracks that have passed the POI selection
-
-  ClassDef(AliFlowEventSimple,7)
+  Bool_t                  fTrackArraysFilled;     //! per-track arrays are up to date
+  std::vector<Double_t>   fTrackPhi;              //! phi per track, GetTrack(i) order
+  std::vector<Double_t>   fTrackPt;               //! pt per track
+  std::vector<Double_t>   fTrackEta;              //! eta per track
+  std::vector<Double_t>   fTrackWeight;           //! weight per track
+  std::vector<Int_t>      fTrackCharge;           //! charge per track
+  std::vector<UInt_t>     fTrackPOItype;          //! POI type bits per track
+  std::vector<UInt_t>     fTrackSubevent;         //! subevent bits per track
+
+  ClassDef(AliFlowEventSimple,8)
 };
 
 #endif
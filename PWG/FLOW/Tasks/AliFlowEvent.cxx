@@ -832,6 +832,7 @@ void AliFlowEvent::FindDaughters(Bool_t keepDaughtersInRPselection)
   //each flow track holds it's esd track index as well as its daughters esd index.
   //fill the array of daughters for every track with the pointers to flow tracks
   //to associate the mothers with daughters directly
+  InvalidateTrackArrays();
   for (Int_t iTrack=0; iTrack<fMothersCollection->GetEntriesFast(); iTrack++)
   {
     AliFlowTrack* mother = static_cast<AliFlowTrack*>(fMothersCollection->At(iTrack));
@@ -1018,6 +1019,7 @@ void AliFlowEvent::InsertTrack(AliFlowTrack *track) {
   // adds a flow track at the end of the container
   AliFlowTrack *pTrack = ReuseTrack( fNumberOfTracks++ );
   *pTrack = *track;
+  InvalidateTrackArrays();
   if (track->GetNDaughters()>0)
   {
     fMothersCollection->Add(pTrack);
@@ -0,0 +1,398 @@
+#ifndef ALIMULTIPARTICLECORRELATOR_H
+#define ALIMULTIPARTICLECORRELATOR_H
+/* Copyright(c) 1998-2021, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <cmath>
+#include <complex>
+#include <vector>
+#include <Rtypes.h>
+
+/**
+ * @file AliMultiParticleCorrelator.h
+ * @brief Header-only Q-vector and multi-particle correlator engine
+ * @ingroup Correlator
+ *
+ * Shared building blocks for the generic framework of multi-particle
+ * correlations (A. Bilandzic et al., Phys. Rev. C 89 (2014) 064904):
+ *
+ * - AliQnVectorSet: fixed-size Q-vectors Q_{n,p} for harmonics 0..kMaxHarmonic
+ *   and weight powers 0..kMaxPower, stored as flat real/imaginary arrays with
+ *   the harmonic as fastest index, so the per-track update is a plain loop
+ *   the compiler can vectorise. No heap allocation is done after construction.
+ * - AliQnVectorSetBinned: one AliQnVectorSet per pt (or eta) bin for
+ *   differential particles of interest. Memory is allocated once in SetNBins().
+ * - AliMultiParticleCorrelator: stateless correlator kernels. The
+ *   integrated n-particle correlator uses the recursion by K. Gulbrandsen,
+ *   the differential one the POI/reference/overlap recursion of the generic
+ *   flow framework (https://arxiv.org/abs/1312.3572). Both work in place on
+ *   caller-provided harmonic arrays and never allocate. Eta gaps and
+ *   subevents are obtained by multiplying correlators of the separate
+ *   regions, each filled into its own Q-vector set.
+ *
+ * The kernels are templates on the Q-vector type: any class with a method
+ *
+ * ~~~{.cxx}
+ * std::complex<Double_t> Get(Int_t n, Int_t p) const;
+ * ~~~
+ *
+ * returning Q_{n,p} (and its complex conjugate for n < 0) can be used. The
+ * adapters AliQnArrayView and AliQnFunctionView expose existing TComplex
+ * based Q-vector storage to the kernels without copying, so analyses can
+ * move to the shared kernels one at a time.
+ */
+
+/**
+ * @class AliMultiParticleCorrelator
+ * @brief Stateless kernels for Q-vector filling and multi-particle correlators
+ */
+class AliMultiParticleCorrelator {
+public:
+  enum {
+    kMaxParticles = 16        ///< Maximum order of the correlators handled by the kernels
+  };
+
+  /**
+   * Calculate cos(n phi) and sin(n phi) for n = 0..nMax with one call to
+   * sin/cos and the angle addition recurrence.
+   * @param[in] phi Azimuthal angle
+   * @param[in] nMax Highest harmonic
+   * @param[out] cosn Array of at least nMax+1 elements
+   * @param[out] sinn Array of at least nMax+1 elements
+   */
+  static void Harmonics(Double_t phi, Int_t nMax, Double_t *cosn, Double_t *sinn) {
+    cosn[0] = 1.;
+    sinn[0] = 0.;
+    if(nMax < 1) return;
+    const Double_t c1 = std::cos(phi), s1 = std::sin(phi);
+    cosn[1] = c1;
+    sinn[1] = s1;
+    for(Int_t n = 2; n <= nMax; n++) {
+      cosn[n] = cosn[n-1] * c1 - sinn[n-1] * s1;
+      sinn[n] = sinn[n-1] * c1 + cosn[n-1] * s1;
+    }
+  }
+
+  /**
+   * Integrated n-particle correlator <n>_{h1,...,hn} (not normalised) using
+   * the recursion by K. Gulbrandsen (gulbrand@nbi.dk). The harmonic array is
+   * permuted during the calculation and restored on return.
+   * @param[in] q Q-vectors with Q_{h,p} for |h| up to sum |h_i| and p up to n
+   * @param[in] n Order of the correlator
+   * @param[in,out] harmonic Array of n harmonics
+   * @param[in] mult Weight power (internal)
+   * @param[in] skip Recursion bookkeeping (internal)
+   * @return Correlator numerator
+   */
+  template <class Q>
+  static std::complex<Double_t> Recursion(const Q &q, Int_t n, Int_t *harmonic, Int_t mult = 1, Int_t skip = 0) {
+    const Int_t nm1 = n - 1;
+    std::complex<Double_t> c(q.Get(harmonic[nm1], mult));
+    if(nm1 == 0) return c;
+    c *= Recursion(q, nm1, harmonic);
+    if(nm1 == skip) return c;
+
+    const Int_t multp1 = mult + 1;
+    const Int_t nm2 = n - 2;
+    Int_t counter1 = 0;
+    Int_t hhold = harmonic[counter1];
+    harmonic[counter1] = harmonic[nm2];
+    harmonic[nm2] = hhold + harmonic[nm1];
+    std::complex<Double_t> c2(Recursion(q, nm1, harmonic, multp1, nm2));
+    Int_t counter2 = n - 3;
+    while(counter2 >= skip) {
+      harmonic[nm2] = harmonic[counter1];
+      harmonic[counter1] = hhold;
+      ++counter1;
+      hhold = harmonic[counter1];
+      harmonic[counter1] = harmonic[nm2];
+      harmonic[nm2] = hhold + harmonic[nm1];
+      c2 += Recursion(q, nm1, harmonic, multp1, counter2);
+      --counter2;
+    }
+    harmonic[nm2] = harmonic[counter1];
+    harmonic[counter1] = hhold;
+
+    if(mult == 1) return c - c2;
+    return c - Double_t(mult) * c2;
+  }
+
+  /**
+   * Integrated n-particle correlator for a constant list of harmonics
+   * @param[in] q Q-vectors
+   * @param[in] n Order of the correlator (at most kMaxParticles)
+   * @param[in] harmonics Array of n harmonics
+   * @return Correlator numerator, 0 if n is out of range
+   */
+  template <class Q>
+  static std::complex<Double_t> Correlator(const Q &q, Int_t n, const Int_t *harmonics) {
+    if(n < 1 || n > kMaxParticles) return std::complex<Double_t>(0., 0.);
+    Int_t harmonic[kMaxParticles];
+    for(Int_t i = 0; i < n; i++) harmonic[i] = harmonics[i];
+    return Recursion(q, n, harmonic);
+  }
+
+  /**
+   * Differential n-particle correlator with the first particle taken from
+   * the POI Q-vectors and the remaining ones from the reference Q-vectors.
+   * Self-correlations between POIs and reference particles are removed with
+   * the overlap Q-vectors; pass NULL when the regions do not overlap. Same
+   * conventions as the generic flow framework: the overlap replaces the POI
+   * as soon as the POI weight power exceeds one. Harmonics and powers are
+   * modified in place and restored on return.
+   * @param[in] qpoi POI Q-vectors
+   * @param[in] qref Reference Q-vectors
+   * @param[in] qovl Overlap Q-vectors, or NULL
+   * @param[in] n Order of the correlator
+   * @param[in,out] hars Array of n harmonics
+   * @param[in,out] pows Array of n weight powers
+   * @return Correlator numerator
+   */
+  template <class Q>
+  static std::complex<Double_t> DifferentialRecursion(const Q *qpoi, const Q &qref, const Q *qovl, Int_t n, Int_t *hars, Int_t *pows) {
+    if(pows[0] != 1 && qovl) qpoi = qovl;
+    if(n < 2) return qpoi->Get(hars[0], pows[0]);
+    if(n < 3) {
+      std::complex<Double_t> c = qpoi->Get(hars[0], pows[0]) * qref.Get(hars[1], pows[1]);
+      if(qovl) c -= qovl->Get(hars[0] + hars[1], pows[0] + pows[1]);
+      return c;
+    }
+    const Int_t nm1 = n - 1;
+    const Int_t harlast = hars[nm1], powlast = pows[nm1];
+    std::complex<Double_t> c = DifferentialRecursion(qpoi, qref, qovl, nm1, hars, pows) * qref.Get(harlast, powlast);
+    Int_t degeneracy = 1;
+    for(Int_t i = nm1 - 1; i >= 0; i--) {
+      // permutations of the same (harmonic, power) pair give identical terms
+      if(i > 2 && hars[i] == hars[i-1] && pows[i] == pows[i-1]) {
+        degeneracy++;
+        continue;
+      }
+      hars[i] += harlast;
+      pows[i] += powlast;
+      std::complex<Double_t> subtract = DifferentialRecursion(qpoi, qref, qovl, nm1, hars, pows);
+      if(degeneracy > 1) {
+        subtract *= Double_t(degeneracy);
+        degeneracy = 1;
+      }
+      c -= subtract;
+      hars[i] -= harlast;
+      pows[i] -= powlast;
+    }
+    return c;
+  }
+
+  /**
+   * Differential n-particle correlator with unit weight powers for a
+   * constant list of harmonics
+   * @param[in] qpoi POI Q-vectors
+   * @param[in] qref Reference Q-vectors
+   * @param[in] qovl Overlap Q-vectors, or NULL
+   * @param[in] n Order of the correlator (at most kMaxParticles)
+   * @param[in] harmonics Array of n harmonics, POI first
+   * @return Correlator numerator, 0 if n is out of range
+   */
+  template <class Q>
+  static std::complex<Double_t> DifferentialCorrelator(const Q &qpoi, const Q &qref, const Q *qovl, Int_t n, const Int_t *harmonics) {
+    if(n < 1 || n > kMaxParticles) return std::complex<Double_t>(0., 0.);
+    Int_t hars[kMaxParticles], pows[kMaxParticles];
+    for(Int_t i = 0; i < n; i++) {
+      hars[i] = harmonics[i];
+      pows[i] = 1;
+    }
+    return DifferentialRecursion(&qpoi, qref, qovl, n, hars, pows);
+  }
+};
+
+/**
+ * @class AliQnVectorSet
+ * @brief Fixed-size set of Q-vectors Q_{n,p} = sum_i w_i^p exp(i n phi_i)
+ *
+ * Harmonics n = 0..kMaxHarmonic and weight powers p = 0..kMaxPower. The
+ * layout is [p][n], so filling one track runs over contiguous memory.
+ */
+template <Int_t kMaxHarmonic, Int_t kMaxPower>
+class AliQnVectorSet {
+public:
+  enum {
+    kNHarmonics = kMaxHarmonic + 1,     ///< Number of stored harmonics
+    kNPowers = kMaxPower + 1            ///< Number of stored weight powers
+  };
+
+  AliQnVectorSet(): fEntries(0) { Reset(); }
+
+  /**
+   * Set all Q-vectors to 0
+   */
+  void Reset() {
+    for(Int_t i = 0; i < kNHarmonics * kNPowers; i++) {
+      fRe[i] = 0.;
+      fIm[i] = 0.;
+    }
+    fEntries = 0;
+  }
+
+  /**
+   * Add one particle
+   * @param[in] phi Azimuthal angle
+   * @param[in] weight Particle weight
+   */
+  void Fill(Double_t phi, Double_t weight = 1.) {
+    Double_t cosn[kNHarmonics], sinn[kNHarmonics];
+    AliMultiParticleCorrelator::Harmonics(phi, kMaxHarmonic, cosn, sinn);
+    Double_t wp = 1.;
+    for(Int_t p = 0; p < kNPowers; p++) {
+      Double_t *re = fRe + p * kNHarmonics, *im = fIm + p * kNHarmonics;
+      for(Int_t n = 0; n < kNHarmonics; n++) {
+        re[n] += wp * cosn[n];
+        im[n] += wp * sinn[n];
+      }
+      wp *= weight;
+    }
+    fEntries++;
+  }
+
+  /**
+   * Add one particle which is both POI and reference particle with
+   * different weights: powers above one use weight * secondWeight^(p-1).
+   * A non-positive second weight falls back to Fill(phi, weight).
+   * @param[in] phi Azimuthal angle
+   * @param[in] weight Weight used for the power 1
+   * @param[in] secondWeight Weight used for the higher powers
+   */
+  void Fill(Double_t phi, Double_t weight, Double_t secondWeight) {
+    if(secondWeight <= 0.) {
+      Fill(phi, weight);
+      return;
+    }
+    Double_t cosn[kNHarmonics], sinn[kNHarmonics];
+    AliMultiParticleCorrelator::Harmonics(phi, kMaxHarmonic, cosn, sinn);
+    Double_t wp = 1.;
+    for(Int_t p = 0; p < kNPowers; p++) {
+      Double_t *re = fRe + p * kNHarmonics, *im = fIm + p * kNHarmonics;
+      for(Int_t n = 0; n < kNHarmonics; n++) {
+        re[n] += wp * cosn[n];
+        im[n] += wp * sinn[n];
+      }
+      wp *= p ? secondWeight : weight;
+    }
+    fEntries++;
+  }
+
+  /**
+   * Access to Q_{n,p}, using Q_{-n,p} = Q_{n,p}^*. No range check.
+   * @param[in] n Harmonic, |n| <= kMaxHarmonic
+   * @param[in] p Weight power, 0 <= p <= kMaxPower
+   * @return Q-vector
+   */
+  std::complex<Double_t> Get(Int_t n, Int_t p) const {
+    if(n >= 0) return std::complex<Double_t>(fRe[p * kNHarmonics + n], fIm[p * kNHarmonics + n]);
+    return std::complex<Double_t>(fRe[p * kNHarmonics - n], -fIm[p * kNHarmonics - n]);
+  }
+
+  /**
+   * @return Number of particles added since the last reset
+   */
+  Int_t GetEntries() const { return fEntries; }
+
+private:
+  Double_t fRe[kNHarmonics * kNPowers];     ///< Real parts, [p][n]
+  Double_t fIm[kNHarmonics * kNPowers];     ///< Imaginary parts, [p][n]
+  Int_t    fEntries;                        ///< Number of particles
+};
+
+/**
+ * @class AliQnVectorSetBinned
+ * @brief Q-vector sets for differential particles of interest
+ */
+template <Int_t kMaxHarmonic, Int_t kMaxPower>
+class AliQnVectorSetBinned {
+public:
+  typedef AliQnVectorSet<kMaxHarmonic, kMaxPower> QnSet_t;
+
+  AliQnVectorSetBinned(): fBins(), fFilled() {}
+
+  /**
+   * Allocate the Q-vector sets. Call once at initialisation.
+   * @param[in] nbins Number of bins
+   */
+  void SetNBins(Int_t nbins) {
+    fBins.assign(nbins, QnSet_t());
+    fFilled.assign(nbins, 0);
+  }
+
+  /**
+   * Reset only the bins which were filled in the current event
+   */
+  void Reset() {
+    for(size_t i = 0; i < fBins.size(); i++) {
+      if(!fFilled[i]) continue;
+      fBins[i].Reset();
+      fFilled[i] = 0;
+    }
+  }
+
+  /**
+   * Add one particle to a bin; out-of-range bins are ignored
+   * @param[in] bin Bin index
+   * @param[in] phi Azimuthal angle
+   * @param[in] weight Particle weight
+   */
+  void Fill(Int_t bin, Double_t phi, Double_t weight = 1.) {
+    if(bin < 0 || bin >= static_cast<Int_t>(fBins.size())) return;
+    fBins[bin].Fill(phi, weight);
+    fFilled[bin] = 1;
+  }
+
+  Int_t GetNBins() const { return fBins.size(); }
+  Bool_t IsBinFilled(Int_t bin) const { return fFilled[bin] != 0; }
+  const QnSet_t &GetBin(Int_t bin) const { return fBins[bin]; }
+
+private:
+  std::vector<QnSet_t> fBins;           ///< Q-vector sets per bin
+  std::vector<Char_t>  fFilled;         ///< Bins filled in the current event
+};
+
+/**
+ * @class AliQnArrayView
+ * @brief Adapter presenting a 2D array q[n][p] of TComplex-like values
+ * (with Re() and Im()) to the correlator kernels
+ */
+template <class TComplexLike>
+class AliQnArrayView {
+public:
+  /**
+   * @param[in] q Pointer to the first element, q[n*stride + p] = Q_{n,p}
+   * @param[in] stride Number of weight powers per harmonic
+   */
+  AliQnArrayView(const TComplexLike *q, Int_t stride): fQ(q), fStride(stride) {}
+
+  std::complex<Double_t> Get(Int_t n, Int_t p) const {
+    if(n >= 0) return std::complex<Double_t>(fQ[n * fStride + p].Re(), fQ[n * fStride + p].Im());
+    return std::complex<Double_t>(fQ[-n * fStride + p].Re(), -fQ[-n * fStride + p].Im());
+  }
+
+private:
+  const TComplexLike *fQ;               ///< Q-vector array
+  Int_t               fStride;          ///< Number of powers per harmonic
+};
+
+/**
+ * @class AliQnFunctionView
+ * @brief Adapter presenting any accessor F(n, p) returning a TComplex-like
+ * value (already conjugated for n < 0) to the correlator kernels
+ */
+template <class F>
+class AliQnFunctionView {
+public:
+  explicit AliQnFunctionView(const F &accessor): fAccessor(accessor) {}
+
+  std::complex<Double_t> Get(Int_t n, Int_t p) const {
+    const auto q = fAccessor(n, p);
+    return std::complex<Double_t>(q.Re(), q.Im());
+  }
+
+private:
+  F fAccessor;                          ///< Q-vector accessor
+};
+
+#endif /* ALIMULTIPARTICLECORRELATOR_H */
@@ -69,7 +69,16 @@ fCutRegistry(0x0),
 fEvent(0x0),
 fMCEvent(0x0),
 fHistogramToDisable(0x0),
-fHasMC(kFALSE)
+fHasMC(kFALSE),
+fSlotWhat(),
+fSlotName(),
+fSlotIsMC(),
+fSlotIndex(),
+fSlotPaths(),
+fSlotPathIndex(),
+fSlotObjects(),
+fSlotResolved(),
+fCurrentSlotPath(-1)
 {
  /// default ctor
 }
@@ -429,6 +438,124 @@ Int_t AliAnalysisMuMuBase::GetNbins(Double_t xmin, Double_t xmax, Double_t xstep
   return TMath::Nint(TMath::Abs((xmax-xmin)/xstep));
 }
 
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::RegisterHistoSlot(const char* what, const char* histoname, Bool_t mc)
+{
+  /** Assign a dense integer slot to the histogram histoname living below the
+   * eventSelection/triggerClassName/centrality/what path (or the corresponding
+   * MC input path if mc is true).
+   *
+   * Meant to be called from \ref DefineHistogramCollection. Registering the same
+   * histogram twice returns the same slot. The slot is valid for every
+   * eventSelection/triggerClassName/centrality combination : the actual object is
+   * resolved once per combination (see \ref SelectHistoSlotPath and \ref SlotObject),
+   * so that the fill methods no longer have to build and hash a path string
+   * for each entry. The layout of the histogram collection is unchanged.
+   */
+
+  std::string key(mc ? "1" : "0");
+  key += "/";
+  key += what;
+  key += "/";
+  key += histoname;
+
+  std::map<std::string,Int_t>::const_iterator it = fSlotIndex.find(key);
+  if ( it != fSlotIndex.end() ) return it->second;
+
+  Int_t slot = static_cast<Int_t>(fSlotName.size());
+  fSlotWhat.push_back(what);
+  fSlotName.push_back(histoname);
+  fSlotIsMC.push_back(mc);
+  fSlotIndex[key] = slot;
+
+  return slot;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::SelectHistoSlotPath(const char* eventSelection,
+                                              const char* triggerClassName,
+                                              const char* centrality)
+{
+  /// Select the path used to resolve the histogram slots.
+  /// Called once per eventSelection/triggerClassName/centrality and per event by AliAnalysisTaskMuMu
+
+  TString path(BuildPath(eventSelection,triggerClassName,centrality));
+  std::string key(path.Data());
+
+  std::map<std::string,Int_t>::const_iterator it = fSlotPathIndex.find(key);
+  if ( it != fSlotPathIndex.end() )
+  {
+    fCurrentSlotPath = it->second;
+    return;
+  }
+
+  fCurrentSlotPath = static_cast<Int_t>(fSlotPaths.size());
+  fSlotPaths.push_back(key);
+  fSlotPathIndex[key] = fCurrentSlotPath;
+  fSlotObjects.push_back(std::vector<TObject*>());
+  fSlotResolved.push_back(std::vector<Bool_t>());
+}
+
+//_____________________________________________________________________________
+TObject* AliAnalysisMuMuBase::SlotObject(Int_t slot)
+{
+  /// Get the object registered in slot for the currently selected path.
+  /// The lookup in the histogram collection is only done the first time.
+
+  if ( slot < 0 || slot >= static_cast<Int_t>(fSlotName.size()) ) return 0x0;
+  if ( fCurrentSlotPath < 0 || !fHistogramCollection ) return 0x0;
+
+  std::vector<TObject*>& objects = fSlotObjects[fCurrentSlotPath];
+  std::vector<Bool_t>& resolved = fSlotResolved[fCurrentSlotPath];
+
+  if ( slot >= static_cast<Int_t>(objects.size()) )
+  {
+    objects.resize(fSlotName.size(),0x0);
+    resolved.resize(fSlotName.size(),kFALSE);
+  }
+
+  if ( !resolved[slot] )
+  {
+    TString identifier(fSlotPaths[fCurrentSlotPath].c_str());
+    if ( fSlotWhat[slot].size() > 0 )
+    {
+      identifier += fSlotWhat[slot].c_str();
+      identifier += "/";
+    }
+    if ( fSlotIsMC[slot] ) identifier.Prepend(Form("/%s",MCInputPrefix()));
+
+    objects[slot] = fHistogramCollection->GetObject(identifier.Data(),fSlotName[slot].c_str());
+    resolved[slot] = kTRUE;
+  }
+
+  return objects[slot];
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::PairCutIndex(const char* pairCutName) const
+{
+  /// Get the index of the pair cut combination named pairCutName in the cut registry
+  /// (the name pointer given to FillHistosForPair is compared first, so that no string
+  /// comparison is needed in the usual case). Returns -1 if not found.
+
+  if ( !fCutRegistry ) return -1;
+
+  const TObjArray* cuts = fCutRegistry->GetCutCombinations(AliAnalysisMuMuCutElement::kTrackPair);
+  if ( !cuts ) return -1;
+
+  for ( Int_t i = 0; i <= cuts->GetLast(); ++i )
+  {
+    if ( cuts->UncheckedAt(i)->GetName() == pairCutName ) return i;
+  }
+
+  for ( Int_t i = 0; i <= cuts->GetLast(); ++i )
+  {
+    if ( strcmp(cuts->UncheckedAt(i)->GetName(),pairCutName) == 0 ) return i;
+  }
+
+  return -1;
+}
+
 //_____________________________________________________________________________
 TH1* AliAnalysisMuMuBase::Histo(const char* eventSelection, const char* triggerClassName, const char* histoname)
 {
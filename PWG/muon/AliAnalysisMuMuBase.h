@@ -13,6 +13,9 @@
 #include "TObject.h"
 #include "TString.h"
 #include "TProfile.h"
+#include <map>
+#include <string>
+#include <vector>
 
 class AliCounterCollection;
 class AliAnalysisMuMuBinning;
@@ -103,6 +106,11 @@ public:
 
   void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; }
 
+  /** Select the eventSelection/triggerClassName/centrality path used to resolve
+   * histogram slots (see \ref RegisterHistoSlot) until the next call.
+   */
+  void SelectHistoSlotPath(const char* eventSelection, const char* triggerClassName, const char* centrality);
+
 protected:
 
   TString BuildPath(const char* eventSelection, const char* triggerClassName, const char* centrality,
@@ -194,6 +202,14 @@ protected:
 
   Int_t GetNbins(Double_t xmin, Double_t xmax, Double_t xstep);
 
+  Int_t RegisterHistoSlot(const char* what, const char* histoname, Bool_t mc=kFALSE);
+
+  TObject* SlotObject(Int_t slot);
+  TH1* SlotHisto(Int_t slot) { return static_cast<TH1*>(SlotObject(slot)); }
+  TProfile* SlotProf(Int_t slot) { return static_cast<TProfile*>(SlotObject(slot)); }
+
+  Int_t PairCutIndex(const char* pairCutName) const;
+
   AliCounterCollection* CounterCollection() const { return fEventCounters; }
   AliMergeableCollection* HistogramCollection() const { return fHistogramCollection; }
   const AliAnalysisMuMuBinning* Binning() const { return fBinning; }
@@ -215,7 +231,17 @@ private:
   TList* fHistogramToDisable; // list of regexp of histo name to disable
   Bool_t fHasMC; // whether or not we're dealing with MC data
 
-  ClassDef(AliAnalysisMuMuBase,1) // base class for a companion class to AliAnalysisMuMu
+  std::vector<std::string> fSlotWhat; //! sub-path (e.g. cut name) of each registered slot
+  std::vector<std::string> fSlotName; //! histogram name of each registered slot
+  std::vector<Bool_t> fSlotIsMC; //! whether the slot lives below the MC input prefix
+  std::map<std::string,Int_t> fSlotIndex; //! slot lookup by what/name key (registration only)
+  std::vector<std::string> fSlotPaths; //! eventSelection/trigger/centrality of each path
+  std::map<std::string,Int_t> fSlotPathIndex; //! path lookup by key
+  std::vector<std::vector<TObject*> > fSlotObjects; //! resolved objects, per path and slot
+  std::vector<std::vector<Bool_t> > fSlotResolved; //! whether the object was looked up already
+  Int_t fCurrentSlotPath; //! path selected by SelectHistoSlotPath
+
+  ClassDef(AliAnalysisMuMuBase,2) // base class for a companion class to AliAnalysisMuMu
 };
 
 #endif
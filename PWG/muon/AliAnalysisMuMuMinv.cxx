@@ -28,6 +28,8 @@
 #include "AliMergeableCollection.h"
 #include "AliAnalysisMuonUtility.h"
 #include "TParameter.h"
+#include "AliAnalysisMuMuCutRegistry.h"
+#include "AliAnalysisMuMuCutElement.h"
 #include <cassert>
 
 ClassImp(AliAnalysisMuMuMinv)
@@ -49,7 +51,9 @@ fMinvBinSize(0.025),
 fMinvMin(0.0),
 fMinvMax(16.0),
 fmcptcutmin(0.0),
-fmcptcutmax(12.0)
+fmcptcutmax(12.0),
+fPairSlots(),
+fPairSlotStride(0)
 {
   // FIXME ? find the AccxEff histogram from HistogramCollection()->Histo("/EXCHANGE/JpsiAccEff")
 
@@ -77,14 +81,17 @@ AliAnalysisMuMuMinv::DefineHistogramCollection(const char* eventSelection,
 {
   /// Define the histograms this analysis will use
 
+  // no bins defined by the external steering macro, use our own defaults
+  if (!fBinsToFill) SetBinsToFill("psi","integrated,ptvsy,yvspt,pt,y,phi,ntrcorr,ntr,nch,v0a,v0acorr,v0ccorr,v0mcorr");
+
+  // Assign the histogram slots used in FillHistosForPair (only done once)
+  RegisterPairSlots();
+
   // Check if histo is not already here
   if ( ExistSemaphoreHistogram(eventSelection,triggerClassName,centrality) ) return;
 
   CreateSemaphoreHistogram(eventSelection,triggerClassName,centrality);
 
-  // no bins defined by the external steering macro, use our own defaults
-  if (!fBinsToFill) SetBinsToFill("psi","integrated,ptvsy,yvspt,pt,y,phi,ntrcorr,ntr,nch,v0a,v0acorr,v0ccorr,v0mcorr");
-
   // mass range
   Double_t minvMin = fMinvMin;
   Double_t minvMax = fMinvMax;
@@ -328,11 +335,17 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   // Usual cuts
   if (!AliAnalysisMuonUtility::IsMuonTrack(&tracki) || !AliAnalysisMuonUtility::IsMuonTrack(&trackj) ) return;
 
-  // Get total charge in order to get the correct histo name
+  // Get the histogram slots for this pair cut
+  const Int_t* slots = PairSlots(pairCutName);
+  if ( !slots ) return;
+
+  // Get total charge in order to get the correct histo slot
   Double_t PairCharge = tracki.Charge() + trackj.Charge();
-  TString scharge  = "";
-  if( PairCharge == +2 )      scharge = "PP";
-  else if( PairCharge == -2 ) scharge = "MM";
+  Int_t iCharge(0);
+  if( PairCharge == +2 )      iCharge = 1;
+  else if( PairCharge == -2 ) iCharge = 2;
+  Int_t iMix = IsMixedHisto ? 1 : 0;
+  Int_t variant = iCharge*2 + iMix;
 
   // Pointers in case running on MC
   Int_t labeli               = 0;
@@ -342,13 +355,6 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   TLorentzVector             * pair4MomentumMC(0x0);
   Double_t inputWeightMC(1.);
 
-  // Usefull string :)
-  TString smix = IsMixedHisto ? "Mix" : "";
-
-  // Create proxy in AliMergeableCollection
-  AliMergeableCollectionProxy* proxy = HistogramCollection()->CreateProxy(BuildPath(eventSelection,triggerClassName,centrality,pairCutName));
-  AliMergeableCollectionProxy* mcProxy(0x0); // to be set later maybe
-
   // Construct dimuons vector
   TLorentzVector pi(tracki.Px(),tracki.Py(),tracki.Pz(),
                     TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+tracki.P()*tracki.P()));
@@ -356,6 +362,9 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
                                TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+trackj.P()*trackj.P()));
   pair4Momentum += pi;
 
+  // MC pair, set later maybe
+  TLorentzVector mcpj;
+
   // Make sure we have an associated tracks in simulation stack if running on MC (only opposite charge muons)
   if( HasMC() && !IsMixedHisto && PairCharge==0){
 
@@ -373,47 +382,23 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     // Check if first track is a muon
     mcTracki = MCEvent()->GetTrack(labeli);
     if(!mcTracki) return;
-    if ( TMath::Abs(mcTracki->PdgCode()) != 13 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if ( TMath::Abs(mcTracki->PdgCode()) != 13 ) return;
 
     // Check if second track is a muon
     mcTrackj = MCEvent()->GetTrack(labelj);
     if(!mcTrackj) return;
-    if ( TMath::Abs(mcTrackj->PdgCode()) != 13 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if ( TMath::Abs(mcTrackj->PdgCode()) != 13 ) return;
 
     // Check if tracks has the same mother
     Int_t currMotheri = mcTracki->GetMother();
     Int_t currMotherj = mcTrackj->GetMother();
-    if( currMotheri!=currMotherj ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
-    if( currMotheri<0 ) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if( currMotheri!=currMotherj ) return;
+    if( currMotheri<0 ) return;
 
     // Check if mother is J/psi
     AliMCParticle* mother = static_cast<AliMCParticle*>(MCEvent()->GetTrack(currMotheri));
-    if(!mother){
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
-    if(mother->PdgCode() !=443) {
-      delete proxy;
-      delete mcProxy;
-      return;
-    }
+    if(!mother) return;
+    if(mother->PdgCode() !=443) return;
 
     // Weight tracks if specified
     if(!fWeightMuon)      inputWeightMC = WeightPairDistribution(mother->Pt(),mother->Y());
@@ -423,16 +408,8 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
 
     if(!mcTracki || !mcTrackj){
       AliError("Miss one or several MC track");
-      delete proxy;
-      delete mcProxy;
       return;
     }
-
-    // Create proxy for MC
-    mcProxy = HistogramCollection()->CreateProxy(BuildMCPath(eventSelection,triggerClassName,centrality,pairCutName));
-    TLorentzVector mcpi(mcTracki->Px(),mcTracki->Py(),mcTracki->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTracki->P()*mcTracki->P()));
-    TLorentzVector mcpj(mcTrackj->Px(),mcTrackj->Py(),mcTrackj->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTrackj->P()*mcTrackj->P()));
-    mcpj+=mcpi;
   }
 
   // Weight tracks if specified
@@ -440,26 +417,27 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   if(!fWeightMuon)      inputWeight = WeightPairDistribution(pair4Momentum.Pt(),pair4Momentum.Rapidity());
   else if(fWeightMuon)  inputWeight = WeightMuonDistribution(tracki.Pt()) * WeightMuonDistribution(trackj.Pt());
 
-  // Fill some distribution histos
-  if ( !IsHistogramDisabled("Pt")  ) {
+  // Fill some distribution histos (disabled histograms have no slot)
+  THnSparse* hs(0x0);
+  if ( ( hs = static_cast<THnSparse*>(SlotObject(slots[kSlotPt+variant])) ) ) {
     Double_t x[2] = {pair4Momentum.Pt(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Pt%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Pt%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+    hs->Fill(x,inputWeight);
   }
-  if ( !IsHistogramDisabled("Y")   ){
+  if ( ( hs = static_cast<THnSparse*>(SlotObject(slots[kSlotY+variant])) ) ){
     Double_t x[2] = {pair4Momentum.Rapidity(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Y%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Y%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+    hs->Fill(x,inputWeight);
   }
-  if ( !IsHistogramDisabled("Eta") ){
+  if ( ( hs = static_cast<THnSparse*>(SlotObject(slots[kSlotEta+variant])) ) ){
     Double_t x[2] = {pair4Momentum.Eta(),pair4Momentum.M()};
-    if(proxy->GetObject(Form("Eta%s%s",smix.Data(),scharge.Data())))
-      static_cast<THnSparse*>(proxy->GetObject(Form("Eta%s%s",smix.Data(),scharge.Data())))->Fill(x,inputWeight);
+    hs->Fill(x,inputWeight);
   }
 
-  if ( !IsHistogramDisabled("PtPaireVsPtTrack") && !IsMixedHisto &&  static_cast<int>(PairCharge) == 0) {
-    static_cast<TH2*>( proxy->Histo("PtPaireVsPtTrack"))->Fill(pair4Momentum.Pt(),tracki.Pt(),inputWeight);
-    static_cast<TH2*>( proxy->Histo("PtPaireVsPtTrack"))->Fill(pair4Momentum.Pt(),trackj.Pt(),inputWeight);
+  if ( slots[kSlotPtPaireVsPtTrack] >= 0 && !IsMixedHisto &&  static_cast<int>(PairCharge) == 0) {
+    TH2* h2 = static_cast<TH2*>(SlotHisto(slots[kSlotPtPaireVsPtTrack]));
+    if ( h2 ) {
+      h2->Fill(pair4Momentum.Pt(),tracki.Pt(),inputWeight);
+      h2->Fill(pair4Momentum.Pt(),trackj.Pt(),inputWeight);
+    }
   }
 
   // Fill histos with MC stack info (only opposite charge muons)
@@ -467,15 +445,15 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     // Get 4-vector pairs from MC stack
 
     TLorentzVector mcpi(mcTracki->Px(),mcTracki->Py(),mcTracki->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTracki->P()*mcTracki->P()));
-    TLorentzVector mcpj(mcTrackj->Px(),mcTrackj->Py(),mcTrackj->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTrackj->P()*mcTrackj->P()));
+    mcpj.SetPxPyPzE(mcTrackj->Px(),mcTrackj->Py(),mcTrackj->Pz(),TMath::Sqrt(AliAnalysisMuonUtility::MuonMass2()+mcTrackj->P()*mcTrackj->P()));
     mcpj+=mcpi;
 
-
     // Fill histo
-    if ( proxy->Histo("PtRecVsSim") )  proxy->Histo("PtRecVsSim")->Fill(mcpj.Pt(),pair4Momentum.Pt());
-    if ( mcProxy->Histo("Pt"))  mcProxy->Histo("Pt")->Fill(mcpj.Pt(),inputWeightMC);
-    if ( mcProxy->Histo("Y"))   mcProxy->Histo("Y")->Fill(mcpj.Rapidity(),inputWeightMC);
-    if ( mcProxy->Histo("Eta")) mcProxy->Histo("Eta")->Fill(mcpj.Eta());
+    TH1* h(0x0);
+    if ( ( h = SlotHisto(slots[kSlotPtRecVsSim]) ) ) h->Fill(mcpj.Pt(),pair4Momentum.Pt());
+    if ( ( h = SlotHisto(slots[kSlotMCPt]) ) )       h->Fill(mcpj.Pt(),inputWeightMC);
+    if ( ( h = SlotHisto(slots[kSlotMCY]) ) )        h->Fill(mcpj.Rapidity(),inputWeightMC);
+    if ( ( h = SlotHisto(slots[kSlotMCEta]) ) )      h->Fill(mcpj.Eta());
 
     // set pair4MomentumMC for the rest of the function
     pair4MomentumMC = &mcpj;
@@ -484,31 +462,28 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   TIter nextBin(fBinsToFill);
   nextBin.Reset();
   AliAnalysisMuMuBinning::Range* r;
+  Int_t iBin(-1);
 
   // Loop over all bin ranges
   while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) ){
 
+    ++iBin;
+
     // --- In this loop we first check if the pairs pass some tests and we fill histo accordingly. ---
 
     // Flag for cuts and ranges
     Bool_t ok(kFALSE);
     Bool_t okMC(kFALSE);
 
-    ok = CheckBinRangeCut(r,&pair4Momentum,proxy);
-    if( pair4MomentumMC ) okMC = CheckBinRangeCut(r,pair4MomentumMC,proxy);
+    ok = CheckBinRangeCut(r,&pair4Momentum,slots);
+    if( pair4MomentumMC ) okMC = CheckBinRangeCut(r,pair4MomentumMC,slots);
 
     // Check if pair pass all conditions, either MC or not, and fill Minv Histogrames
     if ( ok )
     {
-      // Get Minv histo name associated to the bin
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight);
-
-      // Create, fill and store Minv histo already corrected with accxeff
+      FillMinvHisto(slots+MinvSlotOffset(iBin,kFALSE,iCharge,iMix,kFALSE),&pair4Momentum,inputWeight);
+
+      // Fill Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() )
       {
         Double_t AccxEff(0);
@@ -519,25 +494,15 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4Momentum.Pt(),pair4Momentum.Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight/AccxEff);
+        if( okAccEff ) FillMinvHisto(slots+MinvSlotOffset(iBin,kTRUE,iCharge,iMix,kFALSE),&pair4Momentum,inputWeight/AccxEff);
       }
     }
 
     if ( okMC ) {
 
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight);
+      FillMinvHisto(slots+MinvSlotOffset(iBin,kFALSE,iCharge,iMix,kTRUE),&pair4Momentum,inputWeight);
 
-      // Create, fill and store Minv histo already corrected with accxeff
+      // Fill Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() ){
 
         Double_t AccxEff(0);
@@ -548,18 +513,11 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4MomentumMC->Pt(),pair4MomentumMC->Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight/AccxEff);
+        if( okAccEff ) FillMinvHisto(slots+MinvSlotOffset(iBin,kTRUE,iCharge,iMix,kTRUE),&pair4Momentum,inputWeight/AccxEff);
 
       }
     }
   }
-  delete proxy;
-  delete mcProxy;
 }
 
 
@@ -687,22 +645,117 @@ void AliAnalysisMuMuMinv::FillHistosForMCEvent(const char* eventSelection,const
 }
 
 //_____________________________________________________________________________
-void AliAnalysisMuMuMinv::FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight)
+void AliAnalysisMuMuMinv::FillMinvHisto(const Int_t* minvSlots, TLorentzVector* pair4Momentum, Double_t inputWeight)
 {
-  /// Create, fill and store Minv histo
-  if (!IsHistogramDisabled(minvName->Data())){
+  /// Fill Minv histo (and mean pt profiles) given its slots (minv, mean pt, mean pt square).
+  /// A negative minv slot means the histogram is disabled.
+
+  if ( minvSlots[kMinvSlotHisto] < 0 ) return;
+
+  TH1* h = SlotHisto(minvSlots[kMinvSlotHisto]);
+  if (h) h->Fill(pair4Momentum->M(),inputWeight);
+
+  // Fill Mean pT
+  if ( fComputeMeanPt ){
+    TProfile* hprof = SlotProf(minvSlots[kMinvSlotMeanPt]);
+    TProfile* hprof2 = SlotProf(minvSlots[kMinvSlotMeanPtSquare]);
+    if ( !hprof ) AliError(Form("Could not get hprofile for %s",h ? h->GetName() : "minv"));
+    else hprof->Fill(pair4Momentum->M(),pair4Momentum->Pt(),inputWeight);
+    if ( !hprof2 ) AliError(Form("Could not get hprofile for %s",h ? h->GetName() : "minv"));
+    else hprof2->Fill(pair4Momentum->M(),pair4Momentum->Pt()*pair4Momentum->Pt(),inputWeight);
+  }
+}
 
-    TH1* h(0x0);
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuMinv::MinvSlotOffset(Int_t iBin, Bool_t accEffCorrected, Int_t iCharge, Int_t iMix, Bool_t mc) const
+{
+  /// Offset, within the slots of one pair cut, of the first (minv histo) slot of a given bin
+  return kNPairSlots + ((((iBin*2+(accEffCorrected?1:0))*3+iCharge)*2+iMix)*2+(mc?1:0))*kNMinvSlots;
+}
+
+//_____________________________________________________________________________
+const Int_t* AliAnalysisMuMuMinv::PairSlots(const char* pairCutName) const
+{
+  /// Get the histogram slots of a given pair cut (see RegisterPairSlots)
+
+  Int_t iCut = PairCutIndex(pairCutName);
+  if ( iCut < 0 || (iCut+1)*fPairSlotStride > static_cast<Int_t>(fPairSlots.size()) ) return 0x0;
+
+  return &fPairSlots[iCut*fPairSlotStride];
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuMinv::RegisterPairSlots()
+{
+  /// Assign a histogram slot to each (pair cut, histogram) combination filled
+  /// in FillHistosForPair, so that no histogram path has to be built when filling.
+  /// Disabled histograms get a negative slot.
+
+  if ( !fPairSlots.empty() || !CutRegistry() ) return;
+
+  const TObjArray* pairCuts = CutRegistry()->GetCutCombinations(AliAnalysisMuMuCutElement::kTrackPair);
+  if ( !pairCuts ) return;
+
+  Int_t nCuts = pairCuts->GetLast()+1;
+  Int_t nBins = fBinsToFill->GetLast()+1;
+
+  fPairSlotStride = MinvSlotOffset(nBins,kFALSE,0,0,kFALSE);
+  fPairSlots.assign(nCuts*fPairSlotStride,-1);
 
-    h = proxy->Histo(minvName->Data());
-    if (h) h->Fill(pair4Momentum->M(),inputWeight);
+  const char* scharge[3] = { "", "PP", "MM" };
+  const Double_t pairCharge[3] = { 0., 2., -2. };
 
-    // Fill Mean pT
-    if ( fComputeMeanPt ){
-      if ( !hprof ) AliError(Form("Could not get hprofile for %s",minvName->Data()));
-      else hprof->Fill(pair4Momentum->M(),pair4Momentum->Pt(),inputWeight);
-      if ( !hprof2 ) AliError(Form("Could not get hprofile for %s",minvName->Data()));
-      else hprof2->Fill(pair4Momentum->M(),pair4Momentum->Pt()*pair4Momentum->Pt(),inputWeight);
+  for ( Int_t iCut = 0; iCut < nCuts; ++iCut )
+  {
+    const char* cut = pairCuts->UncheckedAt(iCut)->GetName();
+    Int_t* slots = &fPairSlots[iCut*fPairSlotStride];
+
+    for ( Int_t iCharge = 0; iCharge < 3; ++iCharge )
+    {
+      for ( Int_t iMix = 0; iMix < 2; ++iMix )
+      {
+        const char* smix = iMix ? "Mix" : "";
+        Int_t variant = iCharge*2 + iMix;
+        if ( !IsHistogramDisabled("Pt") )  slots[kSlotPt+variant]  = RegisterHistoSlot(cut,Form("Pt%s%s",smix,scharge[iCharge]));
+        if ( !IsHistogramDisabled("Y") )   slots[kSlotY+variant]   = RegisterHistoSlot(cut,Form("Y%s%s",smix,scharge[iCharge]));
+        if ( !IsHistogramDisabled("Eta") ) slots[kSlotEta+variant] = RegisterHistoSlot(cut,Form("Eta%s%s",smix,scharge[iCharge]));
+      }
+    }
+
+    if ( !IsHistogramDisabled("PtPaireVsPtTrack") ) slots[kSlotPtPaireVsPtTrack] = RegisterHistoSlot(cut,"PtPaireVsPtTrack");
+    slots[kSlotPtRecVsSim] = RegisterHistoSlot(cut,"PtRecVsSim");
+    slots[kSlotNchForJpsi] = RegisterHistoSlot(cut,"NchForJpsi");
+    slots[kSlotNchForPsiP] = RegisterHistoSlot(cut,"NchForPsiP");
+    slots[kSlotMCPt]       = RegisterHistoSlot(cut,"Pt",kTRUE);
+    slots[kSlotMCY]        = RegisterHistoSlot(cut,"Y",kTRUE);
+    slots[kSlotMCEta]      = RegisterHistoSlot(cut,"Eta",kTRUE);
+
+    TIter nextBin(fBinsToFill);
+    AliAnalysisMuMuBinning::Range* r;
+    Int_t iBin(-1);
+
+    while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) )
+    {
+      ++iBin;
+      for ( Int_t iAcc = 0; iAcc < 2; ++iAcc )
+      {
+        for ( Int_t iCharge = 0; iCharge < 3; ++iCharge )
+        {
+          for ( Int_t iMix = 0; iMix < 2; ++iMix )
+          {
+            TString minvName(GetMinvHistoName(*r,iAcc==1,pairCharge[iCharge],iMix==1));
+            if ( IsHistogramDisabled(minvName.Data()) ) continue;
+
+            for ( Int_t iMC = 0; iMC < 2; ++iMC )
+            {
+              Int_t* minvSlots = slots + MinvSlotOffset(iBin,iAcc==1,iCharge,iMix,iMC==1);
+              minvSlots[kMinvSlotHisto]        = RegisterHistoSlot(cut,minvName.Data(),iMC==1);
+              minvSlots[kMinvSlotMeanPt]       = RegisterHistoSlot(cut,Form("MeanPtVs%s",minvName.Data()),iMC==1);
+              minvSlots[kMinvSlotMeanPtSquare] = RegisterHistoSlot(cut,Form("MeanPtSquareVs%s",minvName.Data()),iMC==1);
+            }
+          }
+        }
+      }
     }
   }
 }
@@ -818,7 +871,7 @@ Bool_t AliAnalysisMuMuMinv::IsPtInRange(const AliVParticle& t1, const AliVPartic
 }
 
 //_____________________________________________________________________________
-Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, AliMergeableCollectionProxy* proxy)
+Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, const Int_t* slots)
 {
   /// Check if our pairs match conditions from the binning range
 
@@ -835,7 +888,7 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
     // Fill NchForJpsi histo according to pair4Momentum.M()
     if ( pair4Momentum->M() >= 2.9 && pair4Momentum->M() <= 3.3 ){
 
-      h = proxy->Histo("NchForJpsi");
+      h = SlotHisto(slots[kSlotNchForJpsi]);
 
       Double_t ntrcorr = (-1.);
       TList* list = static_cast<TList*>(Event()->FindListObject("NCH"));
@@ -855,11 +908,11 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
           }
         }
       }
-      h->Fill(ntrcorr);
+      if (h) h->Fill(ntrcorr);
     }
     else if ( pair4Momentum->M() >= 3.6 && pair4Momentum->M() <= 3.9){
 
-      h = proxy->Histo("NchForPsiP");
+      h = SlotHisto(slots[kSlotNchForPsiP]);
       Double_t ntrcorr = (-1.);
 
       TList* list = static_cast<TList*>(Event()->FindListObject("NCH"));
@@ -879,7 +932,7 @@ Bool_t AliAnalysisMuMuMinv::CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, T
           }
         }
       }
-      h->Fill(ntrcorr);
+      if (h) h->Fill(ntrcorr);
     }
   }
 
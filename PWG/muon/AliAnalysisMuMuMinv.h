@@ -72,7 +72,7 @@ protected:
 
   void FillHistosForMCEvent(const char* eventSelection,const char* triggerClassName,const char* centrality);
 
-  void FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight);
+  void FillMinvHisto(const Int_t* minvSlots, TLorentzVector* pair4Momentum, Double_t inputWeight);
 
 private:
 
@@ -91,7 +91,38 @@ private:
 
   Double_t TriggerLptApt(Double_t *x, Double_t *par);
 
-  Bool_t  CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, AliMergeableCollectionProxy* proxy);
+  Bool_t  CheckBinRangeCut(AliAnalysisMuMuBinning::Range* r, TLorentzVector* pair4Momentum, const Int_t* slots);
+
+  void RegisterPairSlots();
+
+  const Int_t* PairSlots(const char* pairCutName) const;
+
+  Int_t MinvSlotOffset(Int_t iBin, Bool_t accEffCorrected, Int_t iCharge, Int_t iMix, Bool_t mc) const;
+
+  /// Histogram slots of one pair cut. Pt, Y and Eta come in 6 variants (charge x mix)
+  enum EPairSlot
+  {
+    kSlotPt = 0,
+    kSlotY = 6,
+    kSlotEta = 12,
+    kSlotPtPaireVsPtTrack = 18,
+    kSlotPtRecVsSim,
+    kSlotNchForJpsi,
+    kSlotNchForPsiP,
+    kSlotMCPt,
+    kSlotMCY,
+    kSlotMCEta,
+    kNPairSlots
+  };
+
+  /// Slots of one minv histogram (per bin, acc x eff correction, charge, mix and data/MC)
+  enum EMinvSlot
+  {
+    kMinvSlotHisto = 0,
+    kMinvSlotMeanPt,
+    kMinvSlotMeanPtSquare,
+    kNMinvSlots
+  };
 
   Bool_t CheckMCTracksMatchingStackAndMother(Int_t labeli, Int_t labelj, AliVParticle* mcTracki, AliVParticle* mcTrackj, Double_t inputWeightMC);
 
@@ -111,8 +142,10 @@ private:
   Double_t fMinvMax;
   Double_t fmcptcutmin;
   Double_t fmcptcutmax;
+  std::vector<Int_t> fPairSlots; //! histogram slots, per pair cut (see RegisterPairSlots)
+  Int_t fPairSlotStride; //! number of slots per pair cut
 
-  ClassDef(AliAnalysisMuMuMinv,8) // implementation of AliAnalysisMuMuBase for muon pairs
+  ClassDef(AliAnalysisMuMuMinv,9) // implementation of AliAnalysisMuMuBase for muon pairs
 };
 
 #endif
@@ -395,6 +395,9 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
       // Create proxy for the Histogram collections
       analysis->DefineHistogramCollection(eventSelection,triggerClassName,centrality,fMix);
 
+      // Resolve the histogram slots of this path once, instead of for each track/pair
+      analysis->SelectHistoSlotPath(eventSelection,triggerClassName,centrality);
+
       if ( MCEvent() != 0x0 )
       {
         AliCodeTimerAuto(Form("%s (FillHistosForMCEvent)",analysis->ClassName()),1);
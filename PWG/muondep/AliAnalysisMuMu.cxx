@@ -91,7 +91,8 @@ fCorrectionPerRun(0x0),
 fAssociatedSimulation(0x0),
 fAssociatedSimulation2(0x0),
 fParticleName(""),
-fConfig(new AliAnalysisMuMuConfig(config))
+fConfig(new AliAnalysisMuMuConfig(config)),
+fNofFitWorkers(1)
 {
   GetFileNameAndDirectory(filename);
 
@@ -113,7 +114,8 @@ fCorrectionPerRun(0x0),
 fAssociatedSimulation(0x0),
 fAssociatedSimulation2(0x0),
 fParticleName(""),
-fConfig(0x0)
+fConfig(0x0),
+fNofFitWorkers(1)
 {
   /// ctor
 
@@ -1633,6 +1635,15 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
 
   // ---- MAIN PART : Loop on every binning range ----
 
+  // The fits of all the bins are first queued, then run together (see AliAnalysisMuMuJpsiResult::AddFits)
+  TObjArray fitResults; // result to be fitted, for each fit job
+  TObjArray fitJobs; // fit type, for each fit job
+  fitJobs.SetOwner(kTRUE);
+  TObjArray binResults; // result of each bin with at least one fit
+  TObjArray binRanges; // the corresponding bins
+  TObjArray binFitTypes; // the corresponding fit type lists
+  binFitTypes.SetOwner(kTRUE);
+
   AliAnalysisMuMuBinning::Range* bin;
   TIter next(bins);
   next.Reset();
@@ -1640,7 +1651,6 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
   {
     Int_t added(0);
     AliAnalysisMuMuJpsiResult* r    = 0x0;
-    Bool_t adoptOk           = kFALSE;
     Bool_t adoptMix          = kFALSE;
 
     TH1* histo(0x0);
@@ -1784,7 +1794,7 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
 
         if(!okMCtails) continue;
 
-        added += ( r->AddFit(fitType->String().Data()) == kTRUE );
+        added += QueueFit(fitResults,fitJobs,r,fitType->String().Data());
       }
 
       // Config. for mpt (see function type)
@@ -1828,7 +1838,7 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
 
           GetParametersFromResult(sMinvfitType,fitMinv);//FIXME: Think about if this is necessary
 
-          added += ( r->AddFit(sMinvfitType.Data()) == kTRUE );
+          added += QueueFit(fitResults,fitJobs,r,sMinvfitType.Data());
 
           nSubFit++;
         }
@@ -1875,7 +1885,7 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
 
           GetParametersFromResult(sMinvfitType,fitMinv);//FIXME: Think about if this is necessary
 
-          added += ( r->AddFit(sMinvfitType.Data()) == kTRUE );
+          added += QueueFit(fitResults,fitJobs,r,sMinvfitType.Data());
 
           nSubFit++;
         }
@@ -1931,7 +1941,7 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
             continue; //return 0x0;
           }
 
-          added += ( r->AddFit(sMinvFitType.Data()) == kTRUE );
+          added += QueueFit(fitResults,fitJobs,r,sMinvFitType.Data());
 
           nSubFit++;
         }
@@ -1957,7 +1967,7 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
           continue;
         }
         // Here we call  FINALLY the fit functions
-        added += ( r->AddFit(fitType->String().Data()) == kTRUE );
+        added += QueueFit(fitResults,fitJobs,r,fitType->String().Data());
       }
 
       std::cout << "-------------------------------------" << std::endl;
@@ -1966,6 +1976,32 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
     if ( !added )
     {
       delete fitTypeArray;
+      delete r;
+      continue;
+    }
+
+    binResults.Add(r);
+    binRanges.Add(bin);
+    binFitTypes.Add(fitTypeArray);
+  }
+
+  // ---- Run all the (bin x fit type) fits, possibly in parallel ----
+
+  AliAnalysisMuMuJpsiResult::AddFits(fitResults,fitJobs,fNofFitWorkers);
+
+  // ---- Collect the results of each bin into the spectra ----
+
+  for ( Int_t ibin = 0; ibin <= binResults.GetLast(); ++ibin )
+  {
+    AliAnalysisMuMuJpsiResult* r = static_cast<AliAnalysisMuMuJpsiResult*>(binResults.At(ibin));
+    bin = static_cast<AliAnalysisMuMuBinning::Range*>(binRanges.At(ibin));
+    TObjArray* fitTypeArray = static_cast<TObjArray*>(binFitTypes.At(ibin));
+    TIter nextFitType(fitTypeArray);
+    Bool_t adoptOk = kFALSE;
+
+    if ( !r->SubResults() || r->SubResults()->IsEmpty() )
+    {
+      delete r;
       continue;
     }
 
@@ -2014,7 +2050,6 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
       std::cout << "Computing AccEff Value Spectra " << std::endl;
       SetNofInputParticles(*r,eventType,trigger,centrality);
     }
-    delete fitTypeArray;
   }
 
   delete bins;
@@ -2025,6 +2060,17 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
   return spectra;
 }
 
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMu::QueueFit(TObjArray& results, TObjArray& fitTypes, AliAnalysisMuMuJpsiResult* r, const char* fitType) const
+{
+  /// Queue the fit of r with fitType, to be run later by AliAnalysisMuMuJpsiResult::AddFits
+  /// Returns the number of queued fits (i.e. 1)
+
+  results.Add(r);
+  fitTypes.Add(new TObjString(fitType));
+  return 1;
+}
+
 //_____________________________________________________________________________
 Bool_t AliAnalysisMuMu::GetParametersFromMC(TString& fitType, const char* pathCentrPairCut, const char* spectraName, AliAnalysisMuMuBinning::Range* bin) const
 {
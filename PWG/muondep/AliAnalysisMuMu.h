@@ -57,6 +57,7 @@ class TGraph;
 class TGraphErrors;
 class TH1;
 class TMap;
+class TObjArray;
 
 class AliAnalysisMuMu : public TObject, public TQObject
 {
@@ -324,6 +325,9 @@ public:
     void Print(Option_t* opt="") const;
 
     Bool_t SetCorrectionPerRun(const TGraph& corr, const char* formula="");
+
+    /// Number of processes used to run the fits of FitParticle (1 = serial)
+    void SetNofFitWorkers(Int_t n) { fNofFitWorkers = n; }
     void UnsetCorrectionPerRun();
 
     void ExecuteCanvasEvent(Int_t event, Int_t px, Int_t py, TObject *sel);
@@ -347,6 +351,8 @@ private:
     Bool_t GetParametersFromMC(TString& fitType, const char* pathCentrPairCut, const char* spectraName, AliAnalysisMuMuBinning::Range* bin) const;
     void GetParametersFromResult(TString& fitType, AliAnalysisMuMuJpsiResult* minvResult) const;
 
+    Int_t QueueFit(TObjArray& results, TObjArray& fitTypes, AliAnalysisMuMuJpsiResult* r, const char* fitType) const;
+
 
     void GetCollectionsFromAnySubdir(TDirectory& dir,
                                     AliMergeableCollection*& oc,
@@ -380,7 +386,9 @@ private:
 
     AliAnalysisMuMuConfig* fConfig; // configuration
 
-    ClassDef(AliAnalysisMuMu,12) // class to analysis results from AliAnalysisTaskMuMuXXX tasks
+    Int_t fNofFitWorkers; //! number of processes used for the fits
+
+    ClassDef(AliAnalysisMuMu,13) // class to analysis results from AliAnalysisTaskMuMuXXX tasks
 };
 
 #endif
@@ -44,6 +44,12 @@ ClassImp(AliAnalysisMuMuJpsiResult)
 #include "TMinuit.h"
 #include "TCanvas.h"
 #include "TStyle.h"
+#include "RVersion.h"
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,12,0)
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#endif
+#include <vector>
 
 namespace {
 
@@ -12510,16 +12516,26 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
 {
   // Add a fit to this result
 
-  if ( !fHisto ) return kFALSE;
+  return AdoptFit(CreateFit(fitType));
+}
+
+//_____________________________________________________________________________
+AliAnalysisMuMuJpsiResult* AliAnalysisMuMuJpsiResult::CreateFit(const char* fitType) const
+{
+  /// Perform the fit described by fitType on a copy of our histogram.
+  /// Returns the (valid) fitted result, not yet adopted, or 0x0 if the fit could not be done.
+  /// Does not modify this, so that several fits can be performed independently (see AddFits)
+
+  if ( !fHisto ) return 0x0;
 
   TH1* histo = static_cast<TH1*>(fHisto->Clone(fitType));
 
-  AliAnalysisMuMuJpsiResult* r = new AliAnalysisMuMuJpsiResult(GetParticle(),*histo,fitType);
+  AliAnalysisMuMuJpsiResult* r = new AliAnalysisMuMuJpsiResult(fParticle.Data(),*histo,fitType);
 
   if ( !r->IsValid() )
   {
     delete r;
-    return kFALSE;
+    return 0x0;
   }
 
   TMethodCall callEnv;
@@ -12539,32 +12555,97 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
   {
     AliError(Form("Could not get the method %s",fittingMethod.Data()));
     delete r;
-    return kFALSE;
+    return 0x0;
   }
 
-  if ( r->IsValid() )
+  if ( !r->IsValid() )
   {
-    StdoutToAliDebug(1,r->Print(););
-    r->SetBin(Bin());
-    r->SetNofTriggers(NofTriggers());
-    r->SetNofRuns(NofRuns());
+    delete r;
+    return 0x0;
+  }
 
-    Bool_t adoptOK = AdoptSubResult(r);
-    if ( adoptOK ) {
+  return r;
+}
 
-      std::cout << "Subresult " << r->GetName() << " adopted in " << GetName() <<  std::endl;
-      if(IsValidValue(r->Weight()))  SetWeight(Weight()+r->Weight());
-      else SetWeight(Weight()+1);
-    }
-    else AliError(Form("Could not adopt subresult %s",r->GetName()));
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuJpsiResult::AdoptFit(AliAnalysisMuMuJpsiResult* r)
+{
+  /// Adopt a result obtained with CreateFit as a sub result of this.
+  /// Returns kFALSE if there is no result or if it could not be adopted
+  /// (in which case it is deleted)
+
+  if ( !r ) return kFALSE;
+
+  StdoutToAliDebug(1,r->Print(););
+  r->SetBin(Bin());
+  r->SetNofTriggers(NofTriggers());
+  r->SetNofRuns(NofRuns());
+
+  Bool_t adoptOK = AdoptSubResult(r);
+  if ( adoptOK ) {
+
+    std::cout << "Subresult " << r->GetName() << " adopted in " << GetName() <<  std::endl;
+    if(IsValidValue(r->Weight()))  SetWeight(Weight()+r->Weight());
+    else SetWeight(Weight()+1);
   }
   else
   {
+    AliError(Form("Could not adopt subresult %s",r->GetName()));
     delete r;
-    r=0x0;
   }
 
-  return (r!=0x0);
+  return adoptOK;
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuJpsiResult::AddFits(const TObjArray& results, const TObjArray& fitTypes, Int_t nWorkers)
+{
+  /// Perform a batch of fits : the i-th fit is fitTypes[i] (a TObjString) applied
+  /// to results[i] (an AliAnalysisMuMuJpsiResult, which may appear several times).
+  ///
+  /// With nWorkers > 1 (and ROOT >= 6.12) the fits are distributed over forked
+  /// processes, each having its own fit functions and minimizer, and the fitted
+  /// sub results are sent back to this process. In all cases the sub results are
+  /// adopted in the order of the batch, so the output does not depend on nWorkers.
+  ///
+  /// Returns the number of fits which succeeded.
+
+  Int_t nFits = TMath::Min(results.GetLast(),fitTypes.GetLast()) + 1;
+  if ( nFits <= 0 ) return 0;
+
+  std::vector<AliAnalysisMuMuJpsiResult*> fits;
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,12,0)
+  if ( nWorkers > 1 )
+  {
+    ROOT::TProcessExecutor workers(TMath::Min(nWorkers,nFits));
+    auto doFit = [&](Int_t i) {
+      const AliAnalysisMuMuJpsiResult* r = static_cast<const AliAnalysisMuMuJpsiResult*>(results.At(i));
+      return r->CreateFit(static_cast<TObjString*>(fitTypes.At(i))->String().Data());
+    };
+    fits = workers.Map(doFit,ROOT::TSeqI(nFits));
+  }
+  else
+#else
+  if ( nWorkers > 1 ) AliWarningClass("Parallel fits need ROOT >= 6.12, running them serially");
+#endif
+  {
+    for ( Int_t i = 0; i < nFits; ++i )
+    {
+      const AliAnalysisMuMuJpsiResult* r = static_cast<const AliAnalysisMuMuJpsiResult*>(results.At(i));
+      fits.push_back(r->CreateFit(static_cast<TObjString*>(fitTypes.At(i))->String().Data()));
+    }
+  }
+
+  Int_t nAdded(0);
+
+  for ( Int_t i = 0; i < nFits; ++i )
+  {
+    AliAnalysisMuMuJpsiResult* r = static_cast<AliAnalysisMuMuJpsiResult*>(results.At(i));
+    if ( r->AdoptFit(fits[i]) ) ++nAdded;
+  }
+
+  return nAdded;
 }
 
 //_____________________________________________________________________________
@@ -80,6 +80,12 @@ public:
 
   Bool_t AddFit(const char* fitType);
 
+  AliAnalysisMuMuJpsiResult* CreateFit(const char* fitType) const;
+
+  Bool_t AdoptFit(AliAnalysisMuMuJpsiResult* r);
+
+  static Int_t AddFits(const TObjArray& results, const TObjArray& fitTypes, Int_t nWorkers=1);
+
   /** All the fit functions should have a prototype starting like :
 
    AliAnalysisMuMuJpsiResult* FitXXX();
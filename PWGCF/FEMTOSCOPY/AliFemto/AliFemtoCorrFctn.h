@@ -44,6 +44,14 @@ public:
   /// Not Implemented - Add background pair
   virtual void AddMixedPair(AliFemtoPair* aPir);
 
+  /// Add a batch of signal pairs
+  ///
+  /// The default implementation calls AddRealPair on each pair;
+  /// override to process the whole batch at once.
+  virtual void AddRealPairs(AliFemtoPair* const* pairs, size_t npairs);
+  /// Add a batch of background pairs (see AddRealPairs)
+  virtual void AddMixedPairs(AliFemtoPair* const* pairs, size_t npairs);
+
   /// Not Implemented - Add pair with optional
   virtual void AddFirstParticle(AliFemtoParticle *particle, bool mixing);
   virtual void AddSecondParticle(AliFemtoParticle *particle);
@@ -105,6 +113,20 @@ inline void AliFemtoCorrFctn::EventEnd(const AliFemtoEvent* /* event */)
 {  // no-op
 }
 
+inline void AliFemtoCorrFctn::AddRealPairs(AliFemtoPair* const* pairs, size_t npairs)
+{
+  for (size_t i = 0; i < npairs; ++i) {
+    AddRealPair(pairs[i]);
+  }
+}
+
+inline void AliFemtoCorrFctn::AddMixedPairs(AliFemtoPair* const* pairs, size_t npairs)
+{
+  for (size_t i = 0; i < npairs; ++i) {
+    AddMixedPair(pairs[i]);
+  }
+}
+
 inline void AliFemtoCorrFctn::AddOutputObjectsTo(TCollection &dest)
 {
   TList *output_list = GetOutputList();
@@ -5,6 +5,7 @@
 #include "AliFemtoDummyPairCut.h"
 #include <string>
 #include <cstdio>
+#include <algorithm>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -33,6 +34,13 @@ bool AliFemtoDummyPairCut::Pass(const AliFemtoPair* /* pair */)
   return true;
 }
 //__________________
+void AliFemtoDummyPairCut::PassPairs(AliFemtoPair* const* /* pairs */, size_t npairs, bool* passed)
+{
+  // Pass all pairs of the batch
+  std::fill(passed, passed + npairs, true);
+  fNPairsPassed += npairs;
+}
+//__________________
 AliFemtoString AliFemtoDummyPairCut::Report()
 {
   // prepare a report from the execution
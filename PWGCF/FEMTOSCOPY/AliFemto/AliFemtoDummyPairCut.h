@@ -82,6 +82,7 @@ public:
   AliFemtoDummyPairCut& operator=(const AliFemtoDummyPairCut&);
 
   virtual bool Pass(const AliFemtoPair*);
+  virtual void PassPairs(AliFemtoPair* const* pairs, size_t npairs, bool* passed);
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   AliFemtoDummyPairCut* Clone();
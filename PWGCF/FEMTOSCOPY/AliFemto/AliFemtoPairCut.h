@@ -43,6 +43,12 @@ public:
 
   virtual bool Pass(const AliFemtoPair* pair) = 0;  ///< true if pair passes, false if not
 
+  /// Sets passed[i] for each of the npairs pairs
+  ///
+  /// The default implementation calls Pass on each pair;
+  /// override to cut the whole batch at once.
+  virtual void PassPairs(AliFemtoPair* const* pairs, size_t npairs, bool* passed);
+
   virtual AliFemtoString Report() = 0;              ///< user-written method to return string describing cuts
   virtual TList *ListSettings() = 0;                ///< Return a TList of settings
 
@@ -66,6 +72,13 @@ inline AliFemtoPairCut::AliFemtoPairCut(): AliFemtoCutMonitorHandler(), fyAnalys
 inline AliFemtoPairCut::AliFemtoPairCut(const AliFemtoPairCut& /* aCut */): AliFemtoCutMonitorHandler(), fyAnalysis(NULL) { /* no-op */ }
 inline AliFemtoPairCut::~AliFemtoPairCut(){ /* no-op */ }
 
+inline void AliFemtoPairCut::PassPairs(AliFemtoPair* const* pairs, size_t npairs, bool* passed)
+{
+  for (size_t i = 0; i < npairs; ++i) {
+    passed[i] = Pass(pairs[i]);
+  }
+}
+
 inline void AliFemtoPairCut::SetAnalysis(AliFemtoAnalysis* analysis) { fyAnalysis = analysis; }
 inline AliFemtoPairCut& AliFemtoPairCut::operator=(const AliFemtoPairCut &aCut) { if (this == &aCut) return *this; fyAnalysis = aCut.fyAnalysis; return *this; }
 
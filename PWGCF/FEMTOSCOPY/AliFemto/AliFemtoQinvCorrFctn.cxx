@@ -3,6 +3,8 @@
 ///
 
 #include "AliFemtoQinvCorrFctn.h"
+
+#include <algorithm>
 // #include <cstdio>
 
 #ifdef __ROOT__
@@ -245,6 +247,66 @@ void AliFemtoQinvCorrFctn::AddMixedPair(AliFemtoPair* pair)
   }
 }
 
+//____________________________
+// Function used by both AddRealPairs & AddMixedPairs: fills |q_inv| (and kT,
+// if kt_hist is not null) of the pairs passing the cut, one chunk at a time
+//
+static
+void FillPairs(AliFemtoPairCut *cut, AliFemtoPair* const* pairs, size_t npairs, TH1 &qinv_hist, TH1 *kt_hist)
+{
+  const size_t kChunk = 256;
+  bool passed[kChunk];
+  double qinv[kChunk],
+         kt[kChunk];
+
+  for (size_t first = 0; first < npairs; first += kChunk) {
+    const size_t n = std::min(kChunk, npairs - first);
+    AliFemtoPair* const* chunk = pairs + first;
+    if (cut) {
+      cut->PassPairs(chunk, n, passed);
+    }
+
+    Int_t nfill = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (cut && !passed[i]) {
+        continue;
+      }
+      qinv[nfill] = fabs(chunk[i]->QInv());
+      kt[nfill] = chunk[i]->KT();
+      ++nfill;
+    }
+
+    qinv_hist.FillN(nfill, qinv, nullptr);
+    if (kt_hist) {
+      kt_hist->FillN(nfill, kt, nullptr);
+    }
+  }
+}
+
+//____________________________
+void AliFemtoQinvCorrFctn::AddRealPairs(AliFemtoPair* const* pairs, size_t npairs)
+{
+  // the (Δη, Δϕ*) calculation is done pair by pair
+  if (fDetaDphiscal) {
+    AliFemtoCorrFctn::AddRealPairs(pairs, npairs);
+    return;
+  }
+
+  FillPairs(fPairCut, pairs, npairs, *fNumerator, fkTMonitor);
+}
+
+//____________________________
+void AliFemtoQinvCorrFctn::AddMixedPairs(AliFemtoPair* const* pairs, size_t npairs)
+{
+  // the (Δη, Δϕ*) calculation and the pair reader are filled pair by pair
+  if (fDetaDphiscal || fPairKinematics) {
+    AliFemtoCorrFctn::AddMixedPairs(pairs, npairs);
+    return;
+  }
+
+  FillPairs(fPairCut, pairs, npairs, *fDenominator, nullptr);
+}
+
 void AliFemtoQinvCorrFctn::Write()
 {
   // Write out neccessary objects
@@ -66,6 +66,12 @@ public:
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
 
+  /// Fill the q_inv (and kT) histograms with a batch of pairs at once;
+  /// derived classes overriding AddRealPair/AddMixedPair must override
+  /// these as well
+  virtual void AddRealPairs(AliFemtoPair* const* pairs, size_t npairs);
+  virtual void AddMixedPairs(AliFemtoPair* const* pairs, size_t npairs);
+
   virtual void Finish();
 
   void CalculateDetaDphis(Bool_t, Double_t);
@@ -13,6 +13,7 @@
 #include <string>
 #include <iostream>
 #include <iterator>
+#include <algorithm>
 
 #ifdef __ROOT__
   /// \cond CLASSIMP
@@ -183,7 +184,8 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis():
   fMinSizePartCollection(0),
   fVerbose(kTRUE),
   fPerformSharedDaughterCut(kFALSE),
-  fEnablePairMonitors(kFALSE)
+  fEnablePairMonitors(kFALSE),
+  fPairBatch()
 {
   // Default constructor
   fCorrFctnCollection = new AliFemtoCorrFctnCollection;
@@ -205,7 +207,8 @@ AliFemtoSimpleAnalysis::AliFemtoSimpleAnalysis(const AliFemtoSimpleAnalysis& a):
   fMinSizePartCollection(a.fMinSizePartCollection),
   fVerbose(a.fVerbose),
   fPerformSharedDaughterCut(a.fPerformSharedDaughterCut),
-  fEnablePairMonitors(a.fEnablePairMonitors)
+  fEnablePairMonitors(a.fEnablePairMonitors),
+  fPairBatch()
 {
   /// Copy constructor
 
@@ -317,6 +320,10 @@ AliFemtoSimpleAnalysis::~AliFemtoSimpleAnalysis()
     }
     delete fMixingBuffer;
   }
+
+  for (auto &pair : fPairBatch) {
+    delete pair;
+  }
 }
 //______________________
 AliFemtoSimpleAnalysis& AliFemtoSimpleAnalysis::operator=(const AliFemtoSimpleAnalysis& aAna)
@@ -620,8 +627,14 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
     tEndInnerLoop = partCollection1->end() ;     //   Inner loop goes to last particle
   }
 
-  // Create the pair outside the loop - only allocate once
-  AliFemtoPair* tPair = new AliFemtoPair;
+  // The pairs are allocated once and filled in batches; each full batch
+  // is cut and passed to the correlation functions at once
+  if (fPairBatch.empty()) {
+    for (size_t i = 0; i < kPairBatchSize; ++i) {
+      fPairBatch.push_back(new AliFemtoPair);
+    }
+  }
+  size_t tNPairs = 0;
 
   // Begin the outer loop
   for (AliFemtoParticleConstIterator tPartIter1 = tStartOuterLoop;
@@ -635,17 +648,15 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
       tStartInnerLoop++;
     }
 
-    // If we have two collections - set the first track
-    if (partCollection2 != nullptr) {
-      tPair->SetTrack1(*tPartIter1);
-    }
-
     // Begin the inner loop
     for (AliFemtoParticleConstIterator tPartIter2 = tStartInnerLoop;
                                        tPartIter2 != tEndInnerLoop;
                                      ++tPartIter2) {
-      // If we have two collections - only set the second track
+      AliFemtoPair *tPair = fPairBatch[tNPairs];
+
+      // If we have two collections - keep the order of the collections
       if (partCollection2 != nullptr) {
+        tPair->SetTrack1(*tPartIter1);
         tPair->SetTrack2(*tPartIter2);
 
       // Swap between first and second particles to avoid biased ordering
@@ -655,29 +666,53 @@ void AliFemtoSimpleAnalysis::MakePairs(const char* typeIn,
         swpart = !swpart;
       }
 
-      // check if the pair passes the cut
-      bool tmpPassPair = fPairCut->Pass(tPair);
-
-      // This is a condition for speed reasons
-      if (enablePairMonitors) {
-        fPairCut->FillCutMonitor(tPair, tmpPassPair);
-      }
-
-      // If pair passes cut, loop over CF's and add pair to real/mixed
-      if (tmpPassPair) {
-        for (auto &tCorrFctn : *fCorrFctnCollection) {
-          if (these_are_real_pairs)
-            tCorrFctn->AddRealPair(tPair);
-          else
-            tCorrFctn->AddMixedPair(tPair);
-        } // loop over correlation functions
+      if (++tNPairs == kPairBatchSize) {
+        ProcessPairBatch(tNPairs, these_are_real_pairs, enablePairMonitors);
+        tNPairs = 0;
       }
-
     }    // loop over second particle
   }      // loop over first particle
 
-  // we are done with the pair
-  delete tPair;
+  ProcessPairBatch(tNPairs, these_are_real_pairs, enablePairMonitors);
+}
+//_________________________
+void AliFemtoSimpleAnalysis::ProcessPairBatch(size_t npairs,
+                                              bool realPairs,
+                                              Bool_t enablePairMonitors)
+{
+  if (npairs == 0) {
+    return;
+  }
+
+  // check which pairs pass the cut
+  bool tPassed[kPairBatchSize];
+  fPairCut->PassPairs(&fPairBatch[0], npairs, tPassed);
+
+  // This is a condition for speed reasons
+  if (enablePairMonitors) {
+    for (size_t i = 0; i < npairs; ++i) {
+      fPairCut->FillCutMonitor(fPairBatch[i], tPassed[i]);
+    }
+  }
+
+  // move the accepted pairs to the front of the batch, keeping their order
+  size_t tNPassed = 0;
+  for (size_t i = 0; i < npairs; ++i) {
+    if (tPassed[i]) {
+      std::swap(fPairBatch[tNPassed++], fPairBatch[i]);
+    }
+  }
+  if (tNPassed == 0) {
+    return;
+  }
+
+  // loop over CF's and add the pairs to real/mixed
+  for (auto &tCorrFctn : *fCorrFctnCollection) {
+    if (realPairs)
+      tCorrFctn->AddRealPairs(&fPairBatch[0], tNPassed);
+    else
+      tCorrFctn->AddMixedPairs(&fPairBatch[0], tNPassed);
+  }
 }
 //_________________________
 void AliFemtoSimpleAnalysis::EventBegin(const AliFemtoEvent* ev)
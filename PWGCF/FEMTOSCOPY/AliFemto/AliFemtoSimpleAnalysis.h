@@ -16,6 +16,8 @@
 #include "AliFemtoV0SharedDaughterCut.h"
 #include "AliFemtoXiSharedDaughterCut.h"
 
+#include <vector>
+
 class AliFemtoPicoEventCollectionVectorHideAway;
 class AliFemtoPicoEvent;
 
@@ -159,6 +161,11 @@ protected:
                  AliFemtoParticleCollection* ParticlesPssingCut2=NULL,
                  Bool_t enablePairMonitors=kFALSE);
 
+  /// Apply the pair cut to the first npairs pairs of fPairBatch and pass
+  /// the accepted ones to the correlation functions' AddRealPairs() or
+  /// AddMixedPairs() methods
+  void ProcessPairBatch(size_t npairs, bool realPairs, Bool_t enablePairMonitors);
+
   AliFemtoPicoEventCollectionVectorHideAway* fPicoEventCollectionVectorHideAway; //!<! Mixing Buffer used for Analyses which wrap this one
 
   AliFemtoPairCut*             fPairCut;             ///< cut applied to pairs
@@ -178,6 +185,9 @@ protected:
   Bool_t fPerformSharedDaughterCut;
   Bool_t fEnablePairMonitors;
 
+  static const size_t kPairBatchSize = 256;         ///< Number of pairs cut and passed to the CFs at once
+  std::vector<AliFemtoPair*> fPairBatch;             //!<! Pairs reused by MakePairs, processed in batches
+
 #ifdef __ROOT__
   /// \cond CLASSIMP
   ClassDef(AliFemtoSimpleAnalysis, 0);
@@ -4,6 +4,8 @@
 
 #include "AliFemtoCorrFctnKStar.h"
 
+#include <algorithm>
+
 
 const float DFLT_KStarMin = 0.0, DFLT_KStarMax = 1.0,
             DFLT_kTMin    = 0.0, DFLT_kTMax    = 5.0,
@@ -407,6 +409,64 @@ void AliFemtoCorrFctnKStar::AddMixedPair(AliFemtoPair* aPair)
   if(fBuild3d) fDenominator3d->Fill(aPair->KStarOut(),aPair->KStarSide(),aPair->KStarLong());
 }
 
+//____________________________
+// Fills |k*| (and kT, if aKtHist is not null) of the pairs passing the cut,
+// one chunk at a time
+static void FillPairs(AliFemtoPairCut* aCut, AliFemtoPair* const* aPairs, size_t aNPairs, TH1& aKStarHist, TH1* aKtHist)
+{
+  const size_t kChunk = 256;
+  bool tPassed[kChunk];
+  double tKStar[kChunk], tKT[kChunk];
+
+  for(size_t tFirst = 0; tFirst < aNPairs; tFirst += kChunk)
+  {
+    const size_t tN = std::min(kChunk, aNPairs - tFirst);
+    AliFemtoPair* const* tChunk = aPairs + tFirst;
+    if(aCut) aCut->PassPairs(tChunk, tN, tPassed);
+
+    Int_t tNFill = 0;
+    for(size_t i = 0; i < tN; i++)
+    {
+      if(aCut && !tPassed[i]) continue;
+      tKStar[tNFill] = fabs(tChunk[i]->KStar());
+      tKT[tNFill] = tChunk[i]->KT();
+      tNFill++;
+    }
+
+    aKStarHist.FillN(tNFill, tKStar, nullptr);
+    if(aKtHist) aKtHist->FillN(tNFill, tKT, nullptr);
+  }
+}
+
+//____________________________
+void AliFemtoCorrFctnKStar::AddRealPairs(AliFemtoPair* const* pairs, size_t npairs)
+{
+  if(fDetaDphiscal || fBuildkTBinned || fBuildmTBinned || fBuildIndmTBinned || fBuild3d)
+  {
+    AliFemtoCorrFctn::AddRealPairs(pairs, npairs);
+    return;
+  }
+
+  for(size_t i = 0; i < npairs; i++)
+  {
+    if(PassPairCut_RotatePar2(pairs[i])) fNumerator_RotatePar2->Fill(fabs(CalcKStar_RotatePar2(pairs[i])));
+  }
+
+  FillPairs(fPairCut, pairs, npairs, *fNumerator, fkTMonitor);
+}
+
+//____________________________
+void AliFemtoCorrFctnKStar::AddMixedPairs(AliFemtoPair* const* pairs, size_t npairs)
+{
+  if(fPairKinematics || fDetaDphiscal || fBuildkTBinned || fBuildmTBinned || fBuildIndmTBinned || fBuild3d)
+  {
+    AliFemtoCorrFctn::AddMixedPairs(pairs, npairs);
+    return;
+  }
+
+  FillPairs(fPairCut, pairs, npairs, *fDenominator, nullptr);
+}
+
 
 //____________________________
 void AliFemtoCorrFctnKStar::FillDEtaDPhiS(TH2D* aHist, AliFemtoPair* aPair)
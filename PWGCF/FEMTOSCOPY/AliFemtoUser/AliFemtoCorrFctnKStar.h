@@ -59,6 +59,11 @@ public:
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
 
+  /// Fill the k* (and kT) histograms with a batch of pairs at once; falls
+  /// back to AddRealPair/AddMixedPair when optional histograms are built
+  virtual void AddRealPairs(AliFemtoPair* const* pairs, size_t npairs);
+  virtual void AddMixedPairs(AliFemtoPair* const* pairs, size_t npairs);
+
   void FillDEtaDPhiS(TH2D* aHist, AliFemtoPair* aPair);
 
   //TODO check these
@@ -79,19 +79,24 @@ bool AliFemtoPairCutRadialDistance::Pass(const AliFemtoPair* pair){
   // quality and sharity
   //  bool temp = true;
 
-//    double pih = 3.14159265358979312;
-//    double pit = 6.28318530717958623;
-
-  double phi1 = pair->Track1()->Track()->P().Phi();
-  double phi2 = pair->Track2()->Track()->P().Phi();
-  double chg1 = pair->Track1()->Track()->Charge();
-  double chg2 = pair->Track2()->Track()->Charge();
-  double ptv1 = pair->Track1()->Track()->Pt();
-  double ptv2 = pair->Track2()->Track()->Pt();
-  double eta1 = pair->Track1()->Track()->P().PseudoRapidity();
-  double eta2 = pair->Track2()->Track()->P().PseudoRapidity();
-
+  if (!UpdateMagSign()) {
+    return false;
+  }
 
+  return PassWithMagSign(pair);
+}
+//__________________
+void AliFemtoPairCutRadialDistance::PassPairs(AliFemtoPair* const* pairs, size_t npairs, bool* passed){
+  // Same as Pass on each pair, with the magnetic field read once for the batch
+  const bool magfield = UpdateMagSign();
+  for (size_t i = 0; i < npairs; ++i) {
+    passed[i] = magfield && PassWithMagSign(pairs[i]);
+  }
+}
+//__________________
+bool AliFemtoPairCutRadialDistance::UpdateMagSign(){
+  // Set fMagSign from the magnetic field of the current event;
+  // false if there is no AOD input handler
   AliAODInputHandler *aodH = dynamic_cast<AliAODInputHandler*> (AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler());
   Double_t magsign = 0.0;
 
@@ -115,6 +120,24 @@ bool AliFemtoPairCutRadialDistance::Pass(const AliFemtoPair* pair){
 
   //cout << "mag sign = " << magsign << endl;
 
+  return true;
+}
+//__________________
+bool AliFemtoPairCutRadialDistance::PassWithMagSign(const AliFemtoPair* pair){
+  // Pair selection of Pass, using the current fMagSign
+
+//    double pih = 3.14159265358979312;
+//    double pit = 6.28318530717958623;
+
+  double phi1 = pair->Track1()->Track()->P().Phi();
+  double phi2 = pair->Track2()->Track()->P().Phi();
+  double chg1 = pair->Track1()->Track()->Charge();
+  double chg2 = pair->Track2()->Track()->Charge();
+  double ptv1 = pair->Track1()->Track()->Pt();
+  double ptv2 = pair->Track2()->Track()->Pt();
+  double eta1 = pair->Track1()->Track()->P().PseudoRapidity();
+  double eta2 = pair->Track2()->Track()->P().PseudoRapidity();
+
   Double_t rad;
   Bool_t pass5 = kTRUE;
 
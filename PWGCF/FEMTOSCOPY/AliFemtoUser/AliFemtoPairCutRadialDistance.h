@@ -39,6 +39,7 @@ public:
   AliFemtoPairCutRadialDistance& operator=(const AliFemtoPairCutRadialDistance& c);
 
   virtual bool Pass(const AliFemtoPair* pair);
+  virtual void PassPairs(AliFemtoPair* const* pairs, size_t npairs, bool* passed);
   virtual AliFemtoString Report();
   virtual TList *ListSettings();
   virtual AliFemtoPairCut* Clone();
@@ -52,6 +53,11 @@ public:
 
 
  protected:
+  // Pass is split so that PassPairs reads the magnetic field once per batch;
+  // derived classes overriding Pass must override PassPairs as well
+  bool UpdateMagSign();
+  bool PassWithMagSign(const AliFemtoPair* pair);
+
   Double_t fDPhiStarMin;          // Minimum allowed pair separation //at the specified radius
   //Double_t fRadius;           // Radius at which the separation is calculated
   Double_t fEtaMin;           // Minimum allowed pair separation in eta
@@ -178,6 +178,16 @@ void AliFemtoQinvCorrFctnEMCIC::AddRealPair(AliFemtoPair* pair)
 
 }
 //____________________________
+void AliFemtoQinvCorrFctnEMCIC::AddRealPairs(AliFemtoPair* const* pairs, size_t npairs)
+{
+  AliFemtoCorrFctn::AddRealPairs(pairs, npairs);
+}
+//____________________________
+void AliFemtoQinvCorrFctnEMCIC::AddMixedPairs(AliFemtoPair* const* pairs, size_t npairs)
+{
+  AliFemtoCorrFctn::AddMixedPairs(pairs, npairs);
+}
+//____________________________
 void AliFemtoQinvCorrFctnEMCIC::AddMixedPair(AliFemtoPair* pair){
   // add mixed (background) pair
   if (fPairCut && !fPairCut->Pass(pair)) {
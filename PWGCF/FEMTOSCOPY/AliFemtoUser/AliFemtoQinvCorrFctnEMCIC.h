@@ -47,6 +47,9 @@ class AliFemtoQinvCorrFctnEMCIC : public AliFemtoQinvCorrFctn
 
   virtual void AddRealPair(AliFemtoPair* aPair);
   virtual void AddMixedPair(AliFemtoPair* aPair);
+  // the EMCICs are filled pair by pair
+  virtual void AddRealPairs(AliFemtoPair* const* pairs, size_t npairs);
+  virtual void AddMixedPairs(AliFemtoPair* const* pairs, size_t npairs);
 
 
 
@@ -16,6 +16,9 @@
 //Class Containing the Particles from previous Events up to a certain mixing
 //depth for one Particle Species and Mult/ZVtx Bin
 //ZVtx bin.
+//The events are kept in a ring of fMixingDepth slots: a new event overwrites
+//the oldest slot, reusing its memory, and the stored events are accessed by
+//reference through GetEvent, without copying them.
 class AliFemtoDreamPartContainer {
  public:
   AliFemtoDreamPartContainer();
@@ -24,18 +27,23 @@ class AliFemtoDreamPartContainer {
   virtual ~AliFemtoDreamPartContainer();
   void PrintLastEvent();
   void SetEvent(std::vector<AliFemtoDreamBasePart> &Particles);
-  std::deque<std::vector<AliFemtoDreamBasePart>> GetEventBuffer() const {
-    return fPartBuffer;
+  //Copy of the stored events, oldest first. Use GetEvent to avoid the copy.
+  std::deque<std::vector<AliFemtoDreamBasePart>> GetEventBuffer() const;
+  //Depth 0 is the oldest stored event
+  std::vector<AliFemtoDreamBasePart> &GetEvent(int Depth) {
+    return fPartBuffer[(fFirstEvent + Depth) % fMixingDepth];
   }
   ;
-  std::vector<AliFemtoDreamBasePart> &GetEvent(int Depth);
   unsigned int GetMixingDepth() const {
-    return fPartBuffer.size();
+    return fNEvents;
   }
   ;
  private:
-  std::deque<std::vector<AliFemtoDreamBasePart>> fPartBuffer;
-  unsigned int fMixingDepth;ClassDef(AliFemtoDreamPartContainer,2)
+  std::vector<std::vector<AliFemtoDreamBasePart>> fPartBuffer;
+  unsigned int fMixingDepth;
+  unsigned int fFirstEvent;  //slot of the oldest event
+  unsigned int fNEvents;     //number of stored events
+ClassDef(AliFemtoDreamPartContainer,3)
   ;
 };
 
@@ -15,6 +15,7 @@ ClassImp(AliFemtoDreamPartContainer)
 AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer()
     : fPartContainer(0),
       fPDGParticleSpecies(0),
+      fMassParticleSpecies(0),
       fWhichPairs(){
 }
 
@@ -23,10 +24,15 @@ AliFemtoDreamZVtxMultContainer::AliFemtoDreamZVtxMultContainer(
     : fPartContainer(conf->GetNParticles(),
                      AliFemtoDreamPartContainer(conf->GetMixingDepth())),
       fPDGParticleSpecies(conf->GetPDGCodes()),
+      fMassParticleSpecies(0),
       fWhichPairs(conf->GetWhichPairs()){
   TDatabasePDG::Instance()->AddParticle("deuteron", "deuteron", 1.8756134,
                                         kTRUE, 0.0, 1, "Nucleus", 1000010020);
   TDatabasePDG::Instance()->AddAntiParticle("anti-deuteron", -1000010020);
+  for (auto itPDG : fPDGParticleSpecies) {
+    TParticlePDG *pdgPart = TDatabasePDG::Instance()->GetParticle(itPDG);
+    fMassParticleSpecies.push_back(pdgPart ? pdgPart->Mass() : 0.);
+  }
 }
 
 AliFemtoDreamZVtxMultContainer::~AliFemtoDreamZVtxMultContainer() {
@@ -62,17 +68,19 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
   int HistCounter = 0;
   //First loop over all the different Species
   auto itPDGPar1 = fPDGParticleSpecies.begin();
+  auto itMassPar1 = fMassParticleSpecies.begin();
   for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
       ++itSpec1) {
     auto itPDGPar2 = fPDGParticleSpecies.begin();
     itPDGPar2 += itSpec1 - Particles.begin();
+    auto itMassPar2 = fMassParticleSpecies.begin();
+    itMassPar2 += itSpec1 - Particles.begin();
     for (auto itSpec2 = itSpec1; itSpec2 != Particles.end(); ++itSpec2) {
       HigherMath->FillPairCounterSE(HistCounter, itSpec1->size(),
                                     itSpec2->size());
       //Now loop over the actual Particles and correlate them
       for (auto itPart1 = itSpec1->begin(); itPart1 != itSpec1->end();
           ++itPart1) {
-        AliFemtoDreamBasePart part1 = *itPart1;
         std::vector<AliFemtoDreamBasePart>::iterator itPart2;
         if (itSpec1 == itSpec2) {
           itPart2 = itPart1 + 1;
@@ -80,16 +88,13 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
           itPart2 = itSpec2->begin();
         }
         while (itPart2 != itSpec2->end()) {
-          AliFemtoDreamBasePart part2 = *itPart2;
           TLorentzVector PartOne, PartTwo;
           PartOne.SetXYZM(
               itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-              itPart1->GetMomentum().Z(),
-              TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
+              itPart1->GetMomentum().Z(), *itMassPar1);
           PartTwo.SetXYZM(
               itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-              itPart2->GetMomentum().Z(),
-              TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
+              itPart2->GetMomentum().Z(), *itMassPar2);
           float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
           if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
                                                RelativeK, true, false)) {
@@ -97,9 +102,9 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
             continue;
           }
           RelativeK = HigherMath->FillSameEvent(HistCounter, iMult, cent,
-                                                part1,
+                                                *itPart1,
                                                 *itPDGPar1,
-                                                part2,
+                                                *itPart2,
                                                 *itPDGPar2);
           HigherMath->MassQA(HistCounter, RelativeK, *itPart1, *itPDGPar1,
                                                      *itPart2, *itPDGPar2);
@@ -112,8 +117,10 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesSE(
       }
       ++HistCounter;
       itPDGPar2++;
+      itMassPar2++;
     }
     itPDGPar1++;
+    itMassPar1++;
   }
 }
 
@@ -122,6 +129,7 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     AliFemtoDreamHigherPairMath *HigherMath, int iMult, float cent) {
   int HistCounter = 0;
   auto itPDGPar1 = fPDGParticleSpecies.begin();
+  auto itMassPar1 = fMassParticleSpecies.begin();
   //First loop over all the different Species
   for (auto itSpec1 = Particles.begin(); itSpec1 != Particles.end();
       ++itSpec1) {
@@ -129,6 +137,7 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
     //Particle1 + Particle2 == Particle2 + Particle 1
     int SkipPart = itSpec1 - Particles.begin();
     auto itPDGPar2 = fPDGParticleSpecies.begin() + SkipPart;
+    auto itMassPar2 = fMassParticleSpecies.begin() + SkipPart;
     for (auto itSpec2 = fPartContainer.begin() + SkipPart;
         itSpec2 != fPartContainer.end(); ++itSpec2) {
       if (itSpec1->size() > 0) {
@@ -136,7 +145,7 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
                                              (int) itSpec2->GetMixingDepth());
       }
       for (int iDepth = 0; iDepth < (int) itSpec2->GetMixingDepth(); ++iDepth) {
-        std::vector<AliFemtoDreamBasePart> ParticlesOfEvent = itSpec2->GetEvent(
+        std::vector<AliFemtoDreamBasePart> &ParticlesOfEvent = itSpec2->GetEvent(
             iDepth);
         HigherMath->FillPairCounterME(HistCounter, itSpec1->size(),
                                       ParticlesOfEvent.size());
@@ -148,12 +157,10 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
             TLorentzVector PartOne, PartTwo;
             PartOne.SetXYZM(
                 itPart1->GetMomentum().X(), itPart1->GetMomentum().Y(),
-                itPart1->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar1)->Mass());
+                itPart1->GetMomentum().Z(), *itMassPar1);
             PartTwo.SetXYZM(
                 itPart2->GetMomentum().X(), itPart2->GetMomentum().Y(),
-                itPart2->GetMomentum().Z(),
-                TDatabasePDG::Instance()->GetParticle(*itPDGPar2)->Mass());
+                itPart2->GetMomentum().Z(), *itMassPar2);
             float RelativeK = HigherMath->RelativePairMomentum(PartOne, PartTwo);
             if (!HigherMath->PassesPairSelection(HistCounter, *itPart1, *itPart2,
                                                  RelativeK, false, false)) {
@@ -176,7 +183,9 @@ void AliFemtoDreamZVtxMultContainer::PairParticlesME(
       }
       ++HistCounter;
       ++itPDGPar2;
+      ++itMassPar2;
     }
     ++itPDGPar1;
+    ++itMassPar1;
   }
 }
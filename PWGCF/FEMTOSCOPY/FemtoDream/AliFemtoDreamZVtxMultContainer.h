@@ -43,6 +43,7 @@ class AliFemtoDreamZVtxMultContainer {
  private:
   std::vector<AliFemtoDreamPartContainer> fPartContainer;
   std::vector<int> fPDGParticleSpecies;
+  std::vector<double> fMassParticleSpecies;  //masses of the species, looked up once
   std::vector<unsigned int> fWhichPairs;
 //  std::vector<bool> fRejPairs;
 //  bool fDoDeltaEtaDeltaPhiCut;
@@ -50,7 +51,7 @@ class AliFemtoDreamZVtxMultContainer {
 //  float fDeltaPhiMax;
 //  float fDeltaPhiEtaMax;
 
-ClassDef(AliFemtoDreamZVtxMultContainer, 4)
+ClassDef(AliFemtoDreamZVtxMultContainer, 5)
   ;
 };
 
@@ -49,7 +49,10 @@ AliHistogramManager::AliHistogramManager() :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(0)
+  fNVars(0),
+  fFillPlan(),
+  fFillPlanOffsets(),
+  fFillPlanCompiled(kFALSE)
 {
   //
   // Constructor
@@ -71,7 +74,10 @@ AliHistogramManager::AliHistogramManager(const Char_t* name, Int_t nvars) :
   fBinsAllocated(0),
   fVariableNames(),
   fVariableUnits(),
-  fNVars(nvars)
+  fNVars(nvars),
+  fFillPlan(),
+  fFillPlanOffsets(),
+  fFillPlanCompiled(kFALSE)
 {
   //
   // Constructor
@@ -131,6 +137,7 @@ void AliHistogramManager::AddHistClass(const Char_t* histClass) {
   hList->SetOwner(kTRUE);
   hList->SetName(histClass);
   fMainList.Add(hList);
+  fFillPlanCompiled = kFALSE;
 }
 
 //_________________________________________________________________
@@ -154,6 +161,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlanCompiled = kFALSE;
   TString hname = name;
   
   Int_t dimension = 1;
@@ -296,6 +304,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlanCompiled = kFALSE;
   TString hname = name;
   
   Int_t dimension = 1;
@@ -441,6 +450,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlanCompiled = kFALSE;
   TString hname = name;
   
   TString titleStr(title);
@@ -494,6 +504,7 @@ void AliHistogramManager::AddHistogram(const Char_t* histClass,
     cout << "Warning in AliHistogramManager::AddHistogram(): Histogram " << name << " already exists" << endl;
     return;
   }
+  fFillPlanCompiled = kFALSE;
   TString hname = name;
   
   TString titleStr(title);
@@ -768,6 +779,192 @@ void AliHistogramManager::FillHistClass(const Char_t* className, Float_t* values
   }
 }
 
+//__________________________________________________________________
+void AliHistogramManager::CompileFillPlans() {
+  //
+  // Compile all histogram classes into one flat list of fill instructions (variable indices, weight and histogram type).
+  // The UniqueID decoding and the checks on the used variables done by FillHistClass(const Char_t*, Float_t*) for every
+  // histogram and call are done here once; histograms which would never be filled are left out of the plan.
+  // The plans are invalidated whenever a histogram or a histogram class is added.
+  //
+  fFillPlan.clear();
+  fFillPlanOffsets.clear();
+  fFillPlanOffsets.reserve(fMainList.GetEntries()+1);
+  for(Int_t icl=0; icl<fMainList.GetEntries(); ++icl) {
+    fFillPlanOffsets.push_back(Int_t(fFillPlan.size()));
+    TIter next((THashList*)fMainList.At(icl));
+    TObject* h=0x0;
+    while((h=next())) {
+      FillPlanEntry entry;
+      entry.fHist = h;
+      entry.fNDim = 0;
+      
+      Int_t uid = h->GetUniqueID();
+      Bool_t isProfile = (uid%10==1 ? kTRUE : kFALSE);
+      Bool_t isTHn = ((uid%100)>10 ? kTRUE : kFALSE);
+      Int_t thnDim = (isTHn ? (uid%100)-10 : 0);
+      uid = (uid-(uid%100))/100;
+      Int_t varT = -1, varW = -1;
+      if(uid>0) {
+        varW = uid%(fNVars+1)-1;
+        if(varW==0) varW=AliReducedVarManager::kNothing;
+        uid = (uid-(uid%(fNVars+1)))/(fNVars+1);
+        if(uid>0) varT = uid - 1;
+      }
+      entry.fVarW = (varW>AliReducedVarManager::kNothing ? varW : -1);
+      
+      Bool_t usable = kTRUE;
+      if(!isTHn) {
+        TH1* h1 = (TH1*)h;
+        entry.fVars[0] = h1->GetXaxis()->GetUniqueID();
+        switch(h1->GetDimension()) {
+          case 1:
+            if(isProfile) {
+              entry.fKind = kFillProfile;
+              entry.fVars[1] = h1->GetYaxis()->GetUniqueID();
+              entry.fNDim = 2;
+            }
+            else {
+              entry.fKind = kFillTH1;
+              entry.fNDim = 1;
+            }
+          break;
+          case 2:
+            entry.fVars[1] = h1->GetYaxis()->GetUniqueID();
+            if(isProfile) {
+              entry.fKind = kFillProfile2D;
+              entry.fVars[2] = h1->GetZaxis()->GetUniqueID();
+              entry.fNDim = 3;
+            }
+            else {
+              entry.fKind = kFillTH2;
+              entry.fNDim = 2;
+            }
+          break;
+          case 3:
+            entry.fVars[1] = h1->GetYaxis()->GetUniqueID();
+            entry.fVars[2] = h1->GetZaxis()->GetUniqueID();
+            if(isProfile) {
+              entry.fKind = kFillProfile3D;
+              entry.fVars[3] = varT;
+              entry.fNDim = 4;
+            }
+            else {
+              entry.fKind = kFillTH3;
+              entry.fNDim = 3;
+            }
+          break;
+          default:
+            usable = kFALSE;
+          break;
+        }
+      }
+      else {
+        if(thnDim>fgkMaxFillDim) {
+          cout << "Warning in AliHistogramManager::CompileFillPlans(): Histogram " << h->GetName() << " has more than "
+               << fgkMaxFillDim << " dimensions and will not be filled" << endl;
+          continue;
+        }
+        entry.fKind = kFillTHn;
+        entry.fNDim = thnDim;
+        for(Int_t idim=0;idim<thnDim;++idim) entry.fVars[idim] = ((THnBase*)h)->GetAxis(idim)->GetUniqueID();
+      }
+      
+      for(Int_t ivar=0;ivar<entry.fNDim;++ivar)
+        usable &= (entry.fVars[ivar]>=0 && fUsedVars[entry.fVars[ivar]]);
+      if(entry.fVarW>=0) usable &= fUsedVars[entry.fVarW];
+      if(usable) fFillPlan.push_back(entry);
+    }
+  }
+  fFillPlanOffsets.push_back(Int_t(fFillPlan.size()));
+  fFillPlanCompiled = kTRUE;
+}
+
+//__________________________________________________________________
+Int_t AliHistogramManager::GetHistClassId(const Char_t* className) {
+  //
+  // Get the handle of a histogram class to be used with FillHistClass(Int_t, ...)
+  // The handle stays valid when further classes or histograms are added
+  //
+  if(!fFillPlanCompiled) CompileFillPlans();
+  TObject* hList = fMainList.FindObject(className);
+  if(!hList) return -1;
+  return fMainList.IndexOf(hList);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classId, Float_t* values) {
+  //
+  //  fill a class of histograms using its compiled plan
+  //
+  if(!fFillPlanCompiled) CompileFillPlans();
+  if(classId<0 || classId>=Int_t(fFillPlanOffsets.size())-1) return;
+  
+  for(Int_t i=fFillPlanOffsets[classId]; i<fFillPlanOffsets[classId+1]; ++i)
+    FillPlanned(fFillPlan[i], values);
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillHistClass(Int_t classId, Int_t nEntries, Float_t* values, Int_t stride /*=AliReducedVarManager::kNVars*/) {
+  //
+  //  fill a class of histograms with nEntries value vectors stored one after the other, stride values apart.
+  //  Each histogram receives the entries in the given order, so the result is the same as for nEntries
+  //  calls of FillHistClass(classId, values+i*stride)
+  //
+  if(!fFillPlanCompiled) CompileFillPlans();
+  if(classId<0 || classId>=Int_t(fFillPlanOffsets.size())-1) return;
+  
+  for(Int_t i=fFillPlanOffsets[classId]; i<fFillPlanOffsets[classId+1]; ++i) {
+    const FillPlanEntry& entry = fFillPlan[i];
+    for(Int_t ientry=0; ientry<nEntries; ++ientry)
+      FillPlanned(entry, values+ientry*stride);
+  }
+}
+
+//__________________________________________________________________
+void AliHistogramManager::FillPlanned(const FillPlanEntry& entry, const Float_t* values) const {
+  //
+  //  fill one histogram of a compiled plan
+  //
+  const Int_t* vars = entry.fVars;
+  const Int_t varW = entry.fVarW;
+  switch(entry.fKind) {
+    case kFillTH1:
+      if(varW>=0) ((TH1F*)entry.fHist)->Fill(values[vars[0]],values[varW]);
+      else        ((TH1F*)entry.fHist)->Fill(values[vars[0]]);
+    break;
+    case kFillProfile:
+      if(varW>=0) ((TProfile*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[varW]);
+      else        ((TProfile*)entry.fHist)->Fill(values[vars[0]],values[vars[1]]);
+    break;
+    case kFillTH2:
+      if(varW>=0) ((TH2F*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[varW]);
+      else        ((TH2F*)entry.fHist)->Fill(values[vars[0]],values[vars[1]]);
+    break;
+    case kFillProfile2D:
+      if(varW>=0) ((TProfile2D*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[varW]);
+      else        ((TProfile2D*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+    break;
+    case kFillTH3:
+      if(varW>=0) ((TH3F*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[varW]);
+      else        ((TH3F*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]]);
+    break;
+    case kFillProfile3D:
+      if(varW>=0) ((TProfile3D*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]],values[varW]);
+      else        ((TProfile3D*)entry.fHist)->Fill(values[vars[0]],values[vars[1]],values[vars[2]],values[vars[3]]);
+    break;
+    case kFillTHn: {
+      Double_t fillValues[fgkMaxFillDim];
+      for(Int_t idim=0;idim<entry.fNDim;++idim) fillValues[idim] = values[vars[idim]];
+      if(varW>=0) ((THnBase*)entry.fHist)->Fill(fillValues,values[varW]);
+      else        ((THnBase*)entry.fHist)->Fill(fillValues);
+    }
+    break;
+    default:
+    break;
+  }
+}
+
 //__________________________________________________________________
 void AliHistogramManager::WriteOutput(TFile* save) {
   //
@@ -802,6 +999,7 @@ THashList* AliHistogramManager::AddHistogramsToOutputList() {
     fOutputList.Add(list);
   }
   fOutputList.SetOwner(kTRUE);
+  CompileFillPlans();
   return &fOutputList;
 }
 
@@ -14,6 +14,8 @@
 #include <TList.h>
 #include <THashList.h>
 
+#include <vector>
+
 #include "AliReducedVarManager.h"
 
 class TAxis;
@@ -69,6 +71,11 @@ class AliHistogramManager : public TObject {
                         TAxis* axis);
   
   void FillHistClass(const Char_t* className, Float_t* values);
+  // fast filling through precompiled histogram class plans
+  void CompileFillPlans();
+  Int_t GetHistClassId(const Char_t* className);     // returns -1 if the class does not exist
+  void FillHistClass(Int_t classId, Float_t* values);
+  void FillHistClass(Int_t classId, Int_t nEntries, Float_t* values, Int_t stride=AliReducedVarManager::kNVars);   // entry i starts at values+i*stride
   
   void SetUseDefaultVariableNames(Bool_t flag) {fUseDefaultVariableNames = flag;};
   void SetDefaultVarNames(TString* vars, TString* units);
@@ -106,9 +113,27 @@ class AliHistogramManager : public TObject {
   TString fVariableUnits[AliReducedVarManager::kNVars];               //! variable units
   Int_t fNVars;                          // maximum number of variables
   
+  // histogram types distinguished in the fill plans
+  enum EFillKind {
+    kFillTH1=0, kFillProfile, kFillTH2, kFillProfile2D, kFillTH3, kFillProfile3D, kFillTHn
+  };
+  static const Int_t fgkMaxFillDim = 20;          // maximum number of variables of a planned histogram
+  // one histogram in a compiled histogram class plan
+  struct FillPlanEntry {
+    TObject* fHist;                 // histogram to be filled
+    Int_t fKind;                    // histogram type, see EFillKind
+    Int_t fNDim;                    // number of variables used for the coordinates (THn dimension, or 1-4 for TH1 based histograms)
+    Int_t fVars[fgkMaxFillDim];     // variable indices of the coordinates
+    Int_t fVarW;                    // weight variable, -1 if unweighted
+  };
+  std::vector<FillPlanEntry> fFillPlan;      //! compiled fill plans of all histogram classes, stored contiguously
+  std::vector<Int_t> fFillPlanOffsets;       //! index in fFillPlan of the first histogram of each class (size nclasses+1)
+  Bool_t fFillPlanCompiled;                  //! the fill plans are in sync with the histogram lists
+  
   void MakeAxisLabels(TAxis* ax, const Char_t* labels);
+  void FillPlanned(const FillPlanEntry& entry, const Float_t* values) const;
   
-  ClassDef(AliHistogramManager, 4)
+  ClassDef(AliHistogramManager, 5)
 };
 
 #endif
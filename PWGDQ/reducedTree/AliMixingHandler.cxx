@@ -47,7 +47,10 @@ AliMixingHandler::AliMixingHandler(Int_t mixingSetup /* = kMixResonanceLegs*/) :
   fHistos(0x0),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fMixTracks(),
+  fMixTrackFlags(),
+  fMixTrackOffsets()
 {
   // 
   // default constructor
@@ -87,7 +90,10 @@ AliMixingHandler::AliMixingHandler(const Char_t* name, const Char_t* title, Int_
   fHistos(0x0),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fMixTracks(),
+  fMixTrackFlags(),
+  fMixTrackOffsets()
 {
   //
   // Named constructor
@@ -453,39 +459,57 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
   Int_t entries = leg1Pool->GetEntries();
   if(entries<2) return;
   
+  // resolve the histogram classes once per mixing run instead of looking them up by name for every pair
   TObjArray* histClassArr = fHistClassNames.Tokenize(";");
+  TArrayI histClassIds(histClassArr->GetEntries());
+  for(Int_t i=0; i<histClassArr->GetEntries(); ++i) histClassIds[i] = fHistos->GetHistClassId(histClassArr->At(i)->GetName());
+  delete histClassArr;
   
+  // Copy the tracks of the pool into dense per-event blocks, keeping only those with at least one
+  //  enabled mixing bit, together with their flags already AND-ed with the mixing mask.
+  //  The O(depth^2) pairing loops below only read these arrays; a track is accessed only for pairs sharing a cut bit.
+  //  The tracks of leg L (0 or 1) in event iev are in [fMixTrackOffsets[L*(entries+1)+iev], fMixTrackOffsets[L*(entries+1)+iev+1])
+  fMixTracks.clear();
+  fMixTrackFlags.clear();
+  fMixTrackOffsets.assign(2*(entries+1), 0);
   TIter iterEv1Leg1Pool(leg1Pool);
   TIter iterEv1Leg2Pool(leg2Pool);
+  for(Int_t ileg=0; ileg<2; ++ileg) {
+    TIter& iterPool = (ileg==0 ? iterEv1Leg1Pool : iterEv1Leg2Pool);
+    for(Int_t iev=0; iev<entries; ++iev) {
+      fMixTrackOffsets[ileg*(entries+1)+iev] = Int_t(fMixTracks.size());
+      TIter iterLeg((TList*)iterPool());
+      AliReducedBaseTrack* track=0x0;
+      while((track=(AliReducedBaseTrack*)iterLeg())) {
+        ULong_t flags = mixingMask & track->GetFlags();
+        if(!flags) continue;
+        fMixTracks.push_back(track);
+        fMixTrackFlags.push_back(flags);
+      }
+    }
+    fMixTrackOffsets[ileg*(entries+1)+entries] = Int_t(fMixTracks.size());
+  }
+  const Int_t* leg1Offsets = &fMixTrackOffsets[0];
+  const Int_t* leg2Offsets = &fMixTrackOffsets[entries+1];
+  
   ULong_t testFlags1 = 0;
   ULong_t testFlags2 = 0;
   for(Int_t iev1=0; iev1<entries; ++iev1) {                            // first event loop
-    // get the lists of leg1 and leg2 tracks for the first event
-    TList* ev1Leg1List = (TList*)iterEv1Leg1Pool();
-    TList* ev1Leg2List = (TList*)iterEv1Leg2Pool();
-    
-    TIter iterEv2Leg1Pool(leg1Pool);
-    TIter iterEv2Leg2Pool(leg2Pool);
     for(Int_t iev2=0; iev2<entries; ++iev2) {                         // second event loop
-      TList* ev2Leg1List = (TList*)iterEv2Leg1Pool();
-      TList* ev2Leg2List = (TList*)iterEv2Leg2Pool();
       if(iev1==iev2) continue;
       
-      //loop over the ev1-leg1 list
-      TIter iterLeg1(ev1Leg1List);
-      AliReducedBaseTrack* ev1Leg1=0x0;
-      while((ev1Leg1=(AliReducedBaseTrack*)iterLeg1())) {
-        // check that this track has at least one common bit with the mixing mask
-        testFlags1 = mixingMask & ev1Leg1->GetFlags();
-        if(!testFlags1) continue;
+      //loop over the ev1-leg1 tracks
+      for(Int_t i1=leg1Offsets[iev1]; i1<leg1Offsets[iev1+1]; ++i1) {
+        // flags of this track common with the mixing mask
+        testFlags1 = fMixTrackFlags[i1];
+        AliReducedBaseTrack* ev1Leg1 = fMixTracks[i1];
 	
-        //loop over the ev2-leg2 list
-        TIter iterLeg2(ev2Leg2List);
-        AliReducedBaseTrack* ev2Leg2=0x0;
-        while((ev2Leg2=(AliReducedBaseTrack*)iterLeg2())) {
+        //loop over the ev2-leg2 tracks
+        for(Int_t i2=leg2Offsets[iev2]; i2<leg2Offsets[iev2+1]; ++i2) {
           // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-          testFlags2 = testFlags1 & ev2Leg2->GetFlags();
+          testFlags2 = testFlags1 & fMixTrackFlags[i2];
           if(!testFlags2) continue;
+          AliReducedBaseTrack* ev2Leg2 = fMixTracks[i2];
 	  
           // fill cross-pairs (leg1 - leg2) for the enabled bits
           if(fMixingSetup==kMixResonanceLegs) AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg2, type, values);
@@ -499,10 +523,10 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
                 if (fNParallelPairCuts>1) {
                   for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
                     if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
-                    fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*3*fNParallelCuts+1)->GetName(), values);
+                    fHistos->FillHistClass(histClassIds[ibit*3+jbit*3*fNParallelCuts+1], values);
                   }
                 } else {
-                  fHistos->FillHistClass(histClassArr->At(ibit*3+1)->GetName(), values);
+                  fHistos->FillHistClass(histClassIds[ibit*3+1], values);
                 }
               }
               if(fMixingSetup==kMixCorrelation) {
@@ -511,27 +535,26 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
                   ULong_t pairCutMaskCorr = (reinterpret_cast<AliReducedPairInfo*>(ev1Leg1))->GetQualityFlags();
                   for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
                     if (!((pairCutMaskCorr)&(ULong_t(1)<<jbit))) continue;
-                    if (fMixLikeSign) fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*fNParallelCuts+pairType)->GetName(), values);
-                    else              fHistos->FillHistClass(histClassArr->At(ibit+jbit*fNParallelCuts)->GetName(), values);
+                    if (fMixLikeSign) fHistos->FillHistClass(histClassIds[ibit*3+jbit*fNParallelCuts+pairType], values);
+                    else              fHistos->FillHistClass(histClassIds[ibit+jbit*fNParallelCuts], values);
                   }
                 } else {
-                  if (fMixLikeSign) fHistos->FillHistClass(histClassArr->At(ibit*3+pairType)->GetName(), values);
-                  else              fHistos->FillHistClass(histClassArr->At(ibit)->GetName(), values);
+                  if (fMixLikeSign) fHistos->FillHistClass(histClassIds[ibit*3+pairType], values);
+                  else              fHistos->FillHistClass(histClassIds[ibit], values);
                 }
               }
             }
           }  
-	}  // end loop over the ev2-leg2 list
+	}  // end loop over the ev2-leg2 tracks
 	
 	if(fMixingSetup==kMixCorrelation) continue;
 	if(!fMixLikeSign) continue;
-	// loop over the ev2-leg1 list
-	TIter iterLeg1LS(ev2Leg1List);
-	AliReducedBaseTrack* ev2Leg1=0x0;
-	while((ev2Leg1=(AliReducedBaseTrack*)iterLeg1LS())) {
+	// loop over the ev2-leg1 tracks
+	for(Int_t i2=leg1Offsets[iev2]; i2<leg1Offsets[iev2+1]; ++i2) {
 	  // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-	  testFlags2 = testFlags1 & ev2Leg1->GetFlags();
+	  testFlags2 = testFlags1 & fMixTrackFlags[i2];
           if(!testFlags2) continue;
+          AliReducedBaseTrack* ev2Leg1 = fMixTracks[i2];
 	  
 	  // fill like-pairs (leg1 - leg1) for the enabled bits
 	  AliReducedVarManager::FillPairInfoME(ev1Leg1, ev2Leg1, type, values);
@@ -543,33 +566,30 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
             if (fNParallelPairCuts>1) {
                 for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
                     if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
-                    fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*3*fNParallelCuts+0)->GetName(), values);
+                    fHistos->FillHistClass(histClassIds[ibit*3+jbit*3*fNParallelCuts+0], values);
                 }
             } else {
-                fHistos->FillHistClass(histClassArr->At(ibit*3+0)->GetName(), values);
+                fHistos->FillHistClass(histClassIds[ibit*3+0], values);
             }
         }
       }
-	}  // end loop over the ev2-leg1 list
-  }  // end loop over the ev1-leg1 list
+	}  // end loop over the ev2-leg1 tracks
+  }  // end loop over the ev1-leg1 tracks
       
   if(fMixingSetup==kMixCorrelation) continue;
     if(!fMixLikeSign) continue;
-    //loop over the ev1-leg2 list
-    TIter iterLeg2(ev1Leg2List);
-    AliReducedBaseTrack* ev1Leg2=0x0;
-    while((ev1Leg2=(AliReducedBaseTrack*)iterLeg2())) {
-	// check that this track has at least one common bit with the mixing mask
-	    testFlags1 = mixingMask & ev1Leg2->GetFlags();
-        if(!testFlags1) continue;
+    //loop over the ev1-leg2 tracks
+    for(Int_t i1=leg2Offsets[iev1]; i1<leg2Offsets[iev1+1]; ++i1) {
+	// flags of this track common with the mixing mask
+	    testFlags1 = fMixTrackFlags[i1];
+        AliReducedBaseTrack* ev1Leg2 = fMixTracks[i1];
 	
-	    //loop over the ev2-leg2 list 
-        TIter iterLeg2LS(ev2Leg2List);
-        AliReducedBaseTrack* ev2Leg2=0x0;
-        while((ev2Leg2=(AliReducedBaseTrack*)iterLeg2LS())) {
+	    //loop over the ev2-leg2 tracks
+        for(Int_t i2=leg2Offsets[iev2]; i2<leg2Offsets[iev2+1]; ++i2) {
             // check that this track has at least one common bit with the mixing mask and with ev1-leg1
-            testFlags2 = testFlags1 & ev2Leg2->GetFlags();
+            testFlags2 = testFlags1 & fMixTrackFlags[i2];
             if(!testFlags2) continue;
+            AliReducedBaseTrack* ev2Leg2 = fMixTracks[i2];
 	  
             // fill like-pairs (leg2 - leg2) for the enabled bits
             AliReducedVarManager::FillPairInfoME(ev1Leg2, ev2Leg2, type, values);
@@ -581,15 +601,15 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
                     if (fNParallelPairCuts>1) {
                         for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
                             if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
-                            fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*3*fNParallelCuts+2)->GetName(), values);
+                            fHistos->FillHistClass(histClassIds[ibit*3+jbit*3*fNParallelCuts+2], values);
                         }
                     } else {
-                        fHistos->FillHistClass(histClassArr->At(ibit*3+2)->GetName(), values);
+                        fHistos->FillHistClass(histClassIds[ibit*3+2], values);
                     }
                 }
             }
-        }  // end loop over the ev2-leg2 list
-     }  // end loop over the ev1-leg2 list
+        }  // end loop over the ev2-leg2 tracks
+     }  // end loop over the ev1-leg2 tracks
    }  // end second event loop
  }  // end first event loop
   
@@ -14,10 +14,14 @@
 #include <TList.h>
 #include <TString.h>
 
+#include <vector>
+
 #include "AliHistogramManager.h"
 #include "AliReducedVarManager.h"
 #include "AliReducedInfoCut.h"
 
+class AliReducedBaseTrack;
+
 class AliMixingHandler : public TNamed {
    
 public:
@@ -111,11 +115,16 @@ private:
   TList fLikePairsLeg1Cuts;    // cut object for LEG1 like pairs
   TList fLikePairsLeg2Cuts;    // cut object for LEG2 like pairs
   
+  // dense copy of the pool being mixed, rebuilt in RunEventMixing()
+  std::vector<AliReducedBaseTrack*> fMixTracks;     //! tracks with at least one enabled mixing bit, grouped per leg and event
+  std::vector<ULong_t> fMixTrackFlags;              //! track flags AND-ed with the mixing mask
+  std::vector<Int_t> fMixTrackOffsets;              //! start of each (leg,event) block in fMixTracks
+  
   void RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
   ULong_t IncrementPoolSizes(TList* list1, TList* list2, Int_t eventCategory);
   void ResetPoolSizes(ULong_t mixingMask, Int_t category);  
   
-  ClassDef(AliMixingHandler,4);
+  ClassDef(AliMixingHandler,5);
 };
 
 #endif
@@ -496,9 +496,16 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedBaseTrack* track,
          AliReducedTrackInfo* trackInfo = dynamic_cast<AliReducedTrackInfo*>(track);
          if(!trackInfo) continue;
          
+         // the flag histogram classes are filled many times per track, so look them up only once
+         const Int_t statusFlagsClass = fHistosManager->GetHistClassId(Form("%sStatusFlags_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()));
+         const Int_t qualityFlagsClass = fHistosManager->GetHistClassId(Form("%sQualityFlags_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()));
+         const Int_t itsClusterMapClass = fHistosManager->GetHistClassId(Form("%sITSclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()));
+         const Int_t itsSharedClusterMapClass = fHistosManager->GetHistClassId(Form("%sITSsharedClusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()));
+         const Int_t tpcClusterMapClass = fHistosManager->GetHistClassId(Form("%sTPCclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()));
+         
          for(UInt_t iflag=0; iflag<AliReducedVarManager::kNTrackingFlags; ++iflag) {
             AliReducedVarManager::FillTrackingFlag(trackInfo, iflag, fValues);
-            fHistosManager->FillHistClass(Form("%sStatusFlags_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(statusFlagsClass, fValues);
             if(mcDecisionMap) {
                for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
                   if(mcDecisionMap & (UInt_t(1)<<iMC))
@@ -509,7 +516,7 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedBaseTrack* track,
          }
          for(UInt_t iflag=0; iflag<64; ++iflag) {
             AliReducedVarManager::FillTrackQualityFlag(trackInfo, iflag, fValues);
-            fHistosManager->FillHistClass(Form("%sQualityFlags_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(qualityFlagsClass, fValues);
             if(mcDecisionMap) {
                for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
                   if(mcDecisionMap & (UInt_t(1)<<iMC))
@@ -520,7 +527,7 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedBaseTrack* track,
          }
          for(Int_t iLayer=0; iLayer<6; ++iLayer) {
             AliReducedVarManager::FillITSlayerFlag(trackInfo, iLayer, fValues);
-            fHistosManager->FillHistClass(Form("%sITSclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(itsClusterMapClass, fValues);
             if(mcDecisionMap) {
                for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
                   if(mcDecisionMap & (UInt_t(1)<<iMC))
@@ -529,7 +536,7 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedBaseTrack* track,
                }
             }
             AliReducedVarManager::FillITSsharedLayerFlag(trackInfo, iLayer, fValues);
-            fHistosManager->FillHistClass(Form("%sITSsharedClusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(itsSharedClusterMapClass, fValues);
             if(mcDecisionMap) {
                for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
                   if(mcDecisionMap & (UInt_t(1)<<iMC))
@@ -540,7 +547,7 @@ void AliReducedAnalysisJpsi2ee::FillTrackHistograms(AliReducedBaseTrack* track,
          }
          for(Int_t iLayer=0; iLayer<8; ++iLayer) {
             AliReducedVarManager::FillTPCclusterBitFlag(trackInfo, iLayer, fValues);
-            fHistosManager->FillHistClass(Form("%sTPCclusterMap_%s", trackClass.Data(), fTrackCuts.At(icut)->GetName()), fValues);
+            fHistosManager->FillHistClass(tpcClusterMapClass, fValues);
             if(mcDecisionMap) {
                for(Int_t iMC=0; iMC<=fLegCandidatesMCcuts.GetEntries(); ++iMC) {
                   if(mcDecisionMap & (UInt_t(1)<<iMC))
@@ -46,7 +46,8 @@ AliHFEcontainer::AliHFEcontainer():
   fCorrelationMatrices(NULL),
   fVariables(NULL),
   fNVars(0),
-  fNEvents(0)
+  fNEvents(0),
+  fContainerHandles(NULL)
 {
   //
   // Default constructor
@@ -60,7 +61,8 @@ AliHFEcontainer::AliHFEcontainer(const Char_t *name):
   fCorrelationMatrices(NULL),
   fVariables(NULL),
   fNVars(0),
-  fNEvents(0)
+  fNEvents(0),
+  fContainerHandles(NULL)
 {
   //
   // Default constructor
@@ -76,7 +78,8 @@ AliHFEcontainer::AliHFEcontainer(const Char_t *name, UInt_t nVar):
   fCorrelationMatrices(NULL),
   fVariables(NULL),
   fNVars(0),
-  fNEvents(0)
+  fNEvents(0),
+  fContainerHandles(NULL)
 {
   //
   // Constructor
@@ -94,7 +97,8 @@ AliHFEcontainer::AliHFEcontainer(const AliHFEcontainer &ref):
   fCorrelationMatrices(NULL),
   fVariables(NULL),
   fNVars(ref.fNVars),
-  fNEvents(ref.fNEvents)
+  fNEvents(ref.fNEvents),
+  fContainerHandles(NULL)
 {
   //
   // Copy constructor
@@ -134,10 +138,14 @@ AliHFEcontainer &AliHFEcontainer::operator=(const AliHFEcontainer &ref){
   // Cleanup old object, create a new one with new containers inside
   //
   if(this == &ref) return *this;
+  // handles point to the containers which are replaced
+  delete fContainerHandles;
+  fContainerHandles = NULL;
   this->~AliHFEcontainer(); // cleanup old object before creating the new onwe
   TNamed::operator=(ref);
   fContainers = new THashList();
   fCorrelationMatrices = NULL;
+  fContainerHandles = NULL;
   fNVars = ref.fNVars;
   if(fNVars){
     fVariables = new TObjArray(fNVars);
@@ -179,6 +187,7 @@ AliHFEcontainer::~AliHFEcontainer(){
   //
   delete fContainers;
   if(fCorrelationMatrices) delete fCorrelationMatrices;
+  if(fContainerHandles) delete fContainerHandles;
   if(fVariables){
     fVariables->Delete();
     delete fVariables;
@@ -352,6 +361,48 @@ void AliHFEcontainer::FillCFContainerStepname(const Char_t *name, const Char_t *
   cont->Fill(content, mystep, weight);
 }
 
+//__________________________________________________________________
+Int_t AliHFEcontainer::GetContainerHandle(const Char_t *name) const {
+  //
+  // Resolve the container by name once and return a handle for
+  // FillCFContainerByHandle, which skips the name lookup per fill.
+  // Handles stay valid as long as the container exists.
+  // Returns -1 if the container is not found
+  //
+  AliCFContainer *cont = GetCFContainer(name);
+  if(!cont) return -1;
+  if(!fContainerHandles) fContainerHandles = new TObjArray;
+  Int_t handle = fContainerHandles->IndexOf(cont);
+  if(handle < 0){
+    fContainerHandles->Add(cont);
+    handle = fContainerHandles->GetLast();
+  }
+  return handle;
+}
+
+//__________________________________________________________________
+void AliHFEcontainer::FillCFContainerByHandle(Int_t handle, UInt_t step, const Double_t * const content, Double_t weight) const {
+  //
+  // Fill container resolved via GetContainerHandle
+  //
+  if(!fContainerHandles || handle < 0 || handle > fContainerHandles->GetLast()){
+    AliError(Form("Invalid container handle %d", handle));
+    return;
+  }
+  AliCFContainer *cont = static_cast<AliCFContainer *>(fContainerHandles->UncheckedAt(handle));
+  cont->Fill(content, step, weight);
+}
+
+//__________________________________________________________________
+void AliHFEcontainer::SetFillBufferSize(Int_t size) const {
+  //
+  // Enable (size > 0) or disable buffered filling for all containers
+  //
+  TIter next(fContainers);
+  AliCFContainer *cont = NULL;
+  while((cont = dynamic_cast<AliCFContainer *>(next()))) cont->SetFillBufferSize(size);
+}
+
 //__________________________________________________________________
 AliCFContainer *AliHFEcontainer::MakeMergedCFContainer(const Char_t *name, const Char_t *title, const Char_t* contnames) const {
   //
@@ -60,6 +60,9 @@ class AliHFEcontainer : public TNamed{
     THashList *GetListOfCorrelationMatrices() const { return fCorrelationMatrices; }
     void FillCFContainer(const Char_t *name, UInt_t step, const Double_t * const content, Double_t weight = 1.) const;
     void FillCFContainerStepname(const Char_t *name, const Char_t *step, const Double_t *const content, Double_t weight = 1.) const;
+    Int_t GetContainerHandle(const Char_t *name) const;
+    void FillCFContainerByHandle(Int_t handle, UInt_t step, const Double_t * const content, Double_t weight = 1.) const;
+    void SetFillBufferSize(Int_t size) const;
     AliCFContainer *MakeMergedCFContainer(const Char_t *name, const Char_t *title, const Char_t *contnames) const;
 
     Int_t GetNumberOfCFContainers() const;
@@ -102,6 +105,7 @@ class AliHFEcontainer : public TNamed{
     TObjArray *fVariables;      // Variable Information
     UInt_t fNVars;              // Number of Variables
     Int_t fNEvents;             // Number of Events
+    mutable TObjArray *fContainerHandles; //! Containers resolved by name, indexed by handle (not owned)
 
     ClassDef(AliHFEcontainer, 1)  // HFE Efficiency Container
 };
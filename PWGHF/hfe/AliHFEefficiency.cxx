@@ -224,6 +224,7 @@ void AliHFEefficiency::FilterMC(){
   //
   Double_t cont[4] = {0., 0., 0., 0.};
   AliMCParticle *track = NULL;
+  Int_t mcfilter = fEfficiency->GetContainerHandle("MCFilter");
   for(Int_t itrack = 0; itrack < fMCEvent->GetNumberOfTracks(); itrack++){
     track = dynamic_cast<AliMCParticle *>(fMCEvent->GetTrack(itrack));
     if(!track) continue;
@@ -234,9 +235,9 @@ void AliHFEefficiency::FilterMC(){
     cont[3] = track->Charge()/3;
     //AliMCParticle *mother = dynamic_cast<AliMCParticle *>(fMCEvent->GetTrack(track->Particle()->GetFirstMother()));
     //if(TMath::Abs(mother->Particle()->GetPdgCode()) != 443) continue;
-    fEfficiency->FillCFContainer("MCFilter", 0, cont);
+    fEfficiency->FillCFContainerByHandle(mcfilter, 0, cont);
     if(!fAcceptanceCuts->IsSelected(track)) continue;
-    fEfficiency->FillCFContainer("MCFilter", 1, cont);
+    fEfficiency->FillCFContainerByHandle(mcfilter, 1, cont);
   }
 }
 
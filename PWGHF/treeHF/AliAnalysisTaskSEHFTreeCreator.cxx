@@ -291,6 +291,9 @@ fMinJetPt(0.0),
 fSoftDropZCut(0.1),
 fSoftDropBeta(0.0),
 fTrackingEfficiency(1.0),
+fTreeBasketSize(0),
+fTreeCompression(-1),
+fTreeFloatMantissaBits(-1),
 fGoodTrackFilterBit(-1),
 fGoodTrackEtaRange(999.),
 fGoodTrackMinPt(0.),
@@ -693,6 +696,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(6);
     TString nameoutput = "tree_D0";
     fTreeHandlerD0 = new AliHFTreeHandlerD0toKpi(fPIDoptD0);
+    ConfigureTreeStorage(fTreeHandlerD0);
     fTreeHandlerD0->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerD0->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerD0->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -709,6 +713,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(7);
       TString nameoutput = "tree_D0_gen";
       fTreeHandlerGenD0 = new AliHFTreeHandlerD0toKpi(0);
+      ConfigureTreeStorage(fTreeHandlerGenD0);
       fTreeHandlerGenD0->SetFillJets(fFillJets);
       fTreeHandlerGenD0->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenD0->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -722,6 +727,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(8);
     TString nameoutput = "tree_Ds";
     fTreeHandlerDs = new AliHFTreeHandlerDstoKKpi(fPIDoptDs);
+    ConfigureTreeStorage(fTreeHandlerDs);
     fTreeHandlerDs->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerDs->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerDs->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -739,6 +745,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(9);
       TString nameoutput = "tree_Ds_gen";
       fTreeHandlerGenDs = new AliHFTreeHandlerDstoKKpi(0);
+      ConfigureTreeStorage(fTreeHandlerGenDs);
       fTreeHandlerGenDs->SetFillJets(fFillJets);
       fTreeHandlerGenDs->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenDs->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -752,6 +759,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(10);
     TString nameoutput = "tree_Dplus";
     fTreeHandlerDplus = new AliHFTreeHandlerDplustoKpipi(fPIDoptDplus);
+    ConfigureTreeStorage(fTreeHandlerDplus);
     fTreeHandlerDplus->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerDplus->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerDplus->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -767,6 +775,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(11);
       TString nameoutput = "tree_Dplus_gen";
       fTreeHandlerGenDplus = new AliHFTreeHandlerDplustoKpipi(0);
+      ConfigureTreeStorage(fTreeHandlerGenDplus);
       fTreeHandlerGenDplus->SetFillJets(fFillJets);
       fTreeHandlerGenDplus->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenDplus->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -780,6 +789,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(12);
     TString nameoutput = "tree_LctopKpi";
     fTreeHandlerLctopKpi = new AliHFTreeHandlerLctopKpi(fPIDoptLctopKpi);
+    ConfigureTreeStorage(fTreeHandlerLctopKpi);
     fTreeHandlerLctopKpi->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerLctopKpi->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerLctopKpi->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -795,6 +805,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(13);
       TString nameoutput = "tree_LctopKpi_gen";
       fTreeHandlerGenLctopKpi = new AliHFTreeHandlerLctopKpi(0);
+      ConfigureTreeStorage(fTreeHandlerGenLctopKpi);
       fTreeHandlerGenLctopKpi->SetFillJets(fFillJets);
       fTreeHandlerGenLctopKpi->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenLctopKpi->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -809,6 +820,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(14);
     TString nameoutput = "tree_Bplus";
     fTreeHandlerBplus = new AliHFTreeHandlerBplustoD0pi(fPIDoptBplus);
+    ConfigureTreeStorage(fTreeHandlerBplus);
     fTreeHandlerBplus->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerBplus->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerBplus->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -824,6 +836,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(15);
       TString nameoutput = "tree_Bplus_gen";
       fTreeHandlerGenBplus = new AliHFTreeHandlerBplustoD0pi(0);
+      ConfigureTreeStorage(fTreeHandlerGenBplus);
       fTreeHandlerGenBplus->SetFillJets(fFillJets);
       fTreeHandlerGenBplus->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenBplus->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -837,6 +850,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(16);
     TString nameoutput = "tree_Dstar";
     fTreeHandlerDstar = new AliHFTreeHandlerDstartoKpipi(fPIDoptDstar);
+    ConfigureTreeStorage(fTreeHandlerDstar);
     fTreeHandlerDstar->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerDstar->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerDstar->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -852,6 +866,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(17);
       TString nameoutput = "tree_Dstar_gen";
       fTreeHandlerGenDstar = new AliHFTreeHandlerDstartoKpipi(0);
+      ConfigureTreeStorage(fTreeHandlerGenDstar);
       fTreeHandlerGenDstar->SetFillJets(fFillJets);
       fTreeHandlerGenDstar->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenDstar->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -865,6 +880,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(18);
     TString nameoutput = "tree_Lc2V0bachelor";
     fTreeHandlerLc2V0bachelor = new AliHFTreeHandlerLc2V0bachelor(fPIDoptLc2V0bachelor);
+    ConfigureTreeStorage(fTreeHandlerLc2V0bachelor);
     fTreeHandlerLc2V0bachelor->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerLc2V0bachelor->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerLc2V0bachelor->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -881,6 +897,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(19);
       TString nameoutput = "tree_Lc2V0bachelor_gen";
       fTreeHandlerGenLc2V0bachelor = new AliHFTreeHandlerLc2V0bachelor(0);
+      ConfigureTreeStorage(fTreeHandlerGenLc2V0bachelor);
       fTreeHandlerGenLc2V0bachelor->SetFillJets(fFillJets);
       fTreeHandlerGenLc2V0bachelor->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenLc2V0bachelor->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -894,6 +911,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(20);
     TString nameoutput = "tree_Bs";
     fTreeHandlerBs = new AliHFTreeHandlerBstoDspi(fPIDoptBs);
+    ConfigureTreeStorage(fTreeHandlerBs);
     fTreeHandlerBs->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerBs->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerBs->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -910,6 +928,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(21);
       TString nameoutput = "tree_Bs_gen";
       fTreeHandlerGenBs = new AliHFTreeHandlerBstoDspi(0);
+      ConfigureTreeStorage(fTreeHandlerGenBs);
       fTreeHandlerGenBs->SetFillJets(fFillJets);
       fTreeHandlerGenBs->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenBs->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -923,6 +942,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(22);
     TString nameoutput = "tree_Lb";
     fTreeHandlerLb = new AliHFTreeHandlerLbtoLcpi(fPIDoptLb);
+    ConfigureTreeStorage(fTreeHandlerLb);
     fTreeHandlerLb->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerLb->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerLb->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
@@ -939,6 +959,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(23);
       TString nameoutput = "tree_Lb_gen";
       fTreeHandlerGenLb = new AliHFTreeHandlerLbtoLcpi(0);
+      ConfigureTreeStorage(fTreeHandlerGenLb);
       fTreeHandlerGenLb->SetFillJets(fFillJets);
       fTreeHandlerGenLb->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenLb->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -954,6 +975,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     OpenFile(24);
     TString nameoutput = "tree_InclusiveJet";
     fTreeHandlerInclusiveJet = new AliHFTreeHandlerInclusiveJet();
+    ConfigureTreeStorage(fTreeHandlerInclusiveJet);
     fTreeHandlerInclusiveJet->SetFillJets(fFillJets);
     fTreeHandlerInclusiveJet->SetDoJetSubstructure(fDoJetSubstructure);
     fTreeHandlerInclusiveJet->SetTrackingEfficiency(fTrackingEfficiency);
@@ -967,6 +989,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
       OpenFile(25);
       TString nameoutput = "tree_InclusiveJet_gen";
       fTreeHandlerGenInclusiveJet = new AliHFTreeHandlerInclusiveJet();
+      ConfigureTreeStorage(fTreeHandlerGenInclusiveJet);
       fTreeHandlerGenInclusiveJet->SetFillJets(fFillJets);
       fTreeHandlerGenInclusiveJet->SetDoJetSubstructure(fDoJetSubstructure);
       fTreeHandlerGenInclusiveJet->SetJetProperties(fJetRadius,fJetAlgorithm,fMinJetPt);
@@ -4170,6 +4193,16 @@ Bool_t AliAnalysisTaskSEHFTreeCreator::IsCandidateFromHijing(AliAODRecoDecayHF *
   
 }
 //________________________________________________________________________
+void AliAnalysisTaskSEHFTreeCreator::ConfigureTreeStorage(AliHFTreeHandler *handler) const
+{
+  //
+  // Pass the storage options of the candidate trees to a tree handler
+  //
+  if(fTreeBasketSize>0) handler->SetBasketSize(fTreeBasketSize);
+  if(fTreeCompression>=0) handler->SetBranchCompression("*",fTreeCompression);
+  if(fTreeFloatMantissaBits>=0) handler->SetBranchFloatPrecision("*",fTreeFloatMantissaBits);
+}
+//________________________________________________________________________
 void AliAnalysisTaskSEHFTreeCreator::SelectGoodTrackForReconstruction(AliAODEvent *aod, Int_t trkEntries, Int_t &nSeleTrks,Bool_t *seleFlags)
 {
   //
@@ -158,6 +158,9 @@ public:
     void SetSoftDropZCut(Double_t d) {fSoftDropZCut = d; }
     void SetSoftDropBeta(Double_t d) {fSoftDropBeta = d; }
     void SetTrackingEfficiency(Double_t d) {fTrackingEfficiency = d;}
+    void SetTreeBasketSize(Int_t bytes) {fTreeBasketSize = bytes;}
+    void SetTreeCompression(Int_t settings) {fTreeCompression = settings;}
+    void SetTreeFloatPrecision(Int_t mantissabits) {fTreeFloatMantissaBits = mantissabits;}
     void SetDoPtHard(bool b) {fDoPtHard = b;}
   
     void SetGoodTrackFilterBit(Int_t i) { fGoodTrackFilterBit = i; }
@@ -240,6 +243,7 @@ public:
 private:
     
     AliAnalysisTaskSEHFTreeCreator(const AliAnalysisTaskSEHFTreeCreator&);
+    void ConfigureTreeStorage(AliHFTreeHandler *handler) const;
     AliAnalysisTaskSEHFTreeCreator& operator=(const AliAnalysisTaskSEHFTreeCreator&);
     
     unsigned int            fEventNumber;
@@ -444,6 +448,9 @@ private:
     Double_t                fSoftDropZCut;                         /// setting the soft drop z parameter
     Double_t                fSoftDropBeta;                         /// setting the soft drop beta parameter
     Double_t                fTrackingEfficiency;                   /// Setting the jet finding tracking efficiency
+    Int_t                   fTreeBasketSize;                       /// basket size of the candidate-tree branches (0 = ROOT default)
+    Int_t                   fTreeCompression;                      /// compression settings of the candidate-tree branches (-1 = file default)
+    Int_t                   fTreeFloatMantissaBits;                /// mantissa bits stored for the candidate-tree floats (-1 = full precision)
   
     Int_t                   fGoodTrackFilterBit;                   /// Setting filter bit for bachelor on-the-fly reconstruction candidate
     Double_t                fGoodTrackEtaRange;                    /// Setting eta-range for bachelor on-the-fly reconstruction candidate
@@ -529,7 +536,7 @@ private:
     AliCDBEntry *fCdbEntry;
 
     /// \cond CLASSIMP
-    ClassDef(AliAnalysisTaskSEHFTreeCreator,30);
+    ClassDef(AliAnalysisTaskSEHFTreeCreator,31);
     /// \endcond
 };
 
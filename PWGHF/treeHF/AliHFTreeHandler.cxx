@@ -20,10 +20,13 @@
 /////////////////////////////////////////////////////////////
 
 #include <cmath>
+#include <cstring>
 #include <limits>
 
 #include "TMath.h"
 #include "TFile.h"
+#include "TLeaf.h"
+#include "TRegexp.h"
 
 #include "AliHFTreeHandler.h"
 #include "AliPID.h"
@@ -138,7 +141,16 @@ AliHFTreeHandler::AliHFTreeHandler():
   fMinJetPt(0.0),
   fSoftDropZCut(0.1),
   fSoftDropBeta(0.0),
-  fTrackingEfficiency(1.0)
+  fTrackingEfficiency(1.0),
+  fBasketSize(0),
+  fCompressionPatterns(),
+  fCompressionSettings(),
+  fReducedPrecisionPatterns(),
+  fReducedPrecisionBits(),
+  fReducedPrecisionAddress(),
+  fReducedPrecisionLen(),
+  fReducedPrecisionMask(),
+  fTreeStorageConfigured(nullptr)
 {
   //
   // Default constructor
@@ -280,7 +292,16 @@ AliHFTreeHandler::AliHFTreeHandler(int PIDopt):
   fMinJetPt(0.0),
   fSoftDropZCut(0.1),
   fSoftDropBeta(0.0),
-  fTrackingEfficiency(1.0)
+  fTrackingEfficiency(1.0),
+  fBasketSize(0),
+  fCompressionPatterns(),
+  fCompressionSettings(),
+  fReducedPrecisionPatterns(),
+  fReducedPrecisionBits(),
+  fReducedPrecisionAddress(),
+  fReducedPrecisionLen(),
+  fReducedPrecisionMask(),
+  fTreeStorageConfigured(nullptr)
 {
   //
   // Standard constructor
@@ -333,6 +354,90 @@ AliHFTreeHandler::~AliHFTreeHandler()
   if(fPidCombined) delete fPidCombined;
 }
 
+//________________________________________________________________
+void AliHFTreeHandler::SetBranchCompression(TString branchpattern, int settings)
+{
+  //
+  // set the compression settings (e.g. 505 for ZSTD level 5) of the branches matching
+  // the wildcard pattern; if several patterns match a branch, the last one is used
+  //
+  fCompressionPatterns.push_back(branchpattern);
+  fCompressionSettings.push_back(settings);
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::SetBranchFloatPrecision(TString branchpattern, int mantissabits)
+{
+  //
+  // store the float branches matching the wildcard pattern with only mantissabits (< 23)
+  // bits of mantissa, rounded to nearest; the branches stay float, but the dropped bits
+  // are zero and compress away. If several patterns match a branch, the last one is used
+  //
+  if(mantissabits<0) mantissabits=0;
+  fReducedPrecisionPatterns.push_back(branchpattern);
+  fReducedPrecisionBits.push_back(mantissabits);
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::ApplyStorageOptions()
+{
+  //
+  // apply the storage options to the current tree (called at the first fill)
+  //
+  fTreeStorageConfigured = fTreeVar;
+  fReducedPrecisionAddress.clear();
+  fReducedPrecisionLen.clear();
+  fReducedPrecisionMask.clear();
+
+  if(fBasketSize>0) fTreeVar->SetBasketSize("*",fBasketSize);
+
+  TIter nextBranch(fTreeVar->GetListOfBranches());
+  TBranch* branch = nullptr;
+  while((branch = (TBranch*)nextBranch())) {
+    TString branchname = branch->GetName();
+    for(unsigned int iPattern=0; iPattern<fCompressionPatterns.size(); iPattern++) {
+      TRegexp re(fCompressionPatterns[iPattern],kTRUE);
+      if(branchname.Index(re)!=kNPOS) branch->SetCompressionSettings(fCompressionSettings[iPattern]);
+    }
+  }
+
+  TIter nextLeaf(fTreeVar->GetListOfLeaves());
+  TLeaf* leaf = nullptr;
+  while((leaf = (TLeaf*)nextLeaf())) {
+    if(strcmp(leaf->GetTypeName(),"Float_t") || leaf->GetLeafCount() || !leaf->GetValuePointer()) continue;
+    TString branchname = leaf->GetBranch()->GetName();
+    int bits = -1;
+    for(unsigned int iPattern=0; iPattern<fReducedPrecisionPatterns.size(); iPattern++) {
+      TRegexp re(fReducedPrecisionPatterns[iPattern],kTRUE);
+      if(branchname.Index(re)!=kNPOS) bits = fReducedPrecisionBits[iPattern];
+    }
+    if(bits<0 || bits>=23) continue;
+    fReducedPrecisionAddress.push_back((float*)leaf->GetValuePointer());
+    fReducedPrecisionLen.push_back(leaf->GetLen());
+    fReducedPrecisionMask.push_back(~((1u<<(23-bits))-1u));
+  }
+}
+
+//________________________________________________________________
+void AliHFTreeHandler::ReduceFloatPrecision()
+{
+  //
+  // round the reduced-precision floats to the kept mantissa bits (inf and nan are left untouched)
+  //
+  for(unsigned int iAddr=0; iAddr<fReducedPrecisionAddress.size(); iAddr++) {
+    unsigned int mask = fReducedPrecisionMask[iAddr];
+    unsigned int half = (~mask+1u)>>1;
+    float* values = fReducedPrecisionAddress[iAddr];
+    for(int iVal=0; iVal<fReducedPrecisionLen[iAddr]; iVal++) {
+      unsigned int word;
+      memcpy(&word,&values[iVal],sizeof(word));
+      if((word&0x7f800000u)==0x7f800000u) continue;
+      word = (word+half)&mask;
+      memcpy(&values[iVal],&word,sizeof(word));
+    }
+  }
+}
+
 //________________________________________________________________
 TTree* AliHFTreeHandler::BuildTreeMCGen(TString name, TString title) {
 
@@ -106,6 +106,8 @@ class AliHFTreeHandler : public TObject
         fCandType=0;
       }
       else {      
+        if(fTreeVar!=fTreeStorageConfigured) ApplyStorageOptions();
+        if(!fReducedPrecisionAddress.empty()) ReduceFloatPrecision();
         fTreeVar->Fill(); 
         fCandType=0;
         fRunNumberPrevCand = fRunNumber;
@@ -136,6 +138,11 @@ class AliHFTreeHandler : public TObject
     }
 
     void SetDauInAcceptance(bool dauinacc = true) {fDauInAcceptance=dauinacc;}
+
+    //storage options of the tree, applied at the first FillTree after BuildTree
+    void SetBasketSize(int bytes) {fBasketSize=bytes;}
+    void SetBranchCompression(TString branchpattern, int settings);
+    void SetBranchFloatPrecision(TString branchpattern, int mantissabits);
   
     static bool IsSelectedStd(int candtype) {
       if(candtype&1) return true;
@@ -201,6 +208,10 @@ class AliHFTreeHandler : public TObject
     int RoundFloatToInt(double num);
     float ComputeMaxd0MeasMinusExp(AliAODRecoDecayHF* cand, float bfield);
     float GetTOFmomentum(AliAODTrack* track, AliPIDResponse* pidrespo);
+
+    //storage methods
+    void ApplyStorageOptions();
+    void ReduceFloatPrecision();
   
     void GetNsigmaTPCMeanSigmaData(float &mean, float &sigma, AliPID::EParticleType species, float pTPC, float eta);
 
@@ -325,8 +336,18 @@ class AliHFTreeHandler : public TObject
     Double_t fSoftDropBeta; //soft drop beta  parameter
     Double_t fTrackingEfficiency;
 
+    int fBasketSize; /// basket size of the tree branches (0 = ROOT default)
+    vector<TString> fCompressionPatterns; /// branch-name patterns with custom compression
+    vector<int> fCompressionSettings; /// compression settings for each pattern
+    vector<TString> fReducedPrecisionPatterns; /// branch-name patterns of floats stored with reduced precision
+    vector<int> fReducedPrecisionBits; /// mantissa bits kept for each pattern
+    vector<float*> fReducedPrecisionAddress; //!<! addresses of the reduced-precision floats
+    vector<int> fReducedPrecisionLen; //!<! number of floats at each address
+    vector<unsigned int> fReducedPrecisionMask; //!<! mantissa mask for each address
+    TTree* fTreeStorageConfigured; //!<! tree to which the storage options were applied
+
   /// \cond CLASSIMP
-  ClassDef(AliHFTreeHandler,9); ///
+  ClassDef(AliHFTreeHandler,10); ///
   /// \endcond
 };
 #endif
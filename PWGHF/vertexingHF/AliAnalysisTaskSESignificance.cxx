@@ -26,6 +26,7 @@
 /////////////////////////////////////////////////////////////
 
 #include <Riostream.h>
+#include <vector>
 #include <TClonesArray.h>
 #include <TCanvas.h>
 #include <TList.h>
@@ -88,7 +89,8 @@ AliAnalysisTaskSESignificance::AliAnalysisTaskSESignificance():
   fNVars(0),
   fNBins(100),
   fPartOrAndAntiPart(0),
-  fDsChannel(0)
+  fDsChannel(0),
+  fIntegrateCellsAtTerminate(kFALSE)
 {
   // Default constructor
   SetPDGCodes();
@@ -128,7 +130,8 @@ AliAnalysisTaskSESignificance::AliAnalysisTaskSESignificance(const char *name, T
   fNVars(0),
   fNBins(100),
   fPartOrAndAntiPart(0),
-  fDsChannel(0)
+  fDsChannel(0),
+  fIntegrateCellsAtTerminate(kFALSE)
 {
 
   SetPDGCodes();
@@ -620,8 +623,9 @@ void AliAnalysisTaskSESignificance::UserExec(Option_t */*option*/)
       TString mdvname=Form("multiDimVectorPtBin%d",ptbin);
       AliMultiDimVector* muvec=(AliMultiDimVector*)fCutList->FindObject(mdvname.Data());
 
-      ULong64_t *addresses = muvec->GetGlobalAddressesAboveCuts(fVars,(Float_t)d->Pt(),nVals);
-      if(fDebug>1)printf("nvals = %d\n",nVals);
+      Int_t nPassed=0;
+      ULong64_t *addresses = GetCellAddressesToFill(muvec,(Float_t)d->Pt(),nVals,nPassed);
+      if(fDebug>1)printf("nvals = %d\n",nPassed);
       for(Int_t ivals=0;ivals<nVals;ivals++){
 	if(addresses[ivals]>=muvec->GetNTotCells()){
 	  if (fDebug>1) printf("Overflow!!\n");
@@ -629,7 +633,8 @@ void AliAnalysisTaskSESignificance::UserExec(Option_t */*option*/)
 	  return;
 	}
 	
-	fHistNEvents->Fill(3);
+	if(fIntegrateCellsAtTerminate) fHistNEvents->Fill(3,nPassed);
+	else fHistNEvents->Fill(3);
 	
 	//fill the histograms with the appropriate method
 	switch (fDecChannel){
@@ -664,8 +669,8 @@ void AliAnalysisTaskSESignificance::UserExec(Option_t */*option*/)
 	nVals=0;
 	fRDCuts->GetCutVarsForOpt(d,fVars,fNVars,fPDGdaughters,aod);
 	delete [] addresses;
-	addresses = muvec->GetGlobalAddressesAboveCuts(fVars,(Float_t)d->Pt(),nVals);
-	if(fDebug>1)printf("nvals = %d\n",nVals);
+	addresses = GetCellAddressesToFill(muvec,(Float_t)d->Pt(),nVals,nPassed);
+	if(fDebug>1)printf("nvals = %d\n",nPassed);
 	for(Int_t ivals=0;ivals<nVals;ivals++){
 	  if(addresses[ivals]>=muvec->GetNTotCells()){
 	    if (fDebug>1) printf("Overflow!!\n");
@@ -1023,12 +1028,69 @@ void AliAnalysisTaskSESignificance::Terminate(Option_t */*option*/)
     
   }
   
-
+  if(fIntegrateCellsAtTerminate){
+    IntegrateCellHistos("hMass");
+    IntegrateCellHistos("hSig");
+    IntegrateCellHistos("hBkg");
+    IntegrateCellHistos("hRfl");
+  }
  
   
   return;
 }
 //_________________________________________________________________________________________________
+ULong64_t* AliAnalysisTaskSESignificance::GetCellAddressesToFill(const AliMultiDimVector* muvec, Float_t pt, Int_t& nVals, Int_t& nPassed) const{
+  /// Returns the addresses of the cut cells to be filled for the candidate,
+  /// nPassed is the number of cells passed by the candidate.
+  /// With fIntegrateCellsAtTerminate only the tightest passed cell is returned
+  /// and the others are recovered by IntegrateCellHistos in Terminate
+  if(!fIntegrateCellsAtTerminate){
+    ULong64_t *addresses=muvec->GetGlobalAddressesAboveCuts(fVars,pt,nVals);
+    nPassed=nVals;
+    return addresses;
+  }
+  nVals=0;
+  ULong64_t tightest=muvec->GetTightestGlobalAddressAboveCuts(fVars,pt,nPassed);
+  if(nPassed==0) return 0x0;
+  ULong64_t *addresses=new ULong64_t[1];
+  addresses[0]=tightest;
+  nVals=1;
+  return addresses;
+}
+//_________________________________________________________________________________________________
+void AliAnalysisTaskSESignificance::IntegrateCellHistos(const char* prefix){
+  /// Adds to the histogram of each cut cell those of all the tighter cells,
+  /// one suffix sum per cut variable (see AliMultiDimVector::Integrate)
+  AliMultiDimVector* mdv=(AliMultiDimVector*)fCutList->FindObject("multiDimVectorPtBin0");
+  if(!mdv) return;
+  Int_t nHistpermv=mdv->GetNTotCells();
+  Int_t nHist=nHistpermv*fNPtBins;
+  TString pref=Form("%s_",prefix);
+  std::vector<TH1F*> histos(nHist,(TH1F*)0x0);
+  Int_t nFound=0;
+  TIter next(fOutput);
+  while(TObject* obj=next()){
+    TString hname=obj->GetName();
+    if(!hname.BeginsWith(pref)) continue;
+    Int_t index=TString(hname(pref.Length(),hname.Length())).Atoi();
+    if(index>=0 && index<nHist && obj->InheritsFrom(TH1F::Class())){
+      histos[index]=(TH1F*)obj;
+      nFound++;
+    }
+  }
+  if(nFound<nHist) return;
+  for(Int_t iVar=0;iVar<mdv->GetNVariables();iVar++){
+    ULong64_t stride=mdv->GetAddressStride(iVar);
+    ULong64_t nSteps=mdv->GetNCutSteps(iVar);
+    for(Int_t iPtBin=0;iPtBin<fNPtBins;iPtBin++){
+      Int_t offset=iPtBin*nHistpermv;
+      for(ULong64_t i=nHistpermv; i-->0;){
+	if((i/stride)%nSteps<nSteps-1) histos[offset+i]->Add(histos[offset+i+stride]);
+      }
+    }
+  }
+}
+//_________________________________________________________________________________________________
 Int_t AliAnalysisTaskSESignificance::CheckOrigin(const AliAODMCParticle* mcPart, const TClonesArray* mcArray)const{
 
 	//
@@ -46,6 +46,10 @@ class AliAnalysisTaskSESignificance : public AliAnalysisTaskSE
   void SetDsChannel(Int_t chan){fDsChannel=chan;}
   void SetUseSelBit(Bool_t selBit=kTRUE){fUseSelBit=selBit;}
   void SetAODMismatchProtection(Int_t opt=0) {fAODProtection=opt;}
+  /// fill per candidate only the tightest cut cell passed and integrate
+  /// the cell histograms in Terminate (the output on file before
+  /// Terminate contains the non-integrated histograms)
+  void SetIntegrateCellsAtTerminate(Bool_t opt=kTRUE){fIntegrateCellsAtTerminate=opt;}
 
   //void SetMultiVector(const AliMultiDimVector *MultiDimVec){fMultiDimVec->CopyStructure(MultiDimVec);}
   Float_t GetUpperMassLimit()const {return fUpmasslimit;}
@@ -55,6 +59,7 @@ class AliAnalysisTaskSESignificance : public AliAnalysisTaskSE
   Int_t GetBFeedDown()const {return fBFeedDown;}
   Int_t GetDsChannel()const {return fDsChannel;}
   Bool_t GetUseSelBit()const {return fUseSelBit;}
+  Bool_t GetIntegrateCellsAtTerminate()const {return fIntegrateCellsAtTerminate;}
 
   /// Implementation of interface methods
   virtual void UserCreateOutputObjects();
@@ -85,6 +90,8 @@ class AliAnalysisTaskSESignificance : public AliAnalysisTaskSE
   Int_t GetBackgroundHistoIndex(Int_t iPtBin) const { return iPtBin*3+2;}
   Int_t GetLSHistoIndex(Int_t iPtBin)const { return iPtBin*5;}
   Int_t CheckOrigin(const AliAODMCParticle* mcPart, const TClonesArray* mcArray) const;
+  ULong64_t* GetCellAddressesToFill(const AliMultiDimVector* muvec, Float_t pt, Int_t& nVals, Int_t& nPassed) const;
+  void IntegrateCellHistos(const char* prefix);
 
   void FillDplus(AliAODRecoDecayHF* d,TClonesArray *arrayMC,Int_t index,Int_t isSel);
   void FillD02p(AliAODRecoDecayHF* d,TClonesArray *arrayMC,Int_t index, Int_t isSel);
@@ -129,9 +136,10 @@ class AliAnalysisTaskSESignificance : public AliAnalysisTaskSE
   Int_t fDsChannel;          /// Ds resonant channel selected
   Int_t fPDGDStarToD0pi[2]; /// PDG codes for the particles in the D* -> pi + D0 decay
   Int_t fPDGD0ToKpi[2];    /// PDG codes for the particles in the D0 -> K + pi decay
+  Bool_t fIntegrateCellsAtTerminate; /// flag to fill only the tightest cell passed and integrate in Terminate
 
   /// \cond CLASSIMP    
-  ClassDef(AliAnalysisTaskSESignificance,6); /// AliAnalysisTaskSE for the MC association of heavy-flavour decay candidates
+  ClassDef(AliAnalysisTaskSESignificance,7); /// AliAnalysisTaskSE for the MC association of heavy-flavour decay candidates
   /// \endcond
 };
 
@@ -22,6 +22,11 @@
 #include <TF1.h>
 #include <TLatex.h>
 #include <TFile.h>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,12,0)
+#include <ROOT/TProcessExecutor.hxx>
+#include <ROOT/TSeq.hxx>
+#endif
 #include "AliHFMassFitter.h"
 #include "AliHFMassFitterVAR.h"
 #include "AliHFMultiTrials.h"
@@ -65,6 +70,7 @@ AliHFMultiTrials::AliHFMultiTrials() :
   fUseFixSigFixMean(kTRUE),
   fSaveBkgVal(kFALSE),
   fDrawIndividualFits(kFALSE),
+  fNumOfWorkers(1),
   fHistoRawYieldDistAll(0x0),
   fHistoRawYieldTrialAll(0x0),
   fHistoSigmaTrialAll(0x0),
@@ -189,12 +195,16 @@ Bool_t AliHFMultiTrials::CreateHistos(){
 //________________________________________________________________________
 Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   // perform the multiple fits
+  // The list of all trials (rebin x first bin x fit range x background
+  // function x sigma/mean configuration) is built first. The fits are then
+  // performed, in parallel processes if SetNumberOfWorkers(n>1) was called,
+  // and the output histograms and ntuple are filled in the trial order,
+  // so that the output does not depend on the number of workers.
 
   Bool_t hOK=CreateHistos();
   if(!hOK) return kFALSE;
 
   Int_t itrial=0;
-  Int_t types=0;
   Int_t itrialBC=0;
   Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
 
@@ -202,18 +212,23 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   fMaxYieldGlob=0.;
   Float_t xnt[15];
 
+  // rebinned histograms, kept until all the fits are done
+  std::vector<TH1F*> hRebinned;
   for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
     Int_t rebin=fRebinSteps[ir];
     for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
-      TH1F* hRebinned=0x0;
-      if(fNumOfFirstBinSteps==1) hRebinned=RebinHisto(hInvMassHisto,rebin,-1);
-      else hRebinned=RebinHisto(hInvMassHisto,rebin,iFirstBin);
+      if(fNumOfFirstBinSteps==1) hRebinned.push_back(RebinHisto(hInvMassHisto,rebin,-1));
+      else hRebinned.push_back(RebinHisto(hInvMassHisto,rebin,iFirstBin));
+    }
+  }
+
+  // list of trials
+  std::vector<TrialConf> trials;
+  for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
+    for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
+      Int_t iHisto=ir*fNumOfFirstBinSteps+iFirstBin-1;
       for(Int_t iMinMass=0; iMinMass<fNumOfLowLimFitSteps; iMinMass++){
-        Double_t minMassForFit=fLowLimFitSteps[iMinMass];
-        Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
         for(Int_t iMaxMass=0; iMaxMass<fNumOfUpLimFitSteps; iMaxMass++){
-          Double_t maxMassForFit=fUpLimFitSteps[iMaxMass];
-          Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
           ++itrial;
           for(Int_t typeb=0; typeb<kNBkgFuncCases; typeb++){
             if(typeb==kExpoBkg && !fUseExpoBkg) continue;
@@ -231,219 +246,309 @@ Bool_t AliHFMultiTrials::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
               if (igs==kFreeSigFreeMean  && !fUseFreeS) continue;
               if (igs==kFixSigFreeMean  && !fUseFixSigFreeMean) continue;
               if (igs==kFixSigFixMean   && !fUseFixSigFixMean) continue;
-              Int_t theCase=igs*kNBkgFuncCases+typeb;
-              Int_t globBin=itrial+theCase*totTrials;
-              for(Int_t j=0; j<15; j++) xnt[j]=0.;
-
-              Bool_t mustDeleteFitter = kTRUE;
-              AliHFMassFitterVAR*  fitter=0x0;
-              //if D0 Reflection
-              if(fhTemplRefl){
-                fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
-                fitter->SetTemplateReflections(fhTemplRefl);
-                fitter->SetFixReflOverS(fFixRefloS,kTRUE);
-              }
-              else {
-                if(typeb<=kPol2Bkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
-                }else if(typeb==kPowBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
-                }else if(typeb==kPowTimesExpoBkg){
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
-                }else{
-                  fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
-                  if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
-                  if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
-                  if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
-                }
-                fitter->SetReflectionSigmaFactor(0);
-              }
-              if(fFitOption==0) {
-                fitter->SetUseLikelihoodFit();
-                Printf("Using likelihood fit");
-              }
-              else if(fFitOption==1) {
-                fitter->SetUseChi2Fit();
-                Printf("Using chi2 fit");
-              }
-              else if (fFitOption==2) {
-                fitter->SetUseLikelihoodWithWeightsFit();
-                Printf("Using likelihood fit with weights");
-              }
-              fitter->SetInitialGaussianMean(fMassD);
-              fitter->SetInitialGaussianSigma(fSigmaGausMC);
-              xnt[0]=rebin;
-              xnt[1]=iFirstBin;
-              xnt[2]=minMassForFit;
-              xnt[3]=maxMassForFit;
-              xnt[4]=typeb;
-              xnt[6]=0;
-              if(igs==kFixSigFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                xnt[5]=1;
-              }else if(igs==kFixSigUpFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
-                xnt[5]=2;
-              }else if(igs==kFixSigDownFreeMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
-                xnt[5]=3;
-              }else if(igs==kFreeSigFreeMean){
-                xnt[5]=0;
-              }else if(igs==kFixSigFixMean){
-                fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=1;
-                xnt[6]=1;
-              }else if(igs==kFreeSigFixMean){
-                fitter->SetFixGaussianMean(fMassD,kTRUE);
-                xnt[5]=0;
-                xnt[6]=1;
-              }
-              Bool_t out=kFALSE;
-              Double_t chisq=-1.;
-              Double_t sigma=0.;
-              Double_t esigma=0.;
-              Double_t pos=.0;
-              Double_t epos=.0;
-              Double_t ry=.0;
-              Double_t ery=.0;
-              Double_t significance=0.;
-              Double_t erSignif=0.;
-              Double_t bkg=0.;
-              Double_t erbkg=0.;
-              Double_t bkgBEdge=0;
-              Double_t erbkgBEdge=0;
-              TF1* fB1=0x0;
-              if(typeb<kNBkgFuncCases){
-                printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
-                out=fitter->MassFitter(0);
-                chisq=fitter->GetReducedChiSquare();
-                fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
-                sigma=fitter->GetSigma();
-                pos=fitter->GetMean();
-                esigma=fitter->GetSigmaUncertainty();
-                if(esigma<0.00001) esigma=0.0001;
-                epos=fitter->GetMeanUncertainty();
-                if(epos<0.00001) epos=0.0001;
-                ry=fitter->GetRawYield();
-                ery=fitter->GetRawYieldError();
-                fB1=fitter->GetBackgroundFullRangeFunc();
-                fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
-                Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
-                Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
-                fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
-                if(out && fDrawIndividualFits && thePad){
-                  thePad->Clear();
-                  fitter->DrawHere(thePad, fnSigmaForBkgEval);
-                  fMassFitters.push_back(fitter);
-                  mustDeleteFitter = kFALSE;
-                  for (auto format : fInvMassFitSaveAsFormats) {
-                    thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
-                  }
-                }
-              }
-              // else{
-              //   out=DoFitWithPol3Bkg(hRebinned,hmin,hmax,igs);
-              //   if(out && thePad){
-              // 	thePad->Clear();
-              // 	hRebinned->Draw();
-              // 	TF1* fSB=(TF1*)hRebinned->GetListOfFunctions()->FindObject("fSB");
-              // 	fB1=new TF1("fB1","[0]+[1]*x+[2]*x*x+[3]*x*x*x",hmin,hmax);
-              // 	for(Int_t j=0; j<4; j++) fB1->SetParameter(j,fSB->GetParameter(3+j));
-              // 	fB1->SetLineColor(2);
-              // 	fB1->Draw("same");
-              // 	fSB->SetLineColor(4);
-              // 	fSB->Draw("same");
-              // 	thePad->Update();
-              // 	chisq=fSB->GetChisquare()/fSB->GetNDF();;
-              // 	sigma=fSB->GetParameter(2);
-              // 	esigma=fSB->GetParError(2);
-              // 	if(esigma<0.00001) esigma=0.0001;
-              // 	pos=fSB->GetParameter(1);
-              // 	epos=fSB->GetParError(1);
-              // 	if(epos<0.00001) epos=0.0001;
-              // 	ry=fSB->GetParameter(0)/hRebinned->GetBinWidth(1);
-              // 	ery=fSB->GetParError(0)/hRebinned->GetBinWidth(1);
-              //   }
-              // }
-              xnt[7]=chisq;
-              if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
-                xnt[8]=significance;
-                xnt[9]=pos;
-                xnt[10]=epos;
-                xnt[11]=sigma;
-                xnt[12]=esigma;
-                xnt[13]=ry;
-                xnt[14]=ery;
-                fHistoRawYieldDistAll->Fill(ry);
-                fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
-                fHistoRawYieldTrialAll->SetBinError(globBin,ery);
-                fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
-                fHistoSigmaTrialAll->SetBinError(globBin,esigma);
-                fHistoMeanTrialAll->SetBinContent(globBin,pos);
-                fHistoMeanTrialAll->SetBinError(globBin,epos);
-                fHistoChi2TrialAll->SetBinContent(globBin,chisq);
-                fHistoChi2TrialAll->SetBinError(globBin,0.00001);
-                fHistoSignifTrialAll->SetBinContent(globBin,significance);
-                fHistoSignifTrialAll->SetBinError(globBin,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrialAll->SetBinContent(globBin,bkg);
-                  fHistoBkgTrialAll->SetBinError(globBin,erbkg);
-                  fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
-                  fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
-                }
-
-                if(ry<fMinYieldGlob) fMinYieldGlob=ry;
-                if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
-                fHistoRawYieldDist[theCase]->Fill(ry);
-                fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
-                fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
-                fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
-                fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
-                fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
-                fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
-                fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
-                fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
-                fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
-                fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
-                if(fSaveBkgVal) {
-                  fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
-                  fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
-                  fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
-                }
-
-                for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
-                  Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
-                  Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
-                  if(minMassBC>minMassForFit &&
-                      maxMassBC<maxMassForFit &&
-                      minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
-                      maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
-                    Double_t cnts,ecnts;
-                    BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
-                    ++itrialBC;
-                    fHistoRawYieldDistBinCAll->Fill(cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
-                    fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);
-                    fHistoRawYieldDistBinC[theCase]->Fill(cnts);
-                  }
-                }
-              }
-              if (mustDeleteFitter) delete fitter;
-              fNtupleMultiTrials->Fill(xnt);
+              TrialConf conf;
+              conf.fRebinStep=ir;
+              conf.fFirstBin=iFirstBin;
+              conf.fHisto=iHisto;
+              conf.fMinMassStep=iMinMass;
+              conf.fMaxMassStep=iMaxMass;
+              conf.fBkgFunc=typeb;
+              conf.fSigConf=igs;
+              conf.fTrial=itrial;
+              trials.push_back(conf);
             }
           }
         }
       }
-      delete hRebinned;
     }
   }
+
+  // fits
+  Int_t nTrials=trials.size();
+  std::vector<std::vector<Double_t> > results;
+  Bool_t drawFits=(fDrawIndividualFits && thePad);
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,12,0)
+  if(fNumOfWorkers>1 && drawFits){
+    Printf("AliHFMultiTrials: individual fits can only be drawn in the main process, running the fits serially");
+  }
+  if(fNumOfWorkers>1 && !drawFits){
+    // forked workers: every fit has its own fitter, TF1s and minimizer instance
+    ROOT::TProcessExecutor workers(fNumOfWorkers);
+    auto doFit = [&](Int_t jTrial) {
+      const TrialConf& conf=trials[jTrial];
+      return FitTrial(hInvMassHisto,hRebinned[conf.fHisto],conf,totTrials,0x0);
+    };
+    results=workers.Map(doFit,ROOT::TSeqI(nTrials));
+  }
+  else
+#else
+  if(fNumOfWorkers>1) Printf("AliHFMultiTrials: parallel fits need ROOT >= 6.12, running the fits serially");
+#endif
+  {
+    results.reserve(nTrials);
+    for(Int_t jTrial=0; jTrial<nTrials; jTrial++){
+      const TrialConf& conf=trials[jTrial];
+      results.push_back(FitTrial(hInvMassHisto,hRebinned[conf.fHisto],conf,totTrials,drawFits ? thePad : 0x0));
+    }
+  }
+
+  // fill output in the trial order
+  for(Int_t jTrial=0; jTrial<nTrials; jTrial++){
+    const TrialConf& conf=trials[jTrial];
+    const std::vector<Double_t>& res=results[jTrial];
+    itrial=conf.fTrial;
+    Int_t typeb=conf.fBkgFunc;
+    Int_t igs=conf.fSigConf;
+    Double_t minMassForFit=fLowLimFitSteps[conf.fMinMassStep];
+    Double_t maxMassForFit=fUpLimFitSteps[conf.fMaxMassStep];
+    Int_t theCase=igs*kNBkgFuncCases+typeb;
+    Int_t globBin=itrial+theCase*totTrials;
+
+    for(Int_t j=0; j<15; j++) xnt[j]=0.;
+    xnt[0]=fRebinSteps[conf.fRebinStep];
+    xnt[1]=conf.fFirstBin;
+    xnt[2]=minMassForFit;
+    xnt[3]=maxMassForFit;
+    xnt[4]=typeb;
+    xnt[5]=res[kResSigConf];
+    xnt[6]=res[kResMeanConf];
+
+    Bool_t out=(res[kResOut]>0.5);
+    Double_t chisq=res[kResChi2];
+    Double_t sigma=res[kResSigma];
+    Double_t esigma=res[kResESigma];
+    Double_t pos=res[kResMean];
+    Double_t epos=res[kResEMean];
+    Double_t ry=res[kResRawYield];
+    Double_t ery=res[kResERawYield];
+    Double_t significance=res[kResSignif];
+    Double_t erSignif=res[kResESignif];
+    Double_t bkg=res[kResBkg];
+    Double_t erbkg=res[kResEBkg];
+    Double_t bkgBEdge=res[kResBkgBEdge];
+    Double_t erbkgBEdge=res[kResEBkgBEdge];
+
+    xnt[7]=chisq;
+    if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
+      xnt[8]=significance;
+      xnt[9]=pos;
+      xnt[10]=epos;
+      xnt[11]=sigma;
+      xnt[12]=esigma;
+      xnt[13]=ry;
+      xnt[14]=ery;
+      fHistoRawYieldDistAll->Fill(ry);
+      fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
+      fHistoRawYieldTrialAll->SetBinError(globBin,ery);
+      fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
+      fHistoSigmaTrialAll->SetBinError(globBin,esigma);
+      fHistoMeanTrialAll->SetBinContent(globBin,pos);
+      fHistoMeanTrialAll->SetBinError(globBin,epos);
+      fHistoChi2TrialAll->SetBinContent(globBin,chisq);
+      fHistoChi2TrialAll->SetBinError(globBin,0.00001);
+      fHistoSignifTrialAll->SetBinContent(globBin,significance);
+      fHistoSignifTrialAll->SetBinError(globBin,erSignif);
+      if(fSaveBkgVal) {
+        fHistoBkgTrialAll->SetBinContent(globBin,bkg);
+        fHistoBkgTrialAll->SetBinError(globBin,erbkg);
+        fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
+        fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
+      }
+
+      if(ry<fMinYieldGlob) fMinYieldGlob=ry;
+      if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
+      fHistoRawYieldDist[theCase]->Fill(ry);
+      fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
+      fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
+      fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
+      fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
+      fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
+      fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
+      fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
+      fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
+      fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
+      fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
+      if(fSaveBkgVal) {
+        fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
+        fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
+        fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
+        fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
+      }
+
+      for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+        Int_t iRes=kNTrialResults+3*iStepBC;
+        if(res[iRes]>0.5){
+          Double_t cnts=res[iRes+1];
+          Double_t ecnts=res[iRes+2];
+          ++itrialBC;
+          fHistoRawYieldDistBinCAll->Fill(cnts);
+          fHistoRawYieldTrialBinCAll->SetBinContent(globBin,iStepBC+1,cnts);
+          fHistoRawYieldTrialBinCAll->SetBinError(globBin,iStepBC+1,ecnts);
+          fHistoRawYieldTrialBinC[theCase]->SetBinContent(itrial,iStepBC+1,cnts);
+          fHistoRawYieldTrialBinC[theCase]->SetBinError(itrial,iStepBC+1,ecnts);
+          fHistoRawYieldDistBinC[theCase]->Fill(cnts);
+        }
+      }
+    }
+    fNtupleMultiTrials->Fill(xnt);
+  }
+
+  for(auto h : hRebinned) delete h;
   return kTRUE;
 }
 
+//________________________________________________________________________
+std::vector<Double_t> AliHFMultiTrials::FitTrial(TH1D* hInvMassHisto, TH1F* hRebinned, const TrialConf& conf, Int_t totTrials, TPad* thePad){
+  // perform the fit of one trial and return its results (see ETrialResults)
+  // the fitter is kept and drawn on thePad if provided
+
+  std::vector<Double_t> res(kNTrialResults+3*fNumOfnSigmaBinCSteps,0.);
+
+  Int_t types=0;
+  Int_t rebin=fRebinSteps[conf.fRebinStep];
+  Int_t iFirstBin=conf.fFirstBin;
+  Int_t typeb=conf.fBkgFunc;
+  Int_t igs=conf.fSigConf;
+  Double_t minMassForFit=fLowLimFitSteps[conf.fMinMassStep];
+  Double_t maxMassForFit=fUpLimFitSteps[conf.fMaxMassStep];
+  Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
+  Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
+  Int_t theCase=igs*kNBkgFuncCases+typeb;
+  Int_t globBin=conf.fTrial+theCase*totTrials;
+
+  Bool_t mustDeleteFitter = kTRUE;
+  AliHFMassFitterVAR*  fitter=0x0;
+  //if D0 Reflection
+  if(fhTemplRefl){
+    fitter=new AliHFMassFitterVAR(hRebinned,hmin,hmax,1,typeb,2);
+    fitter->SetTemplateReflections(fhTemplRefl);
+    fitter->SetFixReflOverS(fFixRefloS,kTRUE);
+  }
+  else {
+    if(typeb<=kPol2Bkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,typeb,types);
+    }else if(typeb==kPowBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,4,types);
+    }else if(typeb==kPowTimesExpoBkg){
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,5,types);
+    }else{
+      fitter=new AliHFMassFitterVAR(hRebinned,hmin, hmax,1,6,types);
+      if(typeb==kPol3Bkg) fitter->SetBackHighPolDegree(3);
+      if(typeb==kPol4Bkg) fitter->SetBackHighPolDegree(4);
+      if(typeb==kPol5Bkg) fitter->SetBackHighPolDegree(5);
+    }
+    fitter->SetReflectionSigmaFactor(0);
+  }
+  if(fFitOption==0) {
+    fitter->SetUseLikelihoodFit();
+    Printf("Using likelihood fit");
+  }
+  else if(fFitOption==1) {
+    fitter->SetUseChi2Fit();
+    Printf("Using chi2 fit");
+  }
+  else if (fFitOption==2) {
+    fitter->SetUseLikelihoodWithWeightsFit();
+    Printf("Using likelihood fit with weights");
+  }
+  fitter->SetInitialGaussianMean(fMassD);
+  fitter->SetInitialGaussianSigma(fSigmaGausMC);
+  if(igs==kFixSigFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    res[kResSigConf]=1;
+  }else if(igs==kFixSigUpFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariation),kTRUE);
+    res[kResSigConf]=2;
+  }else if(igs==kFixSigDownFreeMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariation),kTRUE);
+    res[kResSigConf]=3;
+  }else if(igs==kFreeSigFreeMean){
+    res[kResSigConf]=0;
+  }else if(igs==kFixSigFixMean){
+    fitter->SetFixGaussianSigma(fSigmaGausMC,kTRUE);
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+    res[kResSigConf]=1;
+    res[kResMeanConf]=1;
+  }else if(igs==kFreeSigFixMean){
+    fitter->SetFixGaussianMean(fMassD,kTRUE);
+    res[kResSigConf]=0;
+    res[kResMeanConf]=1;
+  }
+
+  Double_t sigma=0.;
+  Double_t esigma=0.;
+  Double_t pos=.0;
+  Double_t epos=.0;
+  Double_t significance=0.;
+  Double_t erSignif=0.;
+  Double_t bkg=0.;
+  Double_t erbkg=0.;
+  Double_t bkgBEdge=0;
+  Double_t erbkgBEdge=0;
+  printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs);
+  Bool_t out=fitter->MassFitter(0);
+  Double_t chisq=fitter->GetReducedChiSquare();
+  fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
+  sigma=fitter->GetSigma();
+  pos=fitter->GetMean();
+  esigma=fitter->GetSigmaUncertainty();
+  if(esigma<0.00001) esigma=0.0001;
+  epos=fitter->GetMeanUncertainty();
+  if(epos<0.00001) epos=0.0001;
+  Double_t ry=fitter->GetRawYield();
+  Double_t ery=fitter->GetRawYieldError();
+  TF1* fB1=fitter->GetBackgroundFullRangeFunc();
+  fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
+  Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
+  Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
+  fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
+  if(out && thePad){
+    thePad->Clear();
+    fitter->DrawHere(thePad, fnSigmaForBkgEval);
+    fMassFitters.push_back(fitter);
+    mustDeleteFitter = kFALSE;
+    for (auto format : fInvMassFitSaveAsFormats) {
+      thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
+    }
+  }
+
+  res[kResOut]=out ? 1. : 0.;
+  res[kResChi2]=chisq;
+  res[kResSigma]=sigma;
+  res[kResESigma]=esigma;
+  res[kResMean]=pos;
+  res[kResEMean]=epos;
+  res[kResRawYield]=ry;
+  res[kResERawYield]=ery;
+  res[kResSignif]=significance;
+  res[kResESignif]=erSignif;
+  res[kResBkg]=bkg;
+  res[kResEBkg]=erbkg;
+  res[kResBkgBEdge]=bkgBEdge;
+  res[kResEBkgBEdge]=erbkgBEdge;
+
+  // bin counting, only used for accepted fits
+  if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
+      Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
+      if(minMassBC>minMassForFit &&
+          maxMassBC<maxMassForFit &&
+          minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
+          maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
+        Double_t cnts,ecnts;
+        BinCount(hRebinned,fB1,1,minMassBC,maxMassBC,cnts,ecnts);
+        Int_t iRes=kNTrialResults+3*iStepBC;
+        res[iRes]=1.;
+        res[iRes+1]=cnts;
+        res[iRes+2]=ecnts;
+      }
+    }
+  }
+  if (mustDeleteFitter) delete fitter;
+  return res;
+}
+
 //________________________________________________________________________
 void AliHFMultiTrials::SaveToRoot(TString fileName, TString option) const{
   // save histos in a root file for further analysis
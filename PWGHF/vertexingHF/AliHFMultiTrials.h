@@ -86,6 +86,8 @@ class AliHFMultiTrials : public TNamed {
   void SetSaveBkgValue(Bool_t opt=kTRUE, Double_t nsigma=3) {fSaveBkgVal=opt; fnSigmaForBkgEval=nsigma;}
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
+  /// number of forked processes used to run the trials (1 = serial, needs ROOT >= 6.12)
+  void SetNumberOfWorkers(Int_t nw){fNumOfWorkers=nw;}
 
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
@@ -100,9 +102,25 @@ class AliHFMultiTrials : public TNamed {
 
   enum EBkgFuncCases{ kExpoBkg, kLinBkg, kPol2Bkg, kPol3Bkg, kPol4Bkg, kPol5Bkg, kPowBkg, kPowTimesExpoBkg, kNBkgFuncCases };
   enum EFitParamCases{ kFixSigFreeMean, kFixSigUpFreeMean, kFixSigDownFreeMean, kFreeSigFreeMean, kFixSigFixMean, kFreeSigFixMean, kNFitConfCases};
+  /// content of the result vector of one trial, followed by (ok, counts, error) for each bin counting step
+  enum ETrialResults{ kResOut, kResChi2, kResSigma, kResESigma, kResMean, kResEMean, kResRawYield, kResERawYield, kResSignif, kResESignif, kResBkg, kResEBkg, kResBkgBEdge, kResEBkgBEdge, kResSigConf, kResMeanConf, kNTrialResults };
 
  private:
 
+  /// configuration of one trial
+  struct TrialConf {
+    Int_t fRebinStep;   /// index in fRebinSteps
+    Int_t fFirstBin;    /// first bin used for rebin
+    Int_t fHisto;       /// index of the rebinned histogram
+    Int_t fMinMassStep; /// index in fLowLimFitSteps
+    Int_t fMaxMassStep; /// index in fUpLimFitSteps
+    Int_t fBkgFunc;     /// background function (EBkgFuncCases)
+    Int_t fSigConf;     /// sigma/mean configuration (EFitParamCases)
+    Int_t fTrial;       /// trial number
+  };
+
+  std::vector<Double_t> FitTrial(TH1D* hInvMassHisto, TH1F* hRebinned, const TrialConf& conf, Int_t totTrials, TPad* thePad);
+
   Bool_t CreateHistos();
   TH1F* RebinHisto(TH1D* hOrig, Int_t reb, Int_t firstUse) const;
   void BinCount(TH1F* h, TF1* fB, Int_t rebin, Double_t minMass, Double_t maxMass, Double_t& count, Double_t& ecount) const;
@@ -147,6 +165,7 @@ class AliHFMultiTrials : public TNamed {
   Bool_t fSaveBkgVal;		/// switch for saving bkg values in nsigma
 
   Bool_t fDrawIndividualFits; /// flag for drawing fits
+  Int_t fNumOfWorkers; /// number of parallel processes for the fits
 
   TH1F* fHistoRawYieldDistAll;  /// histo with yield from all trials
   TH1F* fHistoRawYieldTrialAll; /// histo with yield from all trials
@@ -181,7 +200,7 @@ class AliHFMultiTrials : public TNamed {
   std::vector<AliHFMassFitterVAR*> fMassFitters; //!<! Mass fitters
 
   /// \cond CLASSIMP
-  ClassDef(AliHFMultiTrials,5); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFMultiTrials,6); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
@@ -235,27 +235,18 @@ Bool_t AliMultiDimVector::GetCutValuesFromGlobalAddress(ULong64_t globadd, Float
 //______________________________________________________________________
 ULong64_t AliMultiDimVector::GetGlobalAddressFromIndices(const Int_t *ind, Int_t ptbin) const {
   // Returns the global index of the cell in the matrix
-  Int_t prod=1;
+  // (Horner scheme: variables are the slow indices, pt bin the fastest one)
   ULong64_t elem=0;
-  Int_t indexPlusLevel[fgkMaxNVariables+1];
-  Int_t nOfCellsPlusLevel[fgkMaxNVariables+1];
-  for(Int_t i=0;i<fNVariables;i++){
-    indexPlusLevel[i]=ind[i];
-    nOfCellsPlusLevel[i]=fNCutSteps[i];
-  }
-  indexPlusLevel[fNVariables]=ptbin;
-  nOfCellsPlusLevel[fNVariables]=fNPtBins;
-	
-  for(Int_t i=0;i<fNVariables+1;i++){
-    prod=indexPlusLevel[i];
-    if(i<fNVariables){
-      for(Int_t j=i+1;j<fNVariables+1;j++){
-	prod*=nOfCellsPlusLevel[j];
-      }
-    }
-    elem+=prod;
-  }
-  return elem;
+  for(Int_t i=0;i<fNVariables;i++) elem=elem*fNCutSteps[i]+ind[i];
+  return elem*fNPtBins+ptbin;
+}
+//______________________________________________________________________
+ULong64_t AliMultiDimVector::GetAddressStride(Int_t iVar) const {
+  // Returns the distance in global address between two cells
+  // differing by one step in variable iVar
+  ULong64_t stride=fNPtBins;
+  for(Int_t j=fNVariables-1;j>iVar;j--) stride*=fNCutSteps[j];
+  return stride;
 }
 //______________________________________________________________________
 Bool_t AliMultiDimVector::GetIndicesFromValues(const Float_t *values, Int_t *ind) const {
@@ -546,13 +537,21 @@ void AliMultiDimVector::Integrate(){
     AliError("MultiDimVector already integrated");
     return;
   }
-  TArrayF integral(fNTotCells);
-  for(ULong64_t i=0;i<fNTotCells;i++) integral[i]=CountsAboveCell(i);
-  for(ULong64_t i=0;i<fNTotCells;i++) fVett[i]= integral[i];
+  // The sum over all cells above a given one factorizes in one
+  // suffix sum per variable: looping on descending addresses, the
+  // cell one step tighter in iVar has already been integrated along iVar
+  for(Int_t iVar=0;iVar<fNVariables;iVar++){
+    ULong64_t stride=GetAddressStride(iVar);
+    ULong64_t nSteps=fNCutSteps[iVar];
+    for(ULong64_t i=fNTotCells; i-->0;){
+      if((i/stride)%nSteps<nSteps-1) fVett[i]+=fVett[i+stride];
+    }
+  }
   fIsIntegrated=kTRUE;
 }//_____________________________________________________________________________ 
 ULong64_t* AliMultiDimVector::GetGlobalAddressesAboveCuts(const Float_t *values, Int_t ptbin, Int_t& nVals) const{
   // fills an array with global addresses of cells passing the cuts
+  // (in increasing order of global address)
 
   Int_t ind[fgkMaxNVariables];
   Bool_t retcode=GetIndicesFromValues(values,ind);
@@ -560,41 +559,52 @@ ULong64_t* AliMultiDimVector::GetGlobalAddressesAboveCuts(const Float_t *values,
     nVals=0;
     return 0x0;
   }
-  for(Int_t i=fNVariables; i<fgkMaxNVariables; i++) ind[i]=0;
-  Int_t mink[fgkMaxNVariables];
-  Int_t maxk[fgkMaxNVariables];
+  ULong64_t stride[fgkMaxNVariables];
   Int_t size=1;
-  for(Int_t i=0;i<fgkMaxNVariables;i++){
-    GetFillRange(i,ind[i],mink[i],maxk[i]);
-    size*=(maxk[i]-mink[i]+1);
+  for(Int_t i=0;i<fNVariables;i++){
+    stride[i]=GetAddressStride(i);
+    size*=(ind[i]+1);
   }
   ULong64_t* indexes=new ULong64_t[size];
+  // walk the hyper-rectangle of passing cells updating the address
+  // incrementally, the last variable running fastest
+  Int_t k[fgkMaxNVariables];
+  for(Int_t i=0;i<fNVariables;i++) k[i]=0;
+  ULong64_t address=ptbin;
   nVals=0;
-  for(Int_t k0=mink[0]; k0<=maxk[0]; k0++){
-    for(Int_t k1=mink[1]; k1<=maxk[1]; k1++){
-      for(Int_t k2=mink[2]; k2<=maxk[2]; k2++){
-	for(Int_t k3=mink[3]; k3<=maxk[3]; k3++){
-	  for(Int_t k4=mink[4]; k4<=maxk[4]; k4++){
-	    for(Int_t k5=mink[5]; k5<=maxk[5]; k5++){
-	      for(Int_t k6=mink[6]; k6<=maxk[6]; k6++){
-		for(Int_t k7=mink[7]; k7<=maxk[7]; k7++){
-		  for(Int_t k8=mink[8]; k8<=maxk[8]; k8++){
-		    for(Int_t k9=mink[9]; k9<=maxk[9]; k9++){
-		      Int_t currentBin[fgkMaxNVariables]={k0,k1,k2,k3,k4,k5,k6,k7,k8,k9};
-		      indexes[nVals++]=GetGlobalAddressFromIndices(currentBin,ptbin);
-		    }
-		  }
-		}
-	      }
-	    }
-	  }
-	}
-      }
+  while(kTRUE){
+    indexes[nVals++]=address;
+    Int_t iVar=fNVariables-1;
+    while(iVar>=0 && k[iVar]==ind[iVar]){
+      address-=k[iVar]*stride[iVar];
+      k[iVar]=0;
+      iVar--;
     }
+    if(iVar<0) break;
+    k[iVar]++;
+    address+=stride[iVar];
   }
   return indexes;
 }
 //_____________________________________________________________________________ 
+ULong64_t AliMultiDimVector::GetTightestGlobalAddressAboveCuts(const Float_t *values, Int_t ptbin, Int_t& nVals) const{
+  // returns the global address of the tightest cell passed by values
+  // and in nVals the number of cells passing the cuts: all of them have
+  // indices lower or equal than those of the returned cell, so that
+  // filling only this cell and calling Integrate() is equivalent to
+  // filling all the addresses from GetGlobalAddressesAboveCuts
+
+  Int_t ind[fgkMaxNVariables];
+  Bool_t retcode=GetIndicesFromValues(values,ind);
+  if(!retcode){
+    nVals=0;
+    return fNTotCells;
+  }
+  nVals=1;
+  for(Int_t i=0;i<fNVariables;i++) nVals*=(ind[i]+1);
+  return GetGlobalAddressFromIndices(ind,ptbin);
+}
+//_____________________________________________________________________________ 
 Float_t AliMultiDimVector::CountsAboveCell(ULong64_t globadd) const{
   // integrates the counts of cells above cell with address globadd
   Int_t ind[fgkMaxNVariables];
@@ -646,40 +656,29 @@ void AliMultiDimVector::Fill(Float_t* values, Int_t ptbin){
 //_____________________________________________________________________________ 
 void AliMultiDimVector::FillAndIntegrate(Float_t* values, Int_t ptbin){
   // fills the cells of AliMultiDimVector passing the cuts
-  // The number of nested loops must match fgkMaxNVariables!!!!
   fIsIntegrated=kTRUE;
   Int_t ind[fgkMaxNVariables];
   Bool_t retcode=GetIndicesFromValues(values,ind);
   if(!retcode) return;
-  for(Int_t i=fNVariables; i<fgkMaxNVariables; i++) ind[i]=0;
-  Int_t mink[fgkMaxNVariables];
-  Int_t maxk[fgkMaxNVariables];
-  for(Int_t i=0;i<fgkMaxNVariables;i++){
-    GetFillRange(i,ind[i],mink[i],maxk[i]);
-  }
-  for(Int_t k0=mink[0]; k0<=maxk[0]; k0++){
-    for(Int_t k1=mink[1]; k1<=maxk[1]; k1++){
-      for(Int_t k2=mink[2]; k2<=maxk[2]; k2++){
-	for(Int_t k3=mink[3]; k3<=maxk[3]; k3++){
-	  for(Int_t k4=mink[4]; k4<=maxk[4]; k4++){
-	    for(Int_t k5=mink[5]; k5<=maxk[5]; k5++){
-	      for(Int_t k6=mink[6]; k6<=maxk[6]; k6++){
-		for(Int_t k7=mink[7]; k7<=maxk[7]; k7++){
-		  for(Int_t k8=mink[8]; k8<=maxk[8]; k8++){
-		    for(Int_t k9=mink[9]; k9<=maxk[9]; k9++){
-		      Int_t currentBin[fgkMaxNVariables]={k0,k1,k2,k3,k4,k5,k6,k7,k8,k9};
-		      IncrementElement(currentBin,ptbin);
-		    }
-		  }
-		}
-	      }
-	    }
-	  }
-	}
-      }
+  ULong64_t stride[fgkMaxNVariables];
+  Int_t k[fgkMaxNVariables];
+  for(Int_t i=0;i<fNVariables;i++){
+    stride[i]=GetAddressStride(i);
+    k[i]=0;
+  }
+  ULong64_t address=ptbin;
+  while(kTRUE){
+    fVett[address]+=1.;
+    Int_t iVar=fNVariables-1;
+    while(iVar>=0 && k[iVar]==ind[iVar]){
+      address-=k[iVar]*stride[iVar];
+      k[iVar]=0;
+      iVar--;
     }
+    if(iVar<0) break;
+    k[iVar]++;
+    address+=stride[iVar];
   }
-
 }
 //_____________________________________________________________________________ 
 void AliMultiDimVector::SuppressZeroBKGEffect(const AliMultiDimVector* mvBKG){
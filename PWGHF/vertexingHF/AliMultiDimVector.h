@@ -78,6 +78,14 @@ class AliMultiDimVector :  public TNamed{
     else return 0x0;
   }
   ULong64_t* GetGlobalAddressesAboveCuts(const Float_t *values, Int_t ptbin, Int_t& nVals) const;
+  ULong64_t GetTightestGlobalAddressAboveCuts(const Float_t *values, Float_t pt, Int_t& nVals) const{
+    Int_t theBin=GetPtBin(pt);
+    if(theBin>=0) return GetTightestGlobalAddressAboveCuts(values,theBin,nVals);
+    nVals=0;
+    return fNTotCells;
+  }
+  ULong64_t GetTightestGlobalAddressAboveCuts(const Float_t *values, Int_t ptbin, Int_t& nVals) const;
+  ULong64_t GetAddressStride(Int_t iVar) const;
   Bool_t    GetGreaterThan(Int_t iVar) const {return fGreaterThan[iVar];}
 
   void SetElement(ULong64_t globadd,Float_t val) {fVett[globadd]=val;}
@@ -28,6 +28,7 @@
 
 #include <TClonesArray.h>
 #include <TMath.h>
+#include <TVector2.h>
 
 #include <AliLog.h>
 #include <AliVEventHandler.h>
@@ -36,6 +37,8 @@
 #include "AliEmcalJet.h"
 #include "AliRhoParameter.h"
 #include "AliJetContainer.h"
+#include "AliParticleContainer.h"
+#include "AliClusterContainer.h"
 
 ClassImp(AliAnalysisTaskRhoDev);
 
@@ -44,8 +47,29 @@ AliAnalysisTaskRhoDev::AliAnalysisTaskRhoDev() :
   fNExclLeadJets(0),
   fRhoSparse(kFALSE),
   fExclJetOverlap(),
+  fRhoMethod(kKtJetMedian),
+  fGridCellEta(0.1),
+  fGridCellPhi(0.1),
+  fNRandomCones(100),
+  fRandomConeRadius(0.2),
+  fRhoEtaMin(-0.9),
+  fRhoEtaMax(0.9),
+  fRhoPhiMin(0),
+  fRhoPhiMax(TMath::TwoPi()),
+  fValidateRhoMethod(kFALSE),
   fOccupancyFactor(0),
-  fHistOccCorrvsCent(nullptr)
+  fRhoKtValidation(-1),
+  fRandom(0),
+  fRhoValues(),
+  fGridPt(),
+  fExclusionJets(),
+  fExclusionRadius(0),
+  fConstEta(),
+  fConstPhi(),
+  fConstPt(),
+  fHistOccCorrvsCent(nullptr),
+  fHistRhoDiffVsCent(nullptr),
+  fHistRhoVsRhoKt(nullptr)
 {
 }
 
@@ -54,8 +78,29 @@ AliAnalysisTaskRhoDev::AliAnalysisTaskRhoDev(const char *name, Bool_t histo) :
   fNExclLeadJets(0),
   fRhoSparse(kFALSE),
   fExclJetOverlap(),
+  fRhoMethod(kKtJetMedian),
+  fGridCellEta(0.1),
+  fGridCellPhi(0.1),
+  fNRandomCones(100),
+  fRandomConeRadius(0.2),
+  fRhoEtaMin(-0.9),
+  fRhoEtaMax(0.9),
+  fRhoPhiMin(0),
+  fRhoPhiMax(TMath::TwoPi()),
+  fValidateRhoMethod(kFALSE),
   fOccupancyFactor(0),
-  fHistOccCorrvsCent(nullptr)
+  fRhoKtValidation(-1),
+  fRandom(0),
+  fRhoValues(),
+  fGridPt(),
+  fExclusionJets(),
+  fExclusionRadius(0),
+  fConstEta(),
+  fConstPhi(),
+  fConstPt(),
+  fHistOccCorrvsCent(nullptr),
+  fHistRhoDiffVsCent(nullptr),
+  fHistRhoVsRhoKt(nullptr)
 {
 }
 
@@ -67,6 +112,14 @@ void AliAnalysisTaskRhoDev::UserCreateOutputObjects()
 
   fHistOccCorrvsCent = new TH2F("fHistOccCorrvsCent", "fHistOccCorrvsCent;Centrality (%);#it{C}", 100, 0, 100, 2000, 0 , 2);
   fOutput->Add(fHistOccCorrvsCent);
+
+  if (fValidateRhoMethod && fRhoMethod != kKtJetMedian) {
+    fHistRhoDiffVsCent = new TH2F("fHistRhoDiffVsCent", "fHistRhoDiffVsCent;Centrality (%);#rho - #rho_{#it{k}_{T}} (GeV/#it{c} #times rad^{-1})", 100, 0, 100, 400, -50, 50);
+    fOutput->Add(fHistRhoDiffVsCent);
+
+    fHistRhoVsRhoKt = new TH2F("fHistRhoVsRhoKt", "fHistRhoVsRhoKt;#rho_{#it{k}_{T}} (GeV/#it{c} #times rad^{-1});#rho (GeV/#it{c} #times rad^{-1})", 500, 0, 500, 500, 0, 500);
+    fOutput->Add(fHistRhoVsRhoKt);
+  }
 }
 
 std::pair<AliEmcalJet*, AliEmcalJet*> AliAnalysisTaskRhoDev::GetLeadingJets()
@@ -85,19 +138,21 @@ std::pair<AliEmcalJet*, AliEmcalJet*> AliAnalysisTaskRhoDev::GetLeadingJets()
   return maxJets;
 }
 
-void AliAnalysisTaskRhoDev::CalculateRho()
+Double_t AliAnalysisTaskRhoDev::CalculateKtJetMedian(Double_t& occupancy)
 {
-  if (fJetCollArray.empty()) return;
+  occupancy = 0;
+
+  auto bkgJetContIt = fJetCollArray.find("Background");
+  if (bkgJetContIt == fJetCollArray.end()) return -1;
 
   auto maxJets = GetLeadingJets();
 
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
+  fRhoValues.clear();
   Double_t TotaljetArea = 0; // Total area of background jets (including ghost jets)
   Double_t TotaljetAreaPhys = 0; // Total area of physical background jets (excluding ghost jets)
   // Ghost jet is a jet made only of ghost particles
 
-  AliJetContainer* bkgJetCont = fJetCollArray["Background"];
+  AliJetContainer* bkgJetCont = bkgJetContIt->second;
   AliJetContainer* sigJetCont = nullptr;
   if (!fExclJetOverlap.IsNull()) {
     auto sigJetContIt = fJetCollArray.find(fExclJetOverlap.Data());
@@ -128,22 +183,180 @@ void AliAnalysisTaskRhoDev::CalculateRho()
 
     if (overlapsWithSignal) continue;
 
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
-    ++NjetAcc;
+    fRhoValues.push_back(jet->Pt() / jet->Area());
   }
 
   // Occupancy correction for sparse event described in https://arxiv.org/abs/1207.2392
   if (TotaljetArea > 0) {
-    fOccupancyFactor = TotaljetAreaPhys / TotaljetArea;
+    occupancy = TotaljetAreaPhys / TotaljetArea;
+  }
+
+  if (fRhoValues.empty()) return -1;
+
+  //find median value
+  return TMath::Median(fRhoValues.size(), fRhoValues.data());
+}
+
+void AliAnalysisTaskRhoDev::CollectConstituents()
+{
+  fConstEta.clear();
+  fConstPhi.clear();
+  fConstPt.clear();
+
+  Double_t phiRange = fRhoPhiMax - fRhoPhiMin;
+
+  std::vector<AliEmcalContainer*> conts;
+  for (auto partCont : fParticleCollArray) conts.push_back(partCont.second);
+  for (auto clusCont : fClusterCollArray) conts.push_back(clusCont.second);
+
+  for (auto cont : conts) {
+    for (auto mom : cont->accepted_momentum()) {
+      Double_t eta = mom.first.Eta();
+      if (eta < fRhoEtaMin || eta >= fRhoEtaMax) continue;
+      Double_t phi = TVector2::Phi_0_2pi(mom.first.Phi() - fRhoPhiMin);
+      if (phi >= phiRange) continue;
+      fConstEta.push_back(eta);
+      fConstPhi.push_back(phi + fRhoPhiMin);
+      fConstPt.push_back(mom.first.Pt());
+    }
+  }
+}
+
+void AliAnalysisTaskRhoDev::CollectExclusionJets()
+{
+  fExclusionJets.clear();
+  fExclusionRadius = 0;
+
+  if (fExclJetOverlap.IsNull() || fNExclLeadJets == 0) return;
+
+  auto sigJetContIt = fJetCollArray.find(fExclJetOverlap.Data());
+  if (sigJetContIt == fJetCollArray.end()) return;
+
+  fExclusionRadius = sigJetContIt->second->GetJetRadius();
+
+  for (auto jet : fSortedJets[sigJetContIt->first]) {
+    if (fExclusionJets.size() >= fNExclLeadJets) break;
+    fExclusionJets.push_back(std::make_pair(jet->Eta(), jet->Phi()));
+  }
+}
+
+Bool_t AliAnalysisTaskRhoDev::IsExcludedRegion(Double_t eta, Double_t phi, Double_t r) const
+{
+  Double_t maxDist2 = (fExclusionRadius + r) * (fExclusionRadius + r);
+  for (auto jet : fExclusionJets) {
+    Double_t deta = eta - jet.first;
+    Double_t dphi = AliEmcalContainer::RelativePhi(phi, jet.second);
+    if (deta * deta + dphi * dphi < maxDist2) return kTRUE;
+  }
+  return kFALSE;
+}
+
+Double_t AliAnalysisTaskRhoDev::CalculateGridMedian(Double_t& occupancy)
+{
+  occupancy = 0;
+
+  Int_t nEta = TMath::Max(1, TMath::Nint((fRhoEtaMax - fRhoEtaMin) / fGridCellEta));
+  Int_t nPhi = TMath::Max(1, TMath::Nint((fRhoPhiMax - fRhoPhiMin) / fGridCellPhi));
+  Double_t cellEta = (fRhoEtaMax - fRhoEtaMin) / nEta;
+  Double_t cellPhi = (fRhoPhiMax - fRhoPhiMin) / nPhi;
+  Double_t cellArea = cellEta * cellPhi;
+
+  fGridPt.assign(nEta * nPhi, 0.);
+  for (UInt_t i = 0; i < fConstPt.size(); i++) {
+    Int_t iEta = TMath::Min(nEta - 1, Int_t((fConstEta[i] - fRhoEtaMin) / cellEta));
+    Int_t iPhi = TMath::Min(nPhi - 1, Int_t((fConstPhi[i] - fRhoPhiMin) / cellPhi));
+    fGridPt[iEta * nPhi + iPhi] += fConstPt[i];
+  }
+
+  fRhoValues.clear();
+  Int_t nFilled = 0;
+  for (Int_t iEta = 0; iEta < nEta; iEta++) {
+    for (Int_t iPhi = 0; iPhi < nPhi; iPhi++) {
+      if (IsExcludedRegion(fRhoEtaMin + (iEta + 0.5) * cellEta, fRhoPhiMin + (iPhi + 0.5) * cellPhi, 0)) continue;
+      Double_t pt = fGridPt[iEta * nPhi + iPhi];
+      if (pt > 0) nFilled++;
+      fRhoValues.push_back(pt / cellArea);
+    }
+  }
+
+  if (fRhoValues.empty()) return -1;
+
+  occupancy = Double_t(nFilled) / fRhoValues.size();
+
+  return TMath::Median(fRhoValues.size(), fRhoValues.data());
+}
+
+Double_t AliAnalysisTaskRhoDev::CalculateRandomConeMedian(Double_t& occupancy)
+{
+  occupancy = 0;
+
+  Double_t r2 = fRandomConeRadius * fRandomConeRadius;
+  Double_t coneArea = TMath::Pi() * r2;
+  Double_t etaMin = fRhoEtaMin + fRandomConeRadius;
+  Double_t etaMax = fRhoEtaMax - fRandomConeRadius;
+  if (etaMax <= etaMin) return -1;
+
+  // Cones are not allowed to extend outside a partial azimuthal acceptance
+  Bool_t fullPhi = (fRhoPhiMax - fRhoPhiMin) >= TMath::TwoPi() - 1e-6;
+  Double_t phiMin = fullPhi ? fRhoPhiMin : fRhoPhiMin + fRandomConeRadius;
+  Double_t phiMax = fullPhi ? fRhoPhiMax : fRhoPhiMax - fRandomConeRadius;
+  if (phiMax <= phiMin) return -1;
+
+  fRhoValues.clear();
+  Int_t nFilled = 0;
+  for (Int_t iCone = 0; iCone < fNRandomCones; iCone++) {
+    Double_t coneEta = fRandom.Uniform(etaMin, etaMax);
+    Double_t conePhi = fRandom.Uniform(phiMin, phiMax);
+    if (IsExcludedRegion(coneEta, conePhi, fRandomConeRadius)) continue;
+
+    Double_t pt = 0;
+    for (UInt_t i = 0; i < fConstPt.size(); i++) {
+      Double_t deta = fConstEta[i] - coneEta;
+      if (TMath::Abs(deta) > fRandomConeRadius) continue;
+      Double_t dphi = AliEmcalContainer::RelativePhi(fConstPhi[i], conePhi);
+      if (deta * deta + dphi * dphi < r2) pt += fConstPt[i];
+    }
+    if (pt > 0) nFilled++;
+    fRhoValues.push_back(pt / coneArea);
+  }
+
+  if (fRhoValues.empty()) return -1;
+
+  occupancy = Double_t(nFilled) / fRhoValues.size();
+
+  return TMath::Median(fRhoValues.size(), fRhoValues.data());
+}
+
+void AliAnalysisTaskRhoDev::CalculateRho()
+{
+  fRhoKtValidation = -1;
+
+  Double_t occupancy = 0;
+  Double_t rho = -1;
+
+  if (fRhoMethod == kKtJetMedian) {
+    rho = CalculateKtJetMedian(occupancy);
   }
   else {
-    fOccupancyFactor = 0;
+    CollectConstituents();
+    CollectExclusionJets();
+    if (fRhoMethod == kGridMedian) {
+      rho = CalculateGridMedian(occupancy);
+    }
+    else {
+      rho = CalculateRandomConeMedian(occupancy);
+    }
+
+    if (fValidateRhoMethod) {
+      Double_t occupancyKt = 0;
+      fRhoKtValidation = CalculateKtJetMedian(occupancyKt);
+      if (fRhoKtValidation >= 0 && fRhoSparse) fRhoKtValidation *= occupancyKt;
+    }
   }
 
-  if (NjetAcc > 0) {
-    //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+  fOccupancyFactor = occupancy;
 
+  if (rho >= 0) {
     if (fRhoSparse) rho = rho * fOccupancyFactor;
 
     fOutRho->SetVal(rho);
@@ -157,20 +370,30 @@ Bool_t AliAnalysisTaskRhoDev::FillHistograms()
 
   fHistOccCorrvsCent->Fill(fCent, fOccupancyFactor);
 
+  if (fHistRhoDiffVsCent && fRhoKtValidation >= 0) {
+    fHistRhoDiffVsCent->Fill(fCent, fOutRho->GetVal() - fRhoKtValidation);
+    fHistRhoVsRhoKt->Fill(fRhoKtValidation, fOutRho->GetVal());
+  }
+
   return kTRUE;
 }
 
 Bool_t AliAnalysisTaskRhoDev::VerifyContainers()
 {
-  if (fJetCollArray.count("Background") == 0) {
-    AliError("No signal jet collection found. Task will not run!");
+  if ((fRhoMethod == kKtJetMedian || fValidateRhoMethod) && fJetCollArray.count("Background") == 0) {
+    AliError("No background jet collection found. Task will not run!");
+    return kFALSE;
+  }
+
+  if (fRhoMethod != kKtJetMedian && fParticleCollArray.empty() && fClusterCollArray.empty()) {
+    AliError("No particle or cluster collection found. Task will not run!");
     return kFALSE;
   }
 
   return kTRUE;
 }
 
-AliAnalysisTaskRhoDev* AliAnalysisTaskRhoDev::AddTaskRhoDev(TString trackName, Double_t trackPtCut, TString clusName, Double_t clusECut, TString nRho, Double_t jetradius, UInt_t acceptance, AliJetContainer::EJetType_t jetType, AliJetContainer::ERecoScheme_t rscheme, Bool_t histo, TString suffix)
+AliAnalysisTaskRhoDev* AliAnalysisTaskRhoDev::AddTaskRhoDev(TString trackName, Double_t trackPtCut, TString clusName, Double_t clusECut, TString nRho, Double_t jetradius, UInt_t acceptance, AliJetContainer::EJetType_t jetType, AliJetContainer::ERecoScheme_t rscheme, Bool_t histo, TString suffix, ERhoMethod_t rhoMethod, Bool_t validate)
 {
   // Get the pointer to the existing analysis manager via the static access method.
   AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
@@ -245,12 +468,21 @@ AliAnalysisTaskRhoDev* AliAnalysisTaskRhoDev::AddTaskRhoDev(TString trackName, D
     clusterCont->SetDefaultClusterEnergy(AliVCluster::kHadCorr);
   }
 
-  AliJetContainer *jetCont = new AliJetContainer(jetType, AliJetContainer::kt_algorithm, rscheme, jetradius, partCont, clusterCont);
-  if (jetCont) {
-    jetCont->SetJetPtCut(0);
-    jetCont->SetJetAcceptanceType(acceptance);
-    jetCont->SetName("Background");
-    rhotask->AdoptJetContainer(jetCont);
+  rhotask->SetRhoMethod(rhoMethod);
+  rhotask->SetValidateRhoMethod(validate);
+
+  // The background kt jets are only needed for the kt median (also when validating other methods against it)
+  if (rhoMethod == kKtJetMedian || validate) {
+    AliJetContainer *jetCont = new AliJetContainer(jetType, AliJetContainer::kt_algorithm, rscheme, jetradius, partCont, clusterCont);
+    if (jetCont) {
+      jetCont->SetJetPtCut(0);
+      jetCont->SetJetAcceptanceType(acceptance);
+      jetCont->SetName("Background");
+      rhotask->AdoptJetContainer(jetCont);
+    }
+  }
+  if (rhoMethod == kRandomCone) {
+    rhotask->SetRandomCones(100, jetradius);
   }
 
   // Final settings, pass to manager and set the containers
@@ -28,6 +28,9 @@
 #define ALIANALYSISTASKRHODEV_H
 
 #include <utility>
+#include <vector>
+
+#include <TRandom3.h>
 
 #include "AliAnalysisTaskRhoBaseDev.h"
 
@@ -45,12 +48,30 @@
  * of the pt density of kt clusters. More details at: https://arxiv.org/pdf/0707.1378.pdf.
  * If scale function is given the scaled rho will be exported
  * with the name as "fOutRhoName".Apppend("_Scaled").
+ *
+ * Alternatively (see SetRhoMethod()), rho can be calculated without
+ * a dedicated kt jet finder, as the median of the pt density of
+ * (eta, phi) grid cells or of random cones filled directly from the
+ * particle and cluster containers. In this case the regions around the
+ * leading jets of the signal jet collection (see SetExclJetOverlap())
+ * can be excluded. In validation mode the kt median is calculated as well
+ * and the difference is histogrammed.
  * This is a development version. The stable version of this class
  * is AliAnalysisTaskRho.
  */
 class AliAnalysisTaskRhoDev : public AliAnalysisTaskRhoBaseDev {
 
 public:
+  /**
+   * @enum ERhoMethod_t
+   * @brief Method used to calculate the background density
+   */
+  enum ERhoMethod_t {
+    kKtJetMedian = 0,   ///< Median of pt/area of the kt jets of the "Background" jet collection
+    kGridMedian  = 1,   ///< Median of the pt density of (eta, phi) grid cells
+    kRandomCone  = 2    ///< Median of the pt density of random cones
+  };
+
   /**
    * @brief Default constructor. Needed by ROOT I/O
    */
@@ -79,6 +100,23 @@ public:
   void             SetRhoSparse(Bool_t b)          { fRhoSparse     = b    ; }
   void             SetExclJetOverlap(TString n)    { fExclJetOverlap= n    ; }
 
+  /**
+   * @brief Set the method used to calculate rho. The grid median and random cone
+   * methods do not require the "Background" kt jet collection, unless validation is enabled.
+   * @param m Rho method
+   */
+  void             SetRhoMethod(ERhoMethod_t m)    { fRhoMethod     = m    ; }
+  void             SetGridCellSize(Double_t deta, Double_t dphi) { fGridCellEta = deta; fGridCellPhi = dphi; }
+  void             SetRandomCones(Int_t n, Double_t r)           { fNRandomCones = n; fRandomConeRadius = r; }
+  void             SetRhoEtaRange(Double_t min, Double_t max)    { fRhoEtaMin = min; fRhoEtaMax = max; }
+  void             SetRhoPhiRange(Double_t min, Double_t max)    { fRhoPhiMin = min; fRhoPhiMax = max; }
+  /**
+   * @brief Calculate also the kt median (requires the "Background" jet collection)
+   * and histogram the difference with respect to the configured method.
+   * @param b If kTRUE, enable validation
+   */
+  void             SetValidateRhoMethod(Bool_t b)  { fValidateRhoMethod = b; }
+
   /**
    * @brief Create an instance of this class and add it to the analysis manager
    * @param trackName name of the track collection
@@ -92,6 +130,8 @@ public:
    * @param rscheme Recombination scheme
    * @param histo If kTRUE the task will also produce QA histograms
    * @param suffix additional suffix that can be added at the end of the task name
+   * @param rhoMethod Method used to calculate rho
+   * @param validate If kTRUE, calculate also the kt median and histogram the difference (the kt jets are then always created)
    * @return pointer to the new AliAnalysisTaskRhoDev task
    */
   static AliAnalysisTaskRhoDev* AddTaskRhoDev(
@@ -105,7 +145,9 @@ public:
      AliJetContainer::EJetType_t jetType           = AliJetContainer::kChargedJet,
      AliJetContainer::ERecoScheme_t rscheme        = AliJetContainer::pt_scheme,
      Bool_t         histo                          = kTRUE,
-     TString        suffix                         = ""
+     TString        suffix                         = "",
+     ERhoMethod_t   rhoMethod                      = kKtJetMedian,
+     Bool_t         validate                       = kFALSE
   );
 
  protected:
@@ -116,6 +158,49 @@ public:
    */
   void          CalculateRho();
 
+  /**
+   * Median of pt/area of the kt jets of the "Background" jet collection.
+   * @param[out] occupancy Occupancy correction factor
+   * @return Rho value (-1 if no jet was accepted)
+   */
+  Double_t      CalculateKtJetMedian(Double_t& occupancy);
+
+  /**
+   * Median of the pt density of the cells of an (eta, phi) grid,
+   * filled directly from the particle and cluster containers.
+   * @param[out] occupancy Fraction of non-empty cells
+   * @return Rho value (-1 if no cell was accepted)
+   */
+  Double_t      CalculateGridMedian(Double_t& occupancy);
+
+  /**
+   * Median of the pt density of random cones,
+   * filled directly from the particle and cluster containers.
+   * @param[out] occupancy Fraction of non-empty cones
+   * @return Rho value (-1 if no cone was accepted)
+   */
+  Double_t      CalculateRandomConeMedian(Double_t& occupancy);
+
+  /**
+   * Fills fConstEta, fConstPhi, fConstPt with the accepted particles and clusters
+   * inside the rho acceptance.
+   */
+  void          CollectConstituents();
+
+  /**
+   * Fills fExclusionJets with the leading jets of the signal jet collection.
+   */
+  void          CollectExclusionJets();
+
+  /**
+   * @brief Whether a position is close to any of the excluded signal jets.
+   * @param eta Pseudorapidity of the position
+   * @param phi Azimuthal angle of the position
+   * @param r Additional distance (e.g. the cone radius)
+   * @return kTRUE if the position is excluded
+   */
+  Bool_t        IsExcludedRegion(Double_t eta, Double_t phi, Double_t r) const;
+
   /**
    * Fill histograms.
    */
@@ -137,13 +222,34 @@ public:
   UInt_t           fNExclLeadJets;                 ///< number of leading jets to be excluded from the median calculation
   Bool_t           fRhoSparse;                     ///< flag to run CMS method as described in https://arxiv.org/abs/1207.2392
   TString          fExclJetOverlap;                ///< name of the jet collection that should be used to reject jets that are considered "signal"
+  ERhoMethod_t     fRhoMethod;                     ///< method used to calculate rho
+  Double_t         fGridCellEta;                   ///< grid cell size in eta (grid median)
+  Double_t         fGridCellPhi;                   ///< grid cell size in phi (grid median)
+  Int_t            fNRandomCones;                  ///< number of random cones per event (random cone median)
+  Double_t         fRandomConeRadius;              ///< radius of the random cones (random cone median)
+  Double_t         fRhoEtaMin;                     ///< minimum eta of the particles and clusters used by the grid / random cone methods
+  Double_t         fRhoEtaMax;                     ///< maximum eta of the particles and clusters used by the grid / random cone methods
+  Double_t         fRhoPhiMin;                     ///< minimum phi of the particles and clusters used by the grid / random cone methods
+  Double_t         fRhoPhiMax;                     ///< maximum phi of the particles and clusters used by the grid / random cone methods
+  Bool_t           fValidateRhoMethod;             ///< if kTRUE, calculate also the kt median and histogram the difference
 
   Double_t         fOccupancyFactor;               //!<!occupancy correction factor for sparse events
+  Double_t         fRhoKtValidation;               //!<!kt median rho in validation mode
+  TRandom3         fRandom;                        //!<!random number generator for the random cones
+  std::vector<Double_t> fRhoValues;                //!<!pt densities entering the median
+  std::vector<Double_t> fGridPt;                   //!<!pt sum per grid cell
+  std::vector<std::pair<Double_t, Double_t> > fExclusionJets; //!<!(eta, phi) of the excluded signal jets
+  Double_t         fExclusionRadius;               //!<!radius of the excluded signal jets
+  std::vector<Double_t> fConstEta;                 //!<!eta of the accepted particles and clusters of the event
+  std::vector<Double_t> fConstPhi;                 //!<!phi of the accepted particles and clusters of the event
+  std::vector<Double_t> fConstPt;                  //!<!pt of the accepted particles and clusters of the event
   TH2F            *fHistOccCorrvsCent;             //!<!occupancy correction vs. centrality
+  TH2F            *fHistRhoDiffVsCent;             //!<!rho (configured method) - rho (kt median) vs. centrality
+  TH2F            *fHistRhoVsRhoKt;                //!<!rho (configured method) vs. rho (kt median)
 
   AliAnalysisTaskRhoDev(const AliAnalysisTaskRhoDev&);             // not implemented
   AliAnalysisTaskRhoDev& operator=(const AliAnalysisTaskRhoDev&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoDev, 2);
+  ClassDef(AliAnalysisTaskRhoDev, 3);
 };
 #endif
@@ -19,9 +19,12 @@
 
 #include "AliJetResponseMaker.h"
 
+#include <algorithm>
+
 #include <TClonesArray.h>
 #include <TH2F.h>
 #include <THnSparse.h>
+#include <TKDTree.h>
 
 #include "AliTLorentzVector.h"
 #include "AliAnalysisManager.h"
@@ -46,6 +49,7 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fMaxCandidateDistance(-1),
   fEmbeddingQA(),
   fHistoType(0),
   fDeltaPtAxis(0),
@@ -61,6 +65,9 @@ AliJetResponseMaker::AliJetResponseMaker() :
   fJetRelativeEPAngle(0),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
+  fMCLabelCache(),
+  fSortedTrackCache(),
+  fSortedClusterCache(),
   fHistRejectionReason1(0),
   fHistRejectionReason2(0),
   fHistJets1(0),
@@ -135,6 +142,7 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fMatchingPar2(0),
   fUseCellsToMatch(kFALSE),
   fMinJetMCPt(1),
+  fMaxCandidateDistance(-1),
   fEmbeddingQA(),
   fHistoType(0),
   fDeltaPtAxis(0),
@@ -150,6 +158,9 @@ AliJetResponseMaker::AliJetResponseMaker(const char *name) :
   fJetRelativeEPAngle(0),
   fIsJet1Rho(kFALSE),
   fIsJet2Rho(kFALSE),
+  fMCLabelCache(),
+  fSortedTrackCache(),
+  fSortedClusterCache(),
   fHistRejectionReason1(0),
   fHistRejectionReason2(0),
   fHistJets1(0),
@@ -1367,6 +1378,8 @@ void AliJetResponseMaker::ExecOnce()
 Bool_t AliJetResponseMaker::Run()
 {
   // Find the closest jets
+  ResetConstituentCache();
+
   if (fMatching == kNoMatching) 
     return kTRUE;
   else
@@ -1426,8 +1439,31 @@ void AliJetResponseMaker::DoJetLoop()
   AliEmcalJet* jet1 = 0;
   AliEmcalJet* jet2 = 0;
 
+  std::vector<AliEmcalJet*> candidates2;
+  std::vector<Double_t> eta2, phi2;
+
   jets2->ResetCurrentID();
-  while ((jet2 = jets2->GetNextJet())) jet2->ResetMatching();
+  while ((jet2 = jets2->GetNextJet())) {
+    jet2->ResetMatching();
+    if (fMaxCandidateDistance > 0) {
+      candidates2.push_back(jet2);
+      eta2.push_back(jet2->Eta());
+      phi2.push_back(jet2->Phi());
+    }
+  }
+
+  // if requested, restrict the jet pairs to those close in (eta,phi) using a kd-tree
+  // (same approach as AliEmcalJetTaggerTaskFast::MatchJetsGeo)
+  TKDTreeID *tree2 = 0;
+  if (!candidates2.empty()) {
+    tree2 = new TKDTreeID(static_cast<Int_t>(candidates2.size()), 2, 1);
+    tree2->SetData(0, eta2.data());
+    tree2->SetData(1, phi2.data());
+    tree2->Build();
+  }
+
+  std::vector<Int_t> found;
+  std::vector<Int_t> inRange;
 
   jets1->ResetCurrentID();
   while ((jet1 = jets1->GetNextJet())) {
@@ -1435,11 +1471,33 @@ void AliJetResponseMaker::DoJetLoop()
 
     if (jet1->MCPt() < fMinJetMCPt) continue;
 
+    if (tree2) {
+      found.clear();
+      const Double_t phiShift[3] = {0, TMath::TwoPi(), -TMath::TwoPi()};
+      for (Int_t iShift = 0; iShift < 3; iShift++) {
+        Double_t point[2] = {jet1->Eta(), jet1->Phi() + phiShift[iShift]};
+        // the shifted searches are only needed close to the phi boundaries
+        if (iShift > 0 && (point[1] < -fMaxCandidateDistance || point[1] > TMath::TwoPi() + fMaxCandidateDistance)) continue;
+        inRange.clear();
+        tree2->FindInRange(point, fMaxCandidateDistance, inRange);
+        found.insert(found.end(), inRange.begin(), inRange.end());
+      }
+      // keep the jet2 ordering of the full loop, so that ties are resolved in the same way
+      std::sort(found.begin(), found.end());
+      found.erase(std::unique(found.begin(), found.end()), found.end());
+      for (std::vector<Int_t>::const_iterator it = found.begin(); it != found.end(); ++it) {
+        SetMatchingLevel(jet1, candidates2[*it], fMatching);
+      }
+      continue;
+    }
+
     jets2->ResetCurrentID();
     while ((jet2 = jets2->GetNextJet())) {
       SetMatchingLevel(jet1, jet2, fMatching);
     } // jet2 loop
   } // jet1 loop
+
+  delete tree2;
 }
 
 //________________________________________________________________________
@@ -1463,194 +1521,32 @@ void AliJetResponseMaker::GetMCLabelMatchingLevel(AliEmcalJet *jet1, AliEmcalJet
   AliParticleContainer *tracks2   = jets2->GetParticleContainer();
 
   // d1 and d2 represent the matching level: 0 = maximum level of matching, 1 = the two jets are completely unrelated
-  d1 = jet1->Pt();
+  // The constituents of jet1 are associated with the jet2 particle container once per event and sorted by index,
+  // so that each particle of jet2 is looked up with a binary search
+  const MCLabelJetInfo& info = GetMCLabelJetInfo(jet1, tracks1, tracks2);
+
+  // remove completely tracks/clusters that are not MC particles (label == 0)
+  d1 = jet1->Pt() - info.fNonMCPt;
   d2 = jet2->Pt();
   Double_t totalPt1 = d1; // the total pt of the reconstructed jet will be cleaned from the background
 
-  // remove completely tracks that are not MC particles (label == 0)
-  if (tracks1 && tracks1->GetArray()) {
-    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
-      AliVParticle *track = jet1->Track(iTrack);
-      if (!track) {
-        AliWarning(Form("Could not find track %d!", iTrack));
-        continue;
-      }
-
-      Int_t MClabel = TMath::Abs(track->GetLabel());
-      MClabel -= fMCLabelShift;
-      if (MClabel != 0) continue;
-
-      // this is not a MC particle; remove it completely
-      AliDebug(3,Form("Track %d (pT = %f) is not a MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
-      totalPt1 -= track->Pt();
-      d1 -= track->Pt();
-    }
-  }
-
-  // remove completely clusters that are not MC particles (label == 0)
-  if (fUseCellsToMatch && fCaloCells) { 
-    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-      AliVCluster *clus = jet1->Cluster(iClus);
-      if (!clus) {
-        AliWarning(Form("Could not find cluster %d!", iClus));
-        continue;
-      }
-      AliTLorentzVector part;
-      clus->GetMomentum(part, fVertex);
-
-      for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
-        Int_t cellId = clus->GetCellAbsId(iCell);
-        Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
-
-        Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
-        MClabel -= fMCLabelShift;
-        if (MClabel != 0) continue;
-
-        // this is not a MC particle; remove it completely
-        AliDebug(3,Form("Cell %d (frac = %f) is not a MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
-        totalPt1 -= part.Pt() * cellFrac;
-        d1 -= part.Pt() * cellFrac;
-      }
-    }
-  }
-  else {
-    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-      AliVCluster *clus = jet1->Cluster(iClus);
-      if (!clus) {
-        AliWarning(Form("Could not find cluster %d!", iClus));
-        continue;
-      }
-      TLorentzVector part;
-      clus->GetMomentum(part, fVertex);
-
-      Int_t MClabel = TMath::Abs(clus->GetLabel());
-      MClabel -= fMCLabelShift;
-      if (MClabel != 0) continue;
-
-      // this is not a MC particle; remove it completely
-      AliDebug(3,Form("Cluster %d (pT = %f) is not a MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
-      totalPt1 -= part.Pt();
-      d1 -= part.Pt();
-    }
-  }
-
   for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
-    Bool_t track2Found = kFALSE;
-    Int_t index2 = jet2->TrackAt(iTrack2);
-
-    // now look for common particles in the track array
-    for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
-      AliVParticle *track = jet1->Track(iTrack);
-      if (!track) {
-        AliWarning(Form("Could not find track %d!", iTrack));
-        continue;
-      }
-      Int_t MClabel = TMath::Abs(track->GetLabel());
-      MClabel -= fMCLabelShift;	  
-      if (MClabel <= 0) continue;
-
-      Int_t index = -1;
-      index = tracks2->GetIndexFromLabel(MClabel);
-      if (index < 0) {
-        AliDebug(2,Form("Track %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
-        continue;
-      }
-
-      if (index2 != index) continue;
-
-      // found common particle
-      d1 -= track->Pt();
-
-      if (!track2Found) {
-        AliVParticle *MCpart = jet2->Track(iTrack2);
-        AliDebug(3,Form("Track %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-            iTrack,track->Pt(),track->Eta(),track->Phi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-        d2 -= MCpart->Pt();
-      }
-
-      track2Found = kTRUE;
-    }
-
-    // now look for common particles in the cluster array
-    if (fUseCellsToMatch && fCaloCells) { // if the cell colection is available, look for cells with a matched MC particle
-      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-        AliVCluster *clus = jet1->Cluster(iClus);
-        if (!clus) {
-          AliWarning(Form("Could not find cluster %d!", iClus));
-          continue;
-        }
-        AliTLorentzVector part;
-        clus->GetMomentum(part, fVertex);
-
-        for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
-          Int_t cellId = clus->GetCellAbsId(iCell);
-          Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
-
-          Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
-          MClabel -= fMCLabelShift;
-          if (MClabel <= 0) continue;
-
-          Int_t index1 = -1;
-          index1 = tracks2->GetIndexFromLabel(MClabel);
-          if (index1 < 0) {
-            AliDebug(3,Form("Cell %d (frac = %f) does not have an associated MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
-            continue;
-          }
-
-          if (index2 != index1) continue;
-
-          // found common particle
-          d1 -= part.Pt() * cellFrac;
-
-          if (!track2Found) { // only if it is not already found among charged tracks (charged particles are most likely already found)
-            AliVParticle *MCpart = jet2->Track(iTrack2);
-            AliDebug(3,Form("Cell %d belonging to cluster %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-                iCell,iClus,part.Pt(),part.Eta(),part.Phi_0_2pi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-            d2 -= MCpart->Pt() * cellFrac;
-          }
-
-          track2Found = kTRUE;
-        }
-      }
-    }
-    else { //otherwise look for the first contributor to the cluster, and if matched to a MC label remove it
-      for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
-        AliVCluster *clus = jet1->Cluster(iClus);
-        if (!clus) {
-          AliWarning(Form("Could not find cluster %d!", iClus));
-          continue;
-        }
-        AliTLorentzVector part;
-        clus->GetMomentum(part, fVertex);
-
-        Int_t MClabel = TMath::Abs(clus->GetLabel());
-        MClabel -= fMCLabelShift;
-        if (MClabel <= 0) continue;
-
-        Int_t index = -1;
-        index = tracks2->GetIndexFromLabel(MClabel);
-
-        if (index < 0) {
-          AliDebug(3,Form("Cluster %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
-          continue;
-        }
-
-        if (index2 != index) continue;
-
-        // found common particle
-        d1 -= part.Pt();
-
-        if (!track2Found) { // only if it is not already found among charged tracks (charged particles are most likely already found)
-          AliVParticle *MCpart = jet2->Track(iTrack2);
-          AliDebug(3,Form("Cluster %d (pT = %f, eta = %f, phi = %f) is associated with the MC particle %d (pT = %f, eta = %f, phi = %f)!",
-              iClus,part.Pt(),part.Eta(),part.Phi_0_2pi(),MClabel,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
-
-          d2 -= MCpart->Pt();
-        }
-
-        track2Found = kTRUE;
-      }
+    MCLabelConstituent key = {jet2->TrackAt(iTrack2), -1, 0, 0};
+    std::vector<MCLabelConstituent>::const_iterator first = std::lower_bound(info.fConstituents.begin(), info.fConstituents.end(), key);
+    if (first == info.fConstituents.end() || first->fIndex != key.fIndex) continue;
+
+    // found common particle(s)
+    std::vector<MCLabelConstituent>::const_iterator it = first;
+    for (; it != info.fConstituents.end() && it->fIndex == key.fIndex; ++it) d1 -= it->fPt;
+
+    // the particle is removed from jet2 only once, with the fraction of the first constituent found (tracks before clusters)
+    AliVParticle *MCpart = jet2->Track(iTrack2);
+    if (!MCpart) {
+      AliWarning(Form("Could not find track %d!", key.fIndex));
+      continue;
     }
+    AliDebug(3,Form("MC particle %d (pT = %f, eta = %f, phi = %f) is shared by the two jets",key.fIndex,MCpart->Pt(),MCpart->Eta(),MCpart->Phi()));
+    d2 -= MCpart->Pt() * first->fFraction;
   }
 
   if (d1 < 0)
@@ -1690,26 +1586,28 @@ void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, Ali
 
   if (tracks1 && tracks2) {
 
-    for (Int_t iTrack2 = 0; iTrack2 < jet2->GetNumberOfTracks(); iTrack2++) {
-      Int_t index2 = jet2->TrackAt(iTrack2);
-      for (Int_t iTrack1 = 0; iTrack1 < jet1->GetNumberOfTracks(); iTrack1++) {
-        Int_t index1 = jet1->TrackAt(iTrack1);
-        if (index2 == index1) { // found common particle
-          AliVParticle *part1 = jet1->Track(iTrack1);
-          if (!part1) {
-            AliWarning(Form("Could not find track %d!", index1));
-            continue;
-          }
-          AliVParticle *part2 = jet2->Track(iTrack2);
-          if (!part2) {
-            AliWarning(Form("Could not find track %d!", index2));
-            continue;
-          }
-
-          d1 -= part1->Pt();
-          d2 -= part2->Pt();
-          break;
+    // merge the sorted track indices of the two jets
+    const SortedIndices_t& sorted1 = GetSortedTrackIndices(jet1);
+    const SortedIndices_t& sorted2 = GetSortedTrackIndices(jet2);
+    SortedIndices_t::const_iterator it1 = sorted1.begin();
+    for (SortedIndices_t::const_iterator it2 = sorted2.begin(); it2 != sorted2.end(); ++it2) {
+      Int_t index2 = it2->first;
+      while (it1 != sorted1.end() && it1->first < index2) ++it1;
+      for (SortedIndices_t::const_iterator it = it1; it != sorted1.end() && it->first == index2; ++it) { // found common particle
+        AliVParticle *part1 = jet1->Track(it->second);
+        if (!part1) {
+          AliWarning(Form("Could not find track %d!", it->first));
+          continue;
+        }
+        AliVParticle *part2 = jet2->Track(it2->second);
+        if (!part2) {
+          AliWarning(Form("Could not find track %d!", index2));
+          continue;
         }
+
+        d1 -= part1->Pt();
+        d2 -= part2->Pt();
+        break;
       }
     }
 
@@ -1820,29 +1718,31 @@ void AliJetResponseMaker::GetSameCollectionsMatchingLevel(AliEmcalJet *jet1, Ali
       }
     }
     else {
-      for (Int_t iClus2 = 0; iClus2 < jet2->GetNumberOfClusters(); iClus2++) {
-        Int_t index2 = jet2->ClusterAt(iClus2);
-        for (Int_t iClus1 = 0; iClus1 < jet1->GetNumberOfClusters(); iClus1++) {
-          Int_t index1 = jet1->ClusterAt(iClus1);
-          if (index2 == index1) { // found common particle
-            AliVCluster *clus1 = jet1->Cluster(iClus1);
-            if (!clus1) {
-              AliWarning(Form("Could not find cluster %d!", index1));
-              continue;
-            }
-            AliVCluster *clus2 =  jet2->Cluster(iClus2);
-            if (!clus2) {
-              AliWarning(Form("Could not find cluster %d!", index2));
-              continue;
-            }
-            TLorentzVector part1, part2;
-            clus1->GetMomentum(part1, fVertex);
-            clus2->GetMomentum(part2, fVertex);
-
-            d1 -= part1.Pt();
-            d2 -= part2.Pt();
-            break;
+      // merge the sorted cluster indices of the two jets
+      const SortedIndices_t& sorted1 = GetSortedClusterIndices(jet1);
+      const SortedIndices_t& sorted2 = GetSortedClusterIndices(jet2);
+      SortedIndices_t::const_iterator it1 = sorted1.begin();
+      for (SortedIndices_t::const_iterator it2 = sorted2.begin(); it2 != sorted2.end(); ++it2) {
+        Int_t index2 = it2->first;
+        while (it1 != sorted1.end() && it1->first < index2) ++it1;
+        for (SortedIndices_t::const_iterator it = it1; it != sorted1.end() && it->first == index2; ++it) { // found common particle
+          AliVCluster *clus1 = jet1->Cluster(it->second);
+          if (!clus1) {
+            AliWarning(Form("Could not find cluster %d!", it->first));
+            continue;
           }
+          AliVCluster *clus2 =  jet2->Cluster(it2->second);
+          if (!clus2) {
+            AliWarning(Form("Could not find cluster %d!", index2));
+            continue;
+          }
+          TLorentzVector part1, part2;
+          clus1->GetMomentum(part1, fVertex);
+          clus2->GetMomentum(part2, fVertex);
+
+          d1 -= part1.Pt();
+          d2 -= part2.Pt();
+          break;
         }
       }
     }
@@ -1909,6 +1809,160 @@ void AliJetResponseMaker::SetMatchingLevel(AliEmcalJet *jet1, AliEmcalJet *jet2,
   }
 }
 
+//________________________________________________________________________
+void AliJetResponseMaker::ResetConstituentCache()
+{
+  // Clear the per-event constituent caches (the jet objects are reused from event to event).
+
+  fMCLabelCache.clear();
+  fSortedTrackCache.clear();
+  fSortedClusterCache.clear();
+}
+
+//________________________________________________________________________
+const AliJetResponseMaker::MCLabelJetInfo& AliJetResponseMaker::GetMCLabelJetInfo(AliEmcalJet *jet1, AliParticleContainer *tracks1, AliParticleContainer *tracks2) const
+{
+  // Associate the constituents of jet1 with the particles of the jet2 container.
+  // The result is computed once per event and sorted by particle index.
+
+  std::map<const AliEmcalJet*, MCLabelJetInfo>::iterator cached = fMCLabelCache.find(jet1);
+  if (cached != fMCLabelCache.end()) return cached->second;
+
+  MCLabelJetInfo &info = fMCLabelCache[jet1];
+  Int_t order = 0;
+
+  for (Int_t iTrack = 0; iTrack < jet1->GetNumberOfTracks(); iTrack++) {
+    AliVParticle *track = jet1->Track(iTrack);
+    if (!track) {
+      AliWarning(Form("Could not find track %d!", iTrack));
+      continue;
+    }
+
+    Int_t MClabel = TMath::Abs(track->GetLabel());
+    MClabel -= fMCLabelShift;
+    if (MClabel == 0) {
+      if (tracks1 && tracks1->GetArray()) {
+        // this is not a MC particle; remove it completely
+        AliDebug(3,Form("Track %d (pT = %f) is not a MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
+        info.fNonMCPt += track->Pt();
+      }
+      continue;
+    }
+    if (MClabel < 0 || !tracks2) continue;
+
+    Int_t index = tracks2->GetIndexFromLabel(MClabel);
+    if (index < 0) {
+      AliDebug(2,Form("Track %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iTrack,track->Pt(),MClabel));
+      continue;
+    }
+
+    MCLabelConstituent c = {index, order++, track->Pt(), 1.};
+    info.fConstituents.push_back(c);
+  }
+
+  if (fUseCellsToMatch && fCaloCells) { // if the cell colection is available, look for cells with a matched MC particle
+    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+      AliVCluster *clus = jet1->Cluster(iClus);
+      if (!clus) {
+        AliWarning(Form("Could not find cluster %d!", iClus));
+        continue;
+      }
+      AliTLorentzVector part;
+      clus->GetMomentum(part, fVertex);
+
+      for (Int_t iCell = 0; iCell < clus->GetNCells(); iCell++) {
+        Int_t cellId = clus->GetCellAbsId(iCell);
+        Double_t cellFrac = clus->GetCellAmplitudeFraction(iCell);
+
+        Int_t MClabel = TMath::Abs(fCaloCells->GetCellMCLabel(cellId));
+        MClabel -= fMCLabelShift;
+        if (MClabel == 0) {
+          // this is not a MC particle; remove it completely
+          AliDebug(3,Form("Cell %d (frac = %f) is not a MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
+          info.fNonMCPt += part.Pt() * cellFrac;
+          continue;
+        }
+        if (MClabel < 0 || !tracks2) continue;
+
+        Int_t index = tracks2->GetIndexFromLabel(MClabel);
+        if (index < 0) {
+          AliDebug(3,Form("Cell %d (frac = %f) does not have an associated MC particle (MClabel = %d)!",iCell,cellFrac,MClabel));
+          continue;
+        }
+
+        MCLabelConstituent c = {index, order++, part.Pt() * cellFrac, cellFrac};
+        info.fConstituents.push_back(c);
+      }
+    }
+  }
+  else { //otherwise look for the first contributor to the cluster
+    for (Int_t iClus = 0; iClus < jet1->GetNumberOfClusters(); iClus++) {
+      AliVCluster *clus = jet1->Cluster(iClus);
+      if (!clus) {
+        AliWarning(Form("Could not find cluster %d!", iClus));
+        continue;
+      }
+      AliTLorentzVector part;
+      clus->GetMomentum(part, fVertex);
+
+      Int_t MClabel = TMath::Abs(clus->GetLabel());
+      MClabel -= fMCLabelShift;
+      if (MClabel == 0) {
+        // this is not a MC particle; remove it completely
+        AliDebug(3,Form("Cluster %d (pT = %f) is not a MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
+        info.fNonMCPt += part.Pt();
+        continue;
+      }
+      if (MClabel < 0 || !tracks2) continue;
+
+      Int_t index = tracks2->GetIndexFromLabel(MClabel);
+      if (index < 0) {
+        AliDebug(3,Form("Cluster %d (pT = %f) does not have an associated MC particle (MClabel = %d)!",iClus,part.Pt(),MClabel));
+        continue;
+      }
+
+      MCLabelConstituent c = {index, order++, part.Pt(), 1.};
+      info.fConstituents.push_back(c);
+    }
+  }
+
+  std::sort(info.fConstituents.begin(), info.fConstituents.end());
+
+  return info;
+}
+
+//________________________________________________________________________
+const AliJetResponseMaker::SortedIndices_t& AliJetResponseMaker::GetSortedTrackIndices(AliEmcalJet *jet) const
+{
+  // Track indices of the jet with their position in the jet, sorted by index (computed once per event).
+
+  std::map<const AliEmcalJet*, SortedIndices_t>::iterator cached = fSortedTrackCache.find(jet);
+  if (cached != fSortedTrackCache.end()) return cached->second;
+
+  SortedIndices_t &sorted = fSortedTrackCache[jet];
+  sorted.reserve(jet->GetNumberOfTracks());
+  for (Int_t i = 0; i < jet->GetNumberOfTracks(); i++) sorted.push_back(std::make_pair(jet->TrackAt(i), i));
+  std::sort(sorted.begin(), sorted.end());
+
+  return sorted;
+}
+
+//________________________________________________________________________
+const AliJetResponseMaker::SortedIndices_t& AliJetResponseMaker::GetSortedClusterIndices(AliEmcalJet *jet) const
+{
+  // Cluster indices of the jet with their position in the jet, sorted by index (computed once per event).
+
+  std::map<const AliEmcalJet*, SortedIndices_t>::iterator cached = fSortedClusterCache.find(jet);
+  if (cached != fSortedClusterCache.end()) return cached->second;
+
+  SortedIndices_t &sorted = fSortedClusterCache[jet];
+  sorted.reserve(jet->GetNumberOfClusters());
+  for (Int_t i = 0; i < jet->GetNumberOfClusters(); i++) sorted.push_back(std::make_pair(jet->ClusterAt(i), i));
+  std::sort(sorted.begin(), sorted.end());
+
+  return sorted;
+}
+
 //________________________________________________________________________
 Bool_t AliJetResponseMaker::FillHistograms()
 {
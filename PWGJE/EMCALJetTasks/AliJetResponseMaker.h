@@ -23,6 +23,11 @@ class TClonesArray;
 class TH2;
 class THnSparse;
 class AliNamedArrayI;
+class AliParticleContainer;
+
+#include <map>
+#include <utility>
+#include <vector>
 
 #include "AliEmcalJet.h"
 #include "AliAnalysisTaskEmcalJet.h"
@@ -47,6 +52,7 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        SetPtHardBin(Int_t b)                                           { fSelectPtHardBin   = b         ; }
   void                        SetUseCellsToMatch(Bool_t i)                                    { fUseCellsToMatch   = i         ; }
   void                        SetMinJetMCPt(Float_t pt)                                       { fMinJetMCPt        = pt        ; }
+  void                        SetMaxCandidateDistance(Double_t r)                             { fMaxCandidateDistance = r      ; }
   void                        SetHistoType(Int_t b)                                           { fHistoType         = b         ; }
   void                        SetDeltaPtAxis(Int_t b)                                         { fDeltaPtAxis       = b         ; }
   void                        SetDeltaEtaDeltaPhiAxis(Int_t b)                                { fDeltaEtaDeltaPhiAxis= b       ; }
@@ -105,12 +111,38 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   void                        AllocateTH2();
   void                        AllocateTHnSparse();
   Double_t                    GetRelativeEPAngle(Double_t jetAngle, Double_t epAngle) const;
+  void                        ResetConstituentCache();
+
+  // Constituent of jet1 associated with a particle of the jet2 particle container (MC label matching)
+  struct MCLabelConstituent {
+    Int_t                     fIndex;                                  // index of the associated particle in the jet2 particle container
+    Int_t                     fOrder;                                  // position of the constituent in the jet (tracks first, then clusters/cells)
+    Double_t                  fPt;                                     // pt removed from jet1 if the particle is shared
+    Double_t                  fFraction;                               // fraction of the particle pt removed from jet2 if the particle is shared
+
+    bool operator<(const MCLabelConstituent& o) const { return fIndex < o.fIndex || (fIndex == o.fIndex && fOrder < o.fOrder); }
+  };
+
+  // MC label information of jet1, built once per event
+  struct MCLabelJetInfo {
+    Double_t                  fNonMCPt;                                // pt of the constituents not originating from a MC particle (label == 0)
+    std::vector<MCLabelConstituent> fConstituents;                     // constituents with an associated particle, sorted by index
+
+    MCLabelJetInfo() : fNonMCPt(0), fConstituents() {}
+  };
+
+  typedef std::vector<std::pair<Int_t, Int_t> > SortedIndices_t;      // (constituent index, position in the jet), sorted
+
+  const MCLabelJetInfo&       GetMCLabelJetInfo(AliEmcalJet *jet1, AliParticleContainer *tracks1, AliParticleContainer *tracks2) const;
+  const SortedIndices_t&      GetSortedTrackIndices(AliEmcalJet *jet) const;
+  const SortedIndices_t&      GetSortedClusterIndices(AliEmcalJet *jet) const;
 
   MatchingType                fMatching;                               // matching type
   Double_t                    fMatchingPar1;                           // matching parameter for jet1-jet2 matching
   Double_t                    fMatchingPar2;                           // matching parameter for jet2-jet1 matching
   Bool_t                      fUseCellsToMatch;                        // use cells instead of clusters to match jets (slower but sometimes needed)
   Double_t                    fMinJetMCPt;                             // minimum jet MC pt
+  Double_t                    fMaxCandidateDistance;                   // if > 0, only jet pairs closer than this in (eta,phi) are compared (kd-tree search)
   AliEmcalEmbeddingQA         fEmbeddingQA;                            //!<! Embedding QA hists (will only be added if embedding)
   Int_t                       fHistoType;                              // histogram type (0=TH2, 1=THnSparse)
   Int_t                       fDeltaPtAxis;                            // add delta pt axis in THnSparse (default=0)
@@ -128,6 +160,10 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   Bool_t                      fIsJet1Rho;                              //!whether the jet1 collection has to be average subtracted
   Bool_t                      fIsJet2Rho;                              //!whether the jet2 collection has to be average subtracted
 
+  mutable std::map<const AliEmcalJet*, MCLabelJetInfo>  fMCLabelCache;         //!MC label information of jet1, per event
+  mutable std::map<const AliEmcalJet*, SortedIndices_t> fSortedTrackCache;     //!sorted track indices of the jets, per event
+  mutable std::map<const AliEmcalJet*, SortedIndices_t> fSortedClusterCache;   //!sorted cluster indices of the jets, per event
+
   TH2                        *fHistRejectionReason1;                   //!Rejection reason vs. jet pt
   TH2                        *fHistRejectionReason2;                   //!Rejection reason vs. jet pt
 
@@ -204,6 +240,6 @@ class AliJetResponseMaker : public AliAnalysisTaskEmcalJet {
   AliJetResponseMaker(const AliJetResponseMaker&);            // not implemented
   AliJetResponseMaker &operator=(const AliJetResponseMaker&); // not implemented
 
-  ClassDef(AliJetResponseMaker, 29) // Jet response matrix producing task
+  ClassDef(AliJetResponseMaker, 30) // Jet response matrix producing task
 };
 #endif
@@ -306,6 +306,34 @@ namespace {
     ret = h->GetBinContent(xbin,ybin);					
     return ret;
   }
+  //__________________________________________________________________
+  /** 
+   * Weighted fill of a 2D histogram over the strips of a ring.  Most
+   * strips are empty and give a zero weight, which only changes the
+   * number of entries (and, like TH1::Fill, makes the histogram
+   * store the sum of squared weights).  Such fills are only counted,
+   * and the entries are updated in Flush, so that the histogram is
+   * identical to one filled strip by strip.
+   */
+  struct StripFiller
+  {
+    StripFiller(TH2D* h) : fH(h), fNZero(0) {}
+    ~StripFiller() { Flush(); }
+    void Fill(Double_t x, Double_t y, Double_t w)
+    {
+      if (w != 0) { fH->Fill(x, y, w); return; }
+      if (fNZero == 0 && fH->GetSumw2N() == 0 && !fH->TestBit(TH1::kIsNotW))
+	fH->Sumw2();
+      fNZero++;
+    }
+    void Flush()
+    {
+      if (fNZero > 0) fH->SetEntries(fH->GetEntries() + fNZero);
+      fNZero = 0;
+    }
+    TH2D*    fH;
+    Long64_t fNZero;
+  };
 }
 
 //____________________________________________________________________
@@ -430,6 +458,10 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
       // etaCache.Reset(AliESDFMD::kInvalidEta);
       // phiCache.Reset(AliESDFMD::kInvalidEta);
 
+      // Fills skipping the (mostly empty) strips with zero signal
+      StripFiller hFiller(h);
+      StripFiller densityFiller(rh->fDensity);
+
       // --- Loop over sectors and strips ----------------------------
       for (UShort_t s=0; s<ns; s++) { 
 	for (UShort_t t=0; t<nt; t++) {
@@ -529,12 +561,13 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	    rh->fSignal->Fill(eta, mult);
 	  }
 	  rh->fPoisson.Fill(t,s,hit,1./c);
-	  h->Fill(eta,phi,n);
+	  hFiller.Fill(eta,phi,n);
 
 	  // --- If we use ELoss fits, apply now ---------------------
-	  if (!fUsePoisson) rh->fDensity->Fill(eta,phi,n);
+	  if (!fUsePoisson) densityFiller.Fill(eta,phi,n);
 	} // for t
       } // for s 
+      hFiller.Flush();
 
       // --- Automatic acceptance - Calculate as an efficiency -------
       // This is very fast, so we do not bother to time it 
@@ -561,6 +594,7 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
       // --- Store Poisson result ------------------------------------
       START_TIMER(timer);
       TH2D* poisson = rh->fPoisson.Result();
+      StripFiller hcloneFiller(hclone);
       for (Int_t t=0; t < poisson->GetNbinsX(); t++) { 
 	for (Int_t s=0; s < poisson->GetNbinsY(); s++) { 
 	  
@@ -572,13 +606,16 @@ AliFMDDensityCalculator::Calculate(const AliESDFMD&        fmd,
 	  // Double_t  phi  = fmd.Phi(d,r,s,t) * TMath::DegToRad();
 	  // Double_t  eta  = fmd.Eta(d,r,s,t);
 	  if (fUsePoisson) {
-	    h->Fill(eta,phi,poissonV);
-	    rh->fDensity->Fill(eta, phi, poissonV);
+	    hFiller.Fill(eta,phi,poissonV);
+	    densityFiller.Fill(eta, phi, poissonV);
 	  }
 	  else
-	    hclone->Fill(eta,phi,poissonV);
+	    hcloneFiller.Fill(eta,phi,poissonV);
 	}
       }
+      hFiller.Flush();
+      densityFiller.Flush();
+      hcloneFiller.Flush();
       ADD_TIMER(timer,poissonTime);
       
       // --- Make diagnostics - eloss vs poisson ---------------------
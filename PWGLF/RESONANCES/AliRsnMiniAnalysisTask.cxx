@@ -13,6 +13,8 @@
 // Developers: F. Bellini (fbellini@cern.ch)
 
 #include <Riostream.h>
+#include <algorithm>
+#include <map>
 
 #include <TObjString.h>
 #include <TH1.h>
@@ -55,6 +57,36 @@
 
 ClassImp(AliRsnMiniAnalysisTask)
 
+namespace {
+   /// Cell of the event-mixing store: indices of the events whose (Vz, Mult, Angle)
+   /// fall in the cell, in increasing order. Events which already have all the
+   /// required mixings are skipped by following fNext (with path compression).
+   struct RsnMixCell {
+      std::vector<Int_t> fEvents;   ///< event indices, increasing
+      std::vector<Int_t> fNext;     ///< next position which may hold a non-saturated event
+
+      void  Close()                 {fNext.resize(fEvents.size() + 1); for (UInt_t i = 0; i < fNext.size(); i++) fNext[i] = i;}
+      void  Saturate(Int_t pos)     {fNext[pos] = pos + 1;}
+      Int_t Next(Int_t pos)
+      {
+         Int_t root = pos;
+         while (fNext[root] != root) root = fNext[root];
+         while (fNext[pos] != root) {Int_t n = fNext[pos]; fNext[pos] = root; pos = n;}
+         return root;
+      }
+   };
+
+   /// Cell coordinates in the (Vz, Mult, Angle) space
+   struct RsnMixCellKey {
+      Double_t fX[3];
+      bool operator<(const RsnMixCellKey &other) const
+      {
+         for (Int_t i = 0; i < 3; i++) if (fX[i] != other.fX[i]) return fX[i] < other.fX[i];
+         return false;
+      }
+   };
+}
+
 //__________________________________________________________________________________________________
 /// Default constructor
 AliRsnMiniAnalysisTask::AliRsnMiniAnalysisTask() :
@@ -587,7 +619,7 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    // prepare variables
    Int_t ievt, nEvents = (Int_t)fEvBuffer->GetEntries();
    Int_t idef, nDefs   = fHistograms.GetEntries();
-   Int_t imix, iloop, ifill;
+   Int_t imix, ifill;
    AliRsnMiniOutput *def = 0x0;
    AliRsnMiniOutput::EComputation compType;
 
@@ -602,10 +634,15 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    // using the appropriate procedure depending on its type
    // only mother-related histograms are filled in UserExec,
    // since they require direct access to MC event
+   // values used to find the mixing partners, stored here to avoid reading the events again
+   std::vector<Float_t> evVz(nEvents), evMult(nEvents), evAngle(nEvents);
    timer.Start();
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
       fEvBuffer->GetEntry(ievt);
+      evVz[ievt]    = fMiniEvent->Vz();
+      evMult[ievt]  = fMiniEvent->Mult();
+      evAngle[ievt] = fMiniEvent->Angle();
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -655,66 +692,28 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
       return;
    }
 
-   // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
-   }
-
-
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
    timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
 
    // search for good matchings
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      if (printNum&&(ievt%printNum==0)) {
-         AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
-         timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
-      }
-      if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
-         if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
-         // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
-         // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
-         // check that the found good events has not enough matches already
-         if (nmatched[imix] >= fNMix) continue;
-         // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
-         nmatched[ievt]++;
-         nmatched[imix]++;
-         if (nmatched[ievt] >= fNMix) break;
-      }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
-   }
+   std::vector< std::vector<Int_t> > matched;
+   FindMixingMatches(evVz, evMult, evAngle, matched, printNum);
 
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
    // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
+      if (matched[ievt].empty()) continue;
       ifill = 0;
       fEvBuffer->GetEntry(ievt);
       AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
+      for (UInt_t im = 0; im < matched[ievt].size(); im++) {
+         imix = matched[ievt][im];
          fEvBuffer->GetEntry(imix);
          for (idef = 0; idef < nDefs; idef++) {
             def = (AliRsnMiniOutput *)fHistograms[idef];
@@ -727,11 +726,8 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
             }
          }
       }
-      delete list;
    }
 
-   delete [] smatched;
-
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
 
@@ -1678,33 +1674,32 @@ void AliRsnMiniAnalysisTask::SetDselection(UShort_t originDselection)
 Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2)
 {
    if (!event1 || !event2) return kFALSE;
+   return EventsMatch(event1->Vz(), event1->Mult(), event1->Angle(), event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+/// Mixing criterion on the event values (Vz, multiplicity, angle)
+///
+Bool_t AliRsnMiniAnalysisTask::EventsMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2) const
+{
    Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
    Double_t dv, dm, da;
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
-      if (dv > fMaxDiffVz) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
-         return kFALSE;
-      }
-      if (dm > fMaxDiffMult ) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Mult = %f", event1->ID(), event2->ID(), dm));
-         return kFALSE;
-      }
-      if (da > fMaxDiffAngle) {
-         //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Angle = %f", event1->ID(), event2->ID(), da));
-         return kFALSE;
-      }
+      dv = TMath::Abs(vz1    - vz2   );
+      dm = TMath::Abs(mult1  - mult2 );
+      da = TMath::Abs(angle1 - angle2);
+      if (dv > fMaxDiffVz) return kFALSE;
+      if (dm > fMaxDiffMult ) return kFALSE;
+      if (da > fMaxDiffAngle) return kFALSE;
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
+      ivz1 = (Int_t)(vz1 / fMaxDiffVz);
+      ivz2 = (Int_t)(vz2 / fMaxDiffVz);
+      imult1 = (Int_t)(mult1 / fMaxDiffMult);
+      imult2 = (Int_t)(mult2 / fMaxDiffMult);
+      iangle1 = (Int_t)(angle1 / fMaxDiffAngle);
+      iangle2 = (Int_t)(angle2 / fMaxDiffAngle);
       if (ivz1 != ivz2) return kFALSE;
       if (imult1 != imult2) return kFALSE;
       if (iangle1 != iangle2) return kFALSE;
@@ -1712,6 +1707,129 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
    }
 }
 
+//__________________________________________________________________________________________________
+/// Search of the mixing partners.
+///
+/// Each event, in order, takes as partners the next matching events (cyclically,
+/// starting from the following one) which do not have fNMix partners yet and
+/// did not already take it as partner, until it has fNMix partners itself.
+/// The events are stored in cells of the (Vz, Mult, Angle) space: in binned
+/// mixing the cells are the mixing bins, in continuous mixing they have the
+/// size of the maximum differences and the partners are searched in the
+/// neighbouring cells only. Events with all their partners are skipped.
+/// This gives the same partners as a scan of all events, with a cost
+/// which scales with the number of mixings instead of the number of events.
+///
+/// \param vz, mult, angle  Values of the buffered events
+/// \param matched          Filled with the partners taken by each event
+/// \param printNum         Progress printout period (0 = none)
+///
+void AliRsnMiniAnalysisTask::FindMixingMatches(const std::vector<Float_t> &vz, const std::vector<Float_t> &mult, const std::vector<Float_t> &angle,
+                                               std::vector< std::vector<Int_t> > &matched, Int_t printNum) const
+{
+   Int_t ievt, nEvents = (Int_t)vz.size();
+   Int_t ic, idim, ncand;
+   const Double_t maxDiff[3] = {fMaxDiffVz, fMaxDiffMult, fMaxDiffAngle};
+
+   // fill the cells
+   std::map<RsnMixCellKey, Int_t> cellMap;
+   std::map<RsnMixCellKey, Int_t>::const_iterator it;
+   std::vector<RsnMixCell> cells;
+   std::vector<Int_t> evCell(nEvents), evPos(nEvents);
+   RsnMixCellKey key;
+   for (ievt = 0; ievt < nEvents; ievt++) {
+      const Float_t x[3] = {vz[ievt], mult[ievt], angle[ievt]};
+      for (idim = 0; idim < 3; idim++) {
+         if (fContinuousMix)
+            key.fX[idim] = TMath::Floor(x[idim] / maxDiff[idim]);
+         else
+            key.fX[idim] = (Int_t)(x[idim] / maxDiff[idim]);
+      }
+      it = cellMap.find(key);
+      if (it == cellMap.end()) {
+         it = cellMap.insert(std::make_pair(key, (Int_t)cells.size())).first;
+         cells.push_back(RsnMixCell());
+      }
+      evCell[ievt] = it->second;
+      evPos[ievt]  = cells[it->second].fEvents.size();
+      cells[it->second].fEvents.push_back(ievt);
+   }
+   for (ic = 0; ic < (Int_t)cells.size(); ic++) cells[ic].Close();
+
+   matched.assign(nEvents, std::vector<Int_t>());
+   std::vector<Int_t> nmatched(nEvents, 0);
+   std::vector<Int_t> cand, cursor, last;
+   for (ievt = 0; ievt < nEvents; ievt++) {
+      if (printNum&&(ievt%printNum==0)) AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
+      if (nmatched[ievt] >= fNMix) continue;
+
+      // candidate cells
+      cand.clear();
+      if (fContinuousMix) {
+         // neighbouring cells, with a margin against rounding at the cell edges
+         Double_t lo[3], hi[3], c[3];
+         const Float_t x[3] = {vz[ievt], mult[ievt], angle[ievt]};
+         for (idim = 0; idim < 3; idim++) {
+            Double_t u = x[idim] / maxDiff[idim], eps = TMath::Min(1E-9 * (1.0 + TMath::Abs(u)), 0.5);
+            lo[idim] = TMath::Floor(u - 1.0 - eps);
+            hi[idim] = TMath::Floor(u + 1.0 + eps);
+         }
+         for (c[0] = lo[0]; c[0] <= hi[0]; c[0] += 1.0)
+            for (c[1] = lo[1]; c[1] <= hi[1]; c[1] += 1.0)
+               for (c[2] = lo[2]; c[2] <= hi[2]; c[2] += 1.0) {
+                  for (idim = 0; idim < 3; idim++) key.fX[idim] = c[idim];
+                  it = cellMap.find(key);
+                  if (it != cellMap.end()) cand.push_back(it->second);
+               }
+      } else {
+         cand.push_back(evCell[ievt]);
+      }
+      ncand = cand.size();
+      cursor.resize(ncand);
+      last.resize(ncand);
+
+      // first the events after this one, then those before it
+      for (Int_t pass = 0; pass < 2 && nmatched[ievt] < fNMix; pass++) {
+         for (ic = 0; ic < ncand; ic++) {
+            RsnMixCell &cell = cells[cand[ic]];
+            std::vector<Int_t>::iterator pos = std::lower_bound(cell.fEvents.begin(), cell.fEvents.end(), ievt);
+            if (pass == 0) {
+               if (pos != cell.fEvents.end() && *pos == ievt) ++pos;
+               cursor[ic] = cell.Next(pos - cell.fEvents.begin());
+               last[ic]   = cell.fEvents.size();
+            } else {
+               cursor[ic] = cell.Next(0);
+               last[ic]   = pos - cell.fEvents.begin();
+            }
+         }
+         while (nmatched[ievt] < fNMix) {
+            // next candidate event, in increasing index
+            Int_t best = -1, imix = nEvents;
+            for (ic = 0; ic < ncand; ic++) {
+               if (cursor[ic] >= last[ic]) continue;
+               Int_t iev = cells[cand[ic]].fEvents[cursor[ic]];
+               if (iev < imix) {imix = iev; best = ic;}
+            }
+            if (best < 0) break;
+            cursor[best] = cells[cand[best]].Next(cursor[best] + 1);
+            // skip if events are not matched
+            if (!EventsMatch(vz[ievt], mult[ievt], angle[ievt], vz[imix], mult[imix], angle[imix])) continue;
+            // check that the good matches for mixed do not already contain main event
+            if (std::find(matched[imix].begin(), matched[imix].end(), ievt) != matched[imix].end()) continue;
+            // check that the found good events has not enough matches already
+            if (nmatched[imix] >= fNMix) continue;
+            // add new mixing candidate
+            matched[ievt].push_back(imix);
+            nmatched[ievt]++;
+            nmatched[imix]++;
+            if (nmatched[imix] >= fNMix) cells[evCell[imix]].Saturate(evPos[imix]);
+         }
+      }
+      if (nmatched[ievt] >= fNMix) cells[evCell[ievt]].Saturate(evPos[ievt]);
+      AliDebugClass(1, Form("Matches for event %5d = %d (missing are declared above)", ievt, nmatched[ievt]));
+   }
+}
+
 //---------------------------------------------------------------------
 /// Patch to be used with 2011 Pb-Pb data for flat centrality distribution
 ///